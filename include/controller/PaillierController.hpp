@@ -20,6 +20,7 @@
 
 #include "../../include/model/Paillier_model.hpp"
 #include "../../include/view/commandLineInterface.hpp"
+#include "../../include/model/encryption/Paillier/PrimeGenerator.hpp"
 
 /**
  * \class PaillierController
@@ -57,14 +58,13 @@ protected:
     void convertToLower(char *arg_in[], int size_arg_in);
     /**
      * \brief Checks if the given number is prime.
-     * \details
+     * \details Trial division by small primes then deterministic Miller-Rabin test (see PrimeGenerator::isPrime).
      * \param uint64_t n The number to check.
-     * \param uint64_t i The starting index for the check.
      * \author Katia Auxilien
      * \date 30 April 2024
      * \return bool True if the number is prime, false otherwise.
      */
-    bool isPrime(uint64_t n, uint64_t i = 2);
+    bool isPrime(uint64_t n);
 
     /**
      * \brief Checks if the given argument is a prime number.
@@ -153,6 +153,17 @@ public:
      */
     void generateAndSaveKeyPair();
 
+    /**
+     * \brief Generates random primes p and q and sets p, q, n and lambda in the model.
+     * \details The primes are searched with PrimeGenerator::generateKeyPrimes and the time of the search is printed.
+     * \param unsigned bits The bit length of n.
+     * \param bool safe True to generate safe primes.
+     * \param unsigned threads The number of threads of the search, 0 for the number of cores.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    void generateKeyPrimes(unsigned bits, bool safe, unsigned threads);
+
     /**
      * \brief Reads the key file.
      * \details This function reads the key file associated with this controller and sets the model's public and private keys accordingly.
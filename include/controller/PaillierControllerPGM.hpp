@@ -1,735 +1,1767 @@
-/**
- * \file PaillierControllerPGM.hpp
- * \brief Header file for the PaillierControllerPGM class, which is a
- * controller for the Paillier cryptosystem applied to PGM (Portable Gray Map)
- * images.
- * \author Katia Auxilien
- * \date 29 May 2024, 13:55:00
- * \details 
- */
-
-#ifndef PAILLIERCONTROLLER_PGM
-#define PAILLIERCONTROLLER_PGM
-
-#include <stdio.h>
-#include <cctype>
-#include <fstream>
-#include <string>
-#include <string_view>
-#include <stdio.h>
-#include <ctype.h> //uintN_t
-#include <bitset>  //Bitwise operators
-
-#include "../../include/controller/PaillierController.hpp"
-#include "../../include/model/image/image_portable.hpp"
-#include "../../include/model/image/image_pgm.hpp"
-#include "../../include/model/filesystem/filesystemPGM.hpp"
-
-/**
- * \class PaillierControllerPGM
- * \brief Controller for the Paillier cryptosystem applied to PGM images.
- * \details This class is responsible for controlling the Paillier cryptosystem
- * applied to PGM images. It inherits from the PaillierController class and
- * provides additional functionalities specific to PGM images.
- * \author Katia Auxilien
- * \date 29 May 2024, 13:55:00
- */
-class PaillierControllerPGM : public PaillierController
-{
-
-private:
-	char *c_file; /*!< Pointer to the char array containing the file name. */
-
-public:
-	/**
-	 * \brief
-	 * \brief Default constructor.
-	 * \details This constructor initializes the PaillierControllerPGM object with
-	 * default values.
-	 * \author Katia Auxilien
-	 * \date 29 May 2024, 13:55:00
-	 */
-	PaillierControllerPGM();
-
-	/**
-	 * \brief Destructor.
-	 * \details This destructor frees the memory allocated by the PaillierControllerPGM object.
-	 * \author Katia Auxilien
-	 * \date 29 May 2024, 13:55:00
-	 */
-	~PaillierControllerPGM();
-
-	/**
-	 * \brief
-	 *
-	 */
-	void init();
-
-	/**
-	 * \brief
-	 * \brief Getter for the c_file attribute.
-	 * \details This method returns the value of the c_file attribute.
-	 * \return A constant pointer to the char array containing the file name.
-	 * \author Katia Auxilien
-	 * \date 29 May 2024, 13:55:00
-	 */
-	const char *getCFile() const;
-
-	/**
-	 * \brief Setter for the c_file attribute.
-	 * \details This method sets the value of the c_file attribute.
-	 * \param newCFile A pointer to the char array containing the new file name.
-	 * \author Katia Auxilien
-	 * \date 29 May 2024, 13:55:00
-	 */
-	void setCFile(char *newCFile);
-
-	/**
-	 *  \brief Check the parameters passed to the program.
-	 *  \details This method checks the parameters passed to the program and sets the
-	 * 	corresponding attributes of the PaillierControllerPGM object.
-	 * \param arg_in An array of char pointers containing the arguments passed to
-	 * the program.
-	 *  \param size_arg The size of the arg_in array.
-	 *  \param bool param[] array of flags to be set based on the command line
-	 * arguments.
-	 *				0	bool isEncryption = false ;
-	 *				1	bool useKeys = false;
-	 *				2	bool distributeOnTwo = false;
-	 *				3	bool recropPixels = false;
-	 *				4	bool optimisationLSB32 = false;
-	 *				5	bool optimisationLSB16 = false;
-	 *				6 	bool needHelp = false;
-	 *  \authors Katia Auxilien
-	 *  \date 29 May 2024, 13:55:00
-	 */
-	void checkParameters(char *arg_in[], int size_arg, bool param[]);
-
-	/**
-	 * \brief Print the man page message.
-	 * \details This method prints the help message for the program.
-	 * \author Katia Auxilien
-	 * \date 29 May 2024, 13:55:00
-	 */
-	void printHelp();
-
-	/*********************** Encryption/Decryption ***********************/
-	/**
-	 *  \brief Perform histogram expansion on an image pixel.
-	 * \details This method performs histogram expansion on an image pixel to increase
-	 * the dynamic range of the image.
-	 * \param ImgPixel The input image pixel.
-	 * \param recropPixels A bool value indicating whether to recrop the pixels.
-	 * \return The histogram-expanded image pixel.
-	 * \author Katia Auxilien
-	 * \date 29 May 2024, 13:55:00
-	 */
-	uint8_t histogramExpansion(OCTET ImgPixel, bool recropPixels);
-
-	/************** 8bits **************/
-	/**
-	 *  \brief Encrypt an image using the Paillier cryptosystem.
-	 * \details This method encrypts an image using the Paillier cryptosystem and
-	 * writes the encrypted image to a file.
-	 * \tparam T_in The input integer type.
-	 * \tparam T_out The output integer type.
-	 * \param distributeOnTwo A bool value indicating whether to distribute the
-	 * encrypted pixels over two bytes.
-	 * \param recropPixels A bool value indicating whether to recrop the pixels.
-	 * \param paillier A Paillier object used for encryption.
-	 * \author Katia Auxilien
-	 * \date 29 May 2024, 13:55:00
-	 */
-	template <typename T_in, typename T_out>
-	void encrypt(bool distributeOnTwo, bool recropPixels, Paillier<T_in, T_out> paillier);
-
-	/**
-	 *  \brief Decrypt an image using the Paillier cryptosystem.
-	 * \details This method decrypts an image using the Paillier cryptosystem and
-	 * writes the decrypted image to a file.
-	 * \tparam T_in The input integer type.
-	 * \tparam T_out The output integer type.
-	 * \param distributeOnTwo A bool value indicating whether the encrypted pixels
-	 * were distributed over two bytes.
-	 * \param paillier A Paillier object used for decryption.
-	 * \author Katia Auxilien
-	 * \date 29 May 2024, 13:55:00
-	 */
-	template <typename T_in, typename T_out>
-	void decrypt(bool distributeOnTwo, Paillier<T_in, T_out> paillier);
-
-	/**
-	 * \brief Encrypt an image using the Paillier cryptosystem with compression mod bitsCompressed.
-	 * \details This method encrypts an image using the Paillier cryptosystem with
-	 * compression and writes the encrypted image to a file.
-	 * \tparam T_in The input integer type.
-	 * \tparam T_out The output integer type.
-	 * \param recropPixels A bool value indicating whether to recrop the pixels.
-	 * \param paillier A Paillier object used for encryption.
-	 * \param bitsCompressed An int representing how many bits to free.
-	 * \author Katia Auxilien
-	 * \date 19 June 2024
-	 */
-	template <typename T_in, typename T_out>
-	void encryptCompression_16bpp(bool recropPixels, Paillier<T_in, T_out> paillier, int bitsCompressed);
-
-	/**
-	 * \brief This function compresses the encrypted bits of an image.
-	 * \details The function takes an encrypted image represented as a 2D array of 16-bit
-	 * unsigned integers, and its dimensions (number of rows and columns). It compresses
-	 * the encrypted bits of the image using a bit-packing technique, where each 16-bit
-	 * integer is packed into 11 bits, and returns the compressed image as a new 2D array
-	 * of 16-bit unsigned integers. The function also updates the number of columns of the
-	 * compressed image to reflect the new size.
-	 * \param ImgInEnc A 2D array of 16-bit unsigned integers representing the encrypted image to be compressed.
-	 * \param nb_lignes An integer representing the number of rows of the encrypted image.
-	 * \param nb_colonnes An integer representing the number of columns of the encrypted image.
-	 * \param bitsCompressed An integer representig how many bits are at 0.
-	 * \return A 2D array of 16-bit unsigned integers representing the compressed encrypted image.
-	 * \authors Katia Auxilien
-	 * \date 29 May 2024, 13:55:00
-	 */
-	uint16_t *compressBits_16bpp(uint16_t *ImgInEnc, int nb_lignes, int nb_colonnes, int bitsCompressed);
-
-	/**
-	 * \brief Method to decompress an encrypted 16BPP PGM image.
-	 * \details This method decompresses an encrypted 8-bit PGM image that was
-	 * previously compressed using the encryptCompression method.
-	 * \param uint16_t *ImgInEnc pointer to the encrypted and compressed image data.
-	 * \param int nb_lignes number of rows in the image.
-	 * \param int nb_colonnes number of columns in the image.
-	 * \param bitsCompressed An integer representig how many bits are at 0.
-	 * \return uint16_t* pointer to the decompressed image data.
-	 * \author Katia Auxilien
-	 * \date 29 mai 2024, 13:55:00
-	 */
-	uint16_t *decompressBits_16bpp(uint16_t *ImgInEnc, int nb_lignes, int nb_colonnes, int nTailleOriginale, int bitsCompressed);
-
-
-	/**
-	 * \brief This function compresses the encrypted bits of an image.
-	 * \details The function takes an encrypted image represented as a 2D array of 16-bit
-	 * unsigned integers, and its dimensions (number of rows and columns). It compresses
-	 * the encrypted bits of the image using a bit-packing technique, where each 16-bit
-	 * integer is packed into 11 bits, and returns the compressed image as a new 2D array
-	 * of 8-bit unsigned integers. The function also updates the number of columns of the
-	 * compressed image to reflect the new size.
-	 * \param ImgInEnc A 2D array of 16-bit unsigned integers representing the encrypted image to be compressed.
-	 * \param nb_lignes An integer representing the number of rows of the encrypted image.
-	 * \param nb_colonnes An integer representing the number of columns of the encrypted image.
-	 * \param bitsCompressed An integer representig how many bits are at 0.
-	 * \return A 2D array of 8-bit unsigned integers representing the compressed encrypted image.
-	 * \authors Katia Auxilien
-	 * \date 29 May 2024, 13:55:00
-	 */
-	uint8_t *compressBits_8bpp(uint16_t *ImgInEnc, int nb_lignes, int nb_colonnes, int bitsCompressed);
-
-	/**
-	 * \brief Method to decompress an encrypted 8-bit PGM image.
-	 * \details This method decompresses an encrypted 8-bit PGM image that was
-	 * previously compressed using the encryptCompression method.
-	 * \param uint8_t *ImgInEnc pointer to the encrypted and compressed image data.
-	 * \param int nb_lignes number of rows in the image.
-	 * \param int nb_colonnes number of columns in the image.
-	 * \param bitsCompressed An integer representig how many bits are at 0.
-	 * \return uint16_t* pointer to the decompressed image data.
-	 * \author Katia Auxilien
-	 * \date 29 mai 2024, 13:55:00
-	 */
-	uint16_t *decompressBits_8bpp(uint8_t *ImgInEnc, int nb_lignes, int nb_colonnes, int nTailleOriginale, int bitsCompressed);
-
-
-	/**
-	 * \brief Method to decompose the dimensions of a compressed image.
-	 * \details This method decomposes the dimensions of a compressed image into its
-	 * height and width components.
-	 * \param int n size of the compressed image in pixels.
-	 * \return pair<int, int> pair containing the height and width of the decomposed
-	 * image.
-	 * \author Katia Auxilien
-	 * \date 29 mai 2024, 13:55:00
-	 */
-	pair<int, int> decomposeDimension(int n);
-
-	/**
-	 * \brief Method to decrypt an 16-bit PGM image with compression mod32
-	 * \details This method decrypts an 16-bit PGM image that was previously encrypted
-	 * using the encryptCompression method and performs decompression on the decrypted
-	 * image before writing it to a file.
-	 * \tparam T_in input integer type for Paillier cryptosystem.
-	 * \tparam T_out output integer type for Paillier cryptosystem.
-	 * \param Paillier<T_in, T_out> paillier instance of the Paillier cryptosystem.
-	 * \param bitsCompressed An int representing how many bits to free.
-	 * \author Katia Auxilien
-	 * \date 19 June 2024
-	 */
-	template <typename T_in, typename T_out>
-	void decryptCompression_16bpp(Paillier<T_in, T_out> paillier, int bitsCompressed);
-
-	/**
-	 * \brief Encrypt an image using the Paillier cryptosystem with compression mod bitsCompressed.
-	 * \details This method encrypts an image using the Paillier cryptosystem with
-	 * compression and writes the encrypted image to a file.
-	 * \tparam T_in The input integer type.
-	 * \tparam T_out The output integer type.
-	 * \param recropPixels A bool value indicating whether to recrop the pixels.
-	 * \param paillier A Paillier object used for encryption.
-	 * \param bitsCompressed An int representing how many bits to free.
-	 * \author Katia Auxilien
-	 * \date 27 June 2024 9:19:00
-	 */
-	template <typename T_in, typename T_out>
-	void encryptCompression_8bpp(bool recropPixels, Paillier<T_in, T_out> paillier, int bitsCompressed);
-
-
-	/**
-	 * \brief Method to decrypt an 8-bit PGM image with compression mod bitsCompressed
-	 * \details This method decrypts an 8-bit PGM image that was previously encrypted
-	 * using the encryptCompression method and performs decompression on the decrypted
-	 * image before writing it to a file.
-	 * \tparam T_in input integer type for Paillier cryptosystem.
-	 * \tparam T_out output integer type for Paillier cryptosystem.
-	 * \param Paillier<T_in, T_out> paillier instance of the Paillier cryptosystem.
-	 * \param bitsCompressed An int representing how many bits to free.
-	 * \author Katia Auxilien
-	 * \date 27 June 2024 9:19:00
-	 */
-	template <typename T_in, typename T_out>
-	void decryptCompression_8bpp(Paillier<T_in, T_out> paillier, int bitsCompressed);
-
-	/************** n > 8bits**************/
-
-	// /**
-	//  *  \brief
-	//  *  \details
-	//  *  \param bool distributeOnTwo
-	//  *  \param bool recropPixels
-	//  *  \param Paillier<T_in, T_out> paillier
-	//  *  \authors Katia Auxilien
-	//  *  \date 29 May 2024, 13:55:00
-	//  */
-	// template <typename T_in, typename T_out>
-	// void encrypt2(bool distributeOnTwo, bool recropPixels, Paillier<T_in,T_out> paillier);
-
-	// /**
-	//  *  \brief
-	//  *  \details
-	//  *  \param bool distributeOnTwo
-	//  *  \param bool recropPixels
-	//  *  \param Paillier<T_in, T_out> paillier
-	//  *  \authors Katia Auxilien
-	//  *  \date 29 May 2024, 13:55:00
-	//  */
-	// template <typename T_in, typename T_out>
-	// void decrypt2(bool distributeOnTwo, Paillier<T_in,T_out> paillier);
-};
-
-/************** 8bits **************/
-
-template <typename T_in, typename T_out>
-void PaillierControllerPGM::encrypt(bool distributeOnTwo, bool recropPixels, Paillier<T_in, T_out> paillier)
-{
-	string s_file = getCFile();
-
-	char cNomImgLue[250];
-	strcpy(cNomImgLue, s_file.c_str());
-
-	string toErase = ".pgm";
-	size_t pos = s_file.find(".pgm");
-	s_file.erase(pos, toErase.length());
-	string s_fileNew = s_file + "_E.pgm";
-	char cNomImgEcriteEnc[250];
-	strcpy(cNomImgEcriteEnc, s_fileNew.c_str());
-
-	int nH, nW, nTaille;
-	uint64_t n = model->getInstance()->getPublicKey().getN();
-	uint64_t g = model->getInstance()->getPublicKey().getG();
-
-	OCTET *ImgIn;
-	image_pgm::lire_nb_lignes_colonnes_image_p(cNomImgLue, &nH, &nW);
-
-	if (distributeOnTwo)
-	{
-		uint8_t *ImgOutEnc;
-		// T_in *ImgOutEnc;
-		nTaille = nH * nW;
-
-		allocation_tableau(ImgIn, OCTET, nTaille);
-		image_pgm::lire_image_p(cNomImgLue, ImgIn, nTaille);
-		allocation_tableau(ImgOutEnc, OCTET, nH * (2 * nW));
-		uint64_t x = 0, y = 1;
-
-		// int bitsCompressed = 4;
-		// int mod = pow((double)2,(double)bitsCompressed);
-
-		for (int i = 0; i < nTaille; i++)
-		{
-			uint8_t pixel = histogramExpansion(ImgIn[i], recropPixels);
-			uint16_t pixel_enc = paillier.paillierEncryption(n, g, pixel);
-
-			// while (pixel_enc % mod != 0)
-			// {
-			// 	pixel_enc = paillier.paillierEncryption(n, g, pixel);
-			// }
-
-			std::bitset<16> set_pixel = pixel_enc;
-
-			std::bitset<8> set_x;
-			std::bitset<8> set_y;
-
-			int k = 0;
-			for (int l = 0; l < 8; l++)
-			{
-				set_x.set(l,set_pixel[k]);
-				k++;
-			}
-			for (int l = 0; l < 8; l++)
-			{
-				set_y.set(l,set_pixel[k]);
-				k++;
-			}
-
-			uint8_t pixel_enc_dec_x = (uint8_t)set_x.to_ulong();
-			uint8_t pixel_enc_dec_y = (uint8_t)set_y.to_ulong();
-
-			ImgOutEnc[x] = pixel_enc_dec_x;
-			ImgOutEnc[y] = pixel_enc_dec_y;
-
-			// uint8_t pixel_enc_dec_x = pixel_enc / n;
-			// uint8_t pixel_enc_dec_y = pixel_enc % n;
-			// ImgOutEnc[x] = pixel_enc_dec_x;
-			// ImgOutEnc[y] = pixel_enc_dec_y;
-			x = x + 2;
-			y = y + 2;
-		}
-
-		image_pgm::ecrire_image_pgm_variable_size(cNomImgEcriteEnc, ImgOutEnc, nH, nW * 2, n);
-
-		free(ImgIn);
-		free(ImgOutEnc);
-	}
-	else
-	{
-		uint16_t *ImgOutEnc;
-		nTaille = nH * nW;
-
-		allocation_tableau(ImgIn, OCTET, nTaille);
-		image_pgm::lire_image_p(cNomImgLue, ImgIn, nTaille);
-		allocation_tableau(ImgOutEnc, uint16_t, nTaille);
-
-		for (int i = 0; i < nTaille; i++)
-		{
-			uint8_t pixel = histogramExpansion(ImgIn[i], recropPixels);
-			uint16_t pixel_enc = paillier.paillierEncryption(n, g, pixel);
-			ImgOutEnc[i] = pixel_enc;
-		}
-
-		image_pgm::ecrire_image_pgm_variable_size(cNomImgEcriteEnc, ImgOutEnc, nH, nW, n * n);
-
-		free(ImgIn);
-		free(ImgOutEnc);
-		nTaille = nH * nW;
-	}
-}
-
-template <typename T_in, typename T_out>
-void PaillierControllerPGM::decrypt(bool distributeOnTwo, Paillier<T_in, T_out> paillier)
-{
-	string s_file = getCFile();
-	char cNomImgLue[250];
-	strcpy(cNomImgLue, s_file.c_str());
-
-	string toErase = ".pgm";
-	size_t pos = s_file.find(".pgm");
-	s_file.erase(pos, toErase.length());
-	string s_fileNew = s_file + "_D.pgm";
-	char cNomImgEcriteDec[250];
-	strcpy(cNomImgEcriteDec, s_fileNew.c_str());
-
-	int nH, nW, nTaille;
-	uint64_t n, lambda, mu;
-	lambda = model->getInstance()->getPrivateKey().getLambda();
-	mu = model->getInstance()->getPrivateKey().getMu();
-	n = model->getInstance()->getPrivateKey().getN();
-
-	OCTET *ImgOutDec;
-	image_pgm::lire_nb_lignes_colonnes_image_p(cNomImgLue, &nH, &nW);
-	nTaille = nH * nW;
-
-	if (distributeOnTwo)
-	{
-		uint8_t *ImgIn;
-
-		allocation_tableau(ImgIn, uint8_t, nTaille);
-		image_pgm::lire_image_pgm_and_get_maxgrey(cNomImgLue, ImgIn, nTaille); // TODO : Retirer and_get_maxgrey
-		allocation_tableau(ImgOutDec, OCTET, nH * (nW / 2));
-
-		int x = 0, y = 1;
-		for (int i = 0; i < nH * (nW / 2); i++)
-		{
-			
-			std::bitset<8> set_x = ImgIn[x];
-			std::bitset<8> set_y = ImgIn[y];
-
-			std::bitset<16> set_pixel;
-
-			int k = 0;
-			for (int l = 0; l < 8; l++)
-			{
-				set_pixel.set(k,set_x[l]);
-				k++;
-			}
-			for (int l = 0; l < 8; l++)
-			{
-				set_pixel.set(k,set_y[l]);
-				k++;
-			}
-
-			uint16_t pixel = (uint16_t)set_pixel.to_ulong();
-			
-			// uint8_t pixel_enc_dec_x = ImgIn[x];
-			// uint8_t pixel_enc_dec_y = ImgIn[y];
-			// pixel = (pixel_enc_dec_x * n) + pixel_enc_dec_y;
-			x = x + 2;
-			y = y + 2;
-			uint8_t c = paillier.paillierDecryption(n, lambda, mu, pixel);
-			ImgOutDec[i] = static_cast<OCTET>(c);
-		}
-		image_pgm::ecrire_image_p(cNomImgEcriteDec, ImgOutDec, nH, nW / 2);
-		free(ImgIn);
-		free(ImgOutDec);
-	}
-	else
-	{
-		uint16_t *ImgIn;
-		allocation_tableau(ImgIn, uint16_t, nTaille);
-		image_pgm::lire_image_pgm_and_get_maxgrey(cNomImgLue, ImgIn, nTaille);
-		allocation_tableau(ImgOutDec, OCTET, nTaille);
-
-		for (int i = 0; i < nTaille; i++)
-		{
-			uint16_t pixel = ImgIn[i];
-			uint8_t c = paillier.paillierDecryption(n, lambda, mu, pixel);
-			ImgOutDec[i] = static_cast<OCTET>(c);
-		}
-		image_pgm::ecrire_image_p(cNomImgEcriteDec, ImgOutDec, nH, nW);
-		free(ImgIn);
-		free(ImgOutDec);
-	}
-}
-
-template <typename T_in, typename T_out>
-void PaillierControllerPGM::encryptCompression_16bpp(bool recropPixels, Paillier<T_in, T_out> paillier, int bitsCompressed)
-{
-	string s_file = getCFile();
-
-	char cNomImgLue[250];
-	strcpy(cNomImgLue, s_file.c_str());
-
-	string toErase = ".pgm";
-	size_t pos = s_file.find(".pgm");
-	s_file.erase(pos, toErase.length());
-	string s_fileNew = s_file + "_E.pgm";
-	char cNomImgEcriteEnc[250];
-	strcpy(cNomImgEcriteEnc, s_fileNew.c_str());
-
-	int nH, nW, nTaille; // TODO : Change nH nW to uint16_t and nTaille type to uint32_t
-	uint64_t n = model->getInstance()->getPublicKey().getN();
-	uint64_t g = model->getInstance()->getPublicKey().getG();
-
-	OCTET *ImgIn;
-	image_pgm::lire_nb_lignes_colonnes_image_p(cNomImgLue, &nH, &nW);
-
-	uint16_t *ImgOutEnc;
-
-	nTaille = nH * nW;
-
-	allocation_tableau(ImgIn, OCTET, nTaille);
-	image_pgm::lire_image_p(cNomImgLue, ImgIn, nTaille);
-	allocation_tableau(ImgOutEnc, uint16_t, nTaille);
-
-	int mod = pow((double)2,(double)bitsCompressed);
-	for (int i = 0; i < nTaille; i++)
-	{
-		uint8_t pixel = histogramExpansion(ImgIn[i], recropPixels);
-		uint16_t pixel_enc = paillier.paillierEncryption(n, g, pixel);
-
-		while (pixel_enc % mod != 0)
-		{
-			pixel_enc = paillier.paillierEncryption(n, g, pixel);
-		}
-
-		ImgOutEnc[i] = pixel_enc;
-	}
-
-	uint16_t *ImgOutEncComp = compressBits_16bpp(ImgOutEnc, nH, nW, bitsCompressed);
-	int nbPixelsComp = ceil((double)(nH * nW * (16 - bitsCompressed)) / 16);
-
-	pair<int, int> dimensionComp = decomposeDimension(nbPixelsComp);
-	int nHComp = dimensionComp.first;
-	int nWComp = dimensionComp.second;
-
-	image_pgm::write_image_pgm_compressed_variable_size(cNomImgEcriteEnc, ImgOutEncComp, nHComp, nWComp, n * n, nbPixelsComp, nH, nW);
-
-	free(ImgIn);
-	free(ImgOutEnc);
-	delete[] ImgOutEncComp;
-}
-
-template <typename T_in, typename T_out>
-void PaillierControllerPGM::decryptCompression_16bpp(Paillier<T_in, T_out> paillier, int bitsCompressed)
-{
-	string s_file = getCFile();
-	char cNomImgLue[250];
-	strcpy(cNomImgLue, s_file.c_str());
-
-	string toErase = ".pgm";
-	size_t pos = s_file.find(".pgm");
-	s_file.erase(pos, toErase.length());
-	string s_fileNew = s_file + "_D.pgm";
-	char cNomImgEcriteDec[250];
-	strcpy(cNomImgEcriteDec, s_fileNew.c_str());
-
-	int nH, nW, nTaille, nHComp, nWComp, nTailleComp;
-	uint64_t n, lambda, mu;
-	lambda = model->getInstance()->getPrivateKey().getLambda();
-	mu = model->getInstance()->getPrivateKey().getMu();
-	n = model->getInstance()->getPrivateKey().getN();
-
-	OCTET *ImgOutDec;
-	image_pgm::lire_nb_lignes_colonnes_image_p_comp(cNomImgLue, &nHComp, &nWComp);
-	nTailleComp = nHComp * nWComp;
-	uint16_t *ImgInComp;
-	allocation_tableau(ImgInComp, uint16_t, nTailleComp);
-	pair<int, int> dimesionOriginal = image_pgm::read_image_pgm_compressed_and_get_originalDimension(cNomImgLue, ImgInComp);
-
-	nH = dimesionOriginal.second;
-	nW = dimesionOriginal.first;
-	nTaille = nH * nW;
-
-	allocation_tableau(ImgOutDec, OCTET, nTaille);
-
-	uint16_t *ImgInEnc = decompressBits_16bpp(ImgInComp, nH, nW, nTaille, bitsCompressed);
-
-	for (int i = 0; i < nTaille; i++)
-	{
-		uint16_t pixel = ImgInEnc[i];
-		uint8_t c = paillier.paillierDecryption(n, lambda, mu, pixel);
-		ImgOutDec[i] = static_cast<OCTET>(c);
-	}
-	image_pgm::ecrire_image_p(cNomImgEcriteDec, ImgOutDec, nH, nW);
-	free(ImgInComp);
-	free(ImgOutDec);
-}
-
-
-
-template <typename T_in, typename T_out>
-void PaillierControllerPGM::encryptCompression_8bpp(bool recropPixels, Paillier<T_in, T_out> paillier, int bitsCompressed)
-{
-	string s_file = getCFile();
-
-	char cNomImgLue[250];
-	strcpy(cNomImgLue, s_file.c_str());
-
-	string toErase = ".pgm";
-	size_t pos = s_file.find(".pgm");
-	s_file.erase(pos, toErase.length());
-	string s_fileNew = s_file + "_E.pgm";
-	char cNomImgEcriteEnc[250];
-	strcpy(cNomImgEcriteEnc, s_fileNew.c_str());
-
-	int nH, nW, nTaille; // TODO : Change nH nW to uint16_t and nTaille type to uint32_t
-	uint64_t n = model->getInstance()->getPublicKey().getN();
-	uint64_t g = model->getInstance()->getPublicKey().getG();
-
-	OCTET *ImgIn;
-	image_pgm::lire_nb_lignes_colonnes_image_p(cNomImgLue, &nH, &nW);
-
-	uint16_t *ImgOutEnc;
-
-	nTaille = nH * nW;
-
-	allocation_tableau(ImgIn, OCTET, nTaille);
-	image_pgm::lire_image_p(cNomImgLue, ImgIn, nTaille);
-	allocation_tableau(ImgOutEnc, uint16_t, nTaille);
-
-	int mod = pow((double)2,(double)bitsCompressed);
-	for (int i = 0; i < nTaille; i++)
-	{
-		uint8_t pixel = histogramExpansion(ImgIn[i], recropPixels);
-		uint16_t pixel_enc = paillier.paillierEncryption(n, g, pixel);
-
-		while (pixel_enc % mod != 0)
-		{
-			pixel_enc = paillier.paillierEncryption(n, g, pixel);
-		}
-
-		ImgOutEnc[i] = pixel_enc;
-	}
-
-	uint8_t *ImgOutEncComp = compressBits_8bpp(ImgOutEnc, nH, nW, bitsCompressed);
-	int nbPixelsComp = ceil((double)(nH * nW * (16 - bitsCompressed)) / 16);
-
-	nbPixelsComp = nbPixelsComp * 2;
-	pair<int, int> dimensionComp = decomposeDimension(nbPixelsComp);
-	int nHComp = dimensionComp.first;
-	int nWComp = dimensionComp.second;
-
-	image_pgm::write_image_pgm_compressed_variable_size(cNomImgEcriteEnc, ImgOutEncComp, nHComp, nWComp, 255, nbPixelsComp, nH, nW);
-
-	free(ImgIn);
-	free(ImgOutEnc);
-	delete[] ImgOutEncComp;
-}
-
-template <typename T_in, typename T_out>
-void PaillierControllerPGM::decryptCompression_8bpp(Paillier<T_in, T_out> paillier, int bitsCompressed)
-{
-	string s_file = getCFile();
-	char cNomImgLue[250];
-	strcpy(cNomImgLue, s_file.c_str());
-
-	string toErase = ".pgm";
-	size_t pos = s_file.find(".pgm");
-	s_file.erase(pos, toErase.length());
-	string s_fileNew = s_file + "_D.pgm";
-	char cNomImgEcriteDec[250];
-	strcpy(cNomImgEcriteDec, s_fileNew.c_str());
-
-	int nH, nW, nTaille, nHComp, nWComp, nTailleComp;
-	uint64_t n, lambda, mu;
-	lambda = model->getInstance()->getPrivateKey().getLambda();
-	mu = model->getInstance()->getPrivateKey().getMu();
-	n = model->getInstance()->getPrivateKey().getN();
-
-	OCTET *ImgOutDec;
-	image_pgm::lire_nb_lignes_colonnes_image_p_comp(cNomImgLue, &nHComp, &nWComp);
-	nTailleComp = nHComp * nWComp;
-	uint8_t *ImgInComp;
-	allocation_tableau(ImgInComp, uint8_t, nTailleComp);
-	pair<int, int> dimesionOriginal = image_pgm::read_image_pgm_compressed_and_get_originalDimension(cNomImgLue, ImgInComp);
-
-	nH = dimesionOriginal.second;
-	nW = dimesionOriginal.first;
-	nTaille = nH * nW;
-
-	allocation_tableau(ImgOutDec, OCTET, nTaille);
-
-	uint16_t *ImgInEnc = decompressBits_8bpp(ImgInComp, nH, nW, nTaille, bitsCompressed);
-
-	for (int i = 0; i < nTaille; i++)
-	{
-		uint16_t pixel = ImgInEnc[i];
-		uint8_t c = paillier.paillierDecryption(n, lambda, mu, pixel);
-		ImgOutDec[i] = static_cast<OCTET>(c);
-	}
-	image_pgm::ecrire_image_p(cNomImgEcriteDec, ImgOutDec, nH, nW);
-	free(ImgInComp);
-	free(ImgOutDec);
-}
-
-
-
-
+/**
+ * \file PaillierControllerPGM.hpp
+ * \brief Header file for the PaillierControllerPGM class, which is a
+ * controller for the Paillier cryptosystem applied to PGM (Portable Gray Map)
+ * images.
+ * \author Katia Auxilien
+ * \date 29 May 2024, 13:55:00
+ * \details 
+ */
+
+#ifndef PAILLIERCONTROLLER_PGM
+#define PAILLIERCONTROLLER_PGM
+
+#include <stdio.h>
+#include <cctype>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <stdio.h>
+#include <ctype.h> //uintN_t
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <map>
+#include <condition_variable>
+#include <stdexcept>
+#include <cinttypes>
+
+#include "../../include/controller/PaillierController.hpp"
+#include "../../include/model/image/image_portable.hpp"
+#include "../../include/model/image/image_pgm.hpp"
+#include "../../include/model/image/PgmView.hpp"
+#include "../../include/model/filesystem/filesystemPGM.hpp"
+#include "../../include/model/encryption/Paillier/NoisePool.hpp"
+#include "../../include/model/encryption/Paillier/DecryptionTable.hpp"
+#include "../../include/model/encryption/Paillier/ZeroLsbTable.hpp"
+#include "../../include/model/encryption/Paillier/SlotPacking.hpp"
+#include "../../include/model/encryption/Paillier/HomomorphicKernel.hpp"
+#include "../../include/model/parallel/ThreadPool.hpp"
+#include "../../include/model/parallel/Pipeline.hpp"
+#include "../../include/model/compression/BitPacker.hpp"
+#include "../../include/model/network/UnixSocket.hpp"
+#include "../../include/model/network/DaemonProtocol.hpp"
+#include "../../include/model/profiling/Profiler.hpp"
+
+/**
+ * \class PaillierControllerPGM
+ * \brief Controller for the Paillier cryptosystem applied to PGM images.
+ * \details This class is responsible for controlling the Paillier cryptosystem
+ * applied to PGM images. It inherits from the PaillierController class and
+ * provides additional functionalities specific to PGM images.
+ * \author Katia Auxilien
+ * \date 29 May 2024, 13:55:00
+ */
+class PaillierControllerPGM : public PaillierController
+{
+
+protected:
+	char *c_file; /*!< Pointer to the char array containing the file name. */
+	DecryptionTable decryptionTable; /*!< Decryption lookup table, used when it is built. */
+	std::unique_ptr<ThreadPool> threadPool; /*!< Threads encrypting or decrypting the pixels. */
+	unsigned bandRows; /*!< Number of rows of the bands the images are streamed by, 0 for the whole image. */
+	string folder; /*!< Folder of the images of the batch mode, empty to process c_file only. */
+	int packGuardBits; /*!< Guard bits of the slots of the packed images (-pack), -1 if the pixels are not packed. */
+	std::map<int, std::unique_ptr<ZeroLsbTable>> zeroLsbTables; /*!< Ciphertexts with zero LSB per number of bits, built once for all the images, NULL if n is too large. */
+	std::mutex zeroLsbMutex; /*!< Protects the building of zeroLsbTables. */
+	string socketPath; /*!< Unix socket of the daemon mode. */
+	bool hasPublicKey; /*!< True if the daemon loaded a public key, to encrypt. */
+	bool hasPrivateKey; /*!< True if the daemon loaded a private key, to decrypt. */
+	UnixSocket listener; /*!< Socket the daemon accepts its clients on. */
+	bool stopping; /*!< True once the daemon was asked to stop. */
+	bool resident; /*!< True in the daemon mode, where an error of an image fails its request instead of stopping the program. */
+	unsigned clients; /*!< Number of clients connected to the daemon. */
+	std::mutex clientsMutex; /*!< Protects stopping and clients. */
+	std::condition_variable clientsDone; /*!< Signals a client leaving the daemon. */
+
+	/**
+	 * \struct EvalOperation
+	 * \brief Homomorphic operation of the eval mode, applied to every ciphertext of the image.
+	 */
+	struct EvalOperation
+	{
+		enum Kind
+		{
+			ADD_IMAGE,    //!< E(x)·E(y) = E(x + y), with the pixels of another encrypted image.
+			ADD_CONSTANT, //!< E(x)·g^k = E(x + k).
+			MUL_SCALAR    //!< E(x)^s = E(s·x).
+		} kind;
+		string image;   /*!< The other encrypted image of ADD_IMAGE. */
+		int64_t value;  /*!< k of ADD_CONSTANT, s of MUL_SCALAR. */
+	};
+
+	string evalImage; /*!< Encrypted image of the eval mode. */
+	std::vector<EvalOperation> evalOperations; /*!< Operations of the eval mode, in the order of the command line. */
+	int evalFactor; /*!< Side of the blocks summed by the downscaling of the eval mode (-downscale), 0 not to downscale. */
+	bool evalSum; /*!< True to sum the pixels of the image or of evalRegion in the eval mode (-sum, -region). */
+	size_t evalRegion[4]; /*!< Column, row, width and height of the region summed, a width of 0 for the whole image until evaluate. */
+
+	/**
+	 * \brief Downscale an encrypted image by summing its blocks of pixels.
+	 * \details The pixel (i, j) of the result encrypts the sum of the pixels of the block of
+	 * evalFactor x evalFactor pixels from row i·evalFactor and column j·evalFactor, the blocks
+	 * of the last row and column being smaller if evalFactor does not divide the size. The
+	 * ciphertexts are packed ones of a single slot.
+	 * \param const uint8_t *ciphers - The rows × cols ciphertexts.
+	 * \param size_t rows - The number of rows.
+	 * \param size_t cols - The number of ciphertexts of a row.
+	 * \param uint64_t maxValue - The maximum value of the image, 255.
+	 * \param const SlotPacking &layout - The layout of the image, of a single slot.
+	 * \param uint64_t maxSum - The largest sum of a block, recorded in the layout of the result.
+	 * \param const char *file - The downscaled image, with the layout of the image.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void downscaleCiphers(const uint8_t *ciphers, size_t rows, size_t cols, uint64_t maxValue, const SlotPacking &layout, uint64_t maxSum, const char *file);
+
+	/**
+	 * \brief Sum the pixels of evalRegion of an encrypted image.
+	 * \details The rows of the region are reduced in parallel, then their products by a
+	 * parallel tree reduction. The ciphertexts are those of downscaleCiphers.
+	 * \param const uint8_t *ciphers - The ciphertexts, row after row.
+	 * \param size_t cols - The number of ciphertexts of a row.
+	 * \param uint64_t maxValue - The maximum value of the image, 255.
+	 * \param const SlotPacking &layout - The layout of the image, of a single slot.
+	 * \param uint64_t maxSum - The largest sum, recorded in the layout of the result.
+	 * \param string file - The image of one ciphertext the sum is written to.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void sumCiphers(const uint8_t *ciphers, size_t cols, uint64_t maxValue, const SlotPacking &layout, uint64_t maxSum, string file);
+
+	/**
+	 * \brief Processing of an image with a Paillier instantiation, see processImageWith.
+	 */
+	typedef void (PaillierControllerPGM::*ImageKernel)(string, bool, bool, bool, bool, bool);
+
+	/**
+	 * \struct ImageKernelEntry
+	 * \brief Entry of the dispatch table of the image kernels.
+	 */
+	struct ImageKernelEntry
+	{
+		bool (*supportsKey)(uint64_t n); /*!< True if the instantiation holds the plaintexts and the ciphertexts of n. */
+		ImageKernel kernel;             /*!< The processing of an image with the instantiation. */
+	};
+
+	static const ImageKernelEntry IMAGE_KERNELS[]; /*!< Instantiations of the image kernels, narrowest ciphertexts first. */
+	static const ImageKernelEntry PACKED_KERNELS[]; /*!< Instantiations of the packed image kernels, narrowest ciphertexts first. */
+
+	/**
+	 * \brief Pick the image kernel of a key in IMAGE_KERNELS, or in PACKED_KERNELS.
+	 * \param uint64_t n - The n parameter of the key.
+	 * \param bool packed - True for the kernels of the packed images (-pack).
+	 * \return ImageKernel - The narrowest instantiation supporting n, NULL if there is none.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	static ImageKernel imageKernelFor(uint64_t n, bool packed = false);
+
+	/**
+	 * \brief Encrypt or decrypt an image with the Paillier instantiation chosen for the key.
+	 * \details Only the mode is chosen here, the instantiation is fixed by the dispatch of
+	 * processImage, so the loops over the pixels run a kernel specialised for the width of n².
+	 * \tparam T_in The input integer type.
+	 * \tparam T_out The output integer type.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	template <typename T_in, typename T_out>
+	void processImageWith(string s_file, bool isEncryption, bool distributeOnTwo, bool recropPixels, bool optimisationLSB32, bool optimisationLSB16);
+
+	/**
+	 * \brief Encrypt or decrypt a packed image with the Paillier instantiation chosen for the key.
+	 * \details The signature is the one of processImageWith, so that the packed kernels share
+	 * the dispatch table entries; -d, -olsbr32 and -olsbr16 are refused with -pack.
+	 * \tparam T_in The input integer type, holding a packed plaintext.
+	 * \tparam T_out The output integer type.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	template <typename T_in, typename T_out>
+	void processPackedImageWith(string s_file, bool isEncryption, bool distributeOnTwo, bool recropPixels, bool optimisationLSB32, bool optimisationLSB16);
+
+	/**
+	 * \brief Run a loop over the pixels of an image with the thread pool.
+	 * \details Pixels are independent, each block [begin, end) is processed by one thread,
+	 * which must work on its own copy of the Paillier object. The copies share the table of
+	 * g^m of the original (see Paillier::buildGmTable), so it is built before the loop.
+	 * \tparam F Callable as f(size_t begin, size_t end).
+	 * \param size_t nbPixels - The number of pixels.
+	 * \param F f - The processing of a block of pixels.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	template <typename F>
+	void parallelPixels(size_t nbPixels, F f)
+	{
+		threadPool->parallelFor(nbPixels, f);
+	};
+
+	/**
+	 * \brief Run a loop over the pixels [first, last) of an image with the thread pool.
+	 * \tparam F Callable as f(size_t begin, size_t end), with first <= begin < end <= last.
+	 * \param size_t first - The first pixel.
+	 * \param size_t last - The pixel after the last one.
+	 * \param F f - The processing of a block of pixels.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	template <typename F>
+	void parallelPixels(size_t first, size_t last, F f)
+	{
+		threadPool->parallelFor(last - first, [&](size_t begin, size_t end)
+							  { f(first + begin, first + end); });
+	};
+
+	/**
+	 * \brief Number of pixels of the bands an image is streamed by.
+	 * \details A band is bandRows rows, rounded up to a multiple of align pixels so that the
+	 * packed bits of a band start on a byte of the compressed image.
+	 * \param size_t nbPixels - The number of pixels of the image.
+	 * \param int nW - The number of columns of the image.
+	 * \param size_t align - The multiple of the number of pixels of a band.
+	 * \return size_t - The number of pixels of a band, nbPixels if the image is not streamed.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	size_t bandPixels(size_t nbPixels, int nW, size_t align = 1) const;
+
+	/**
+	 * \brief Process an image band after band.
+	 * \details An image of a single band is only processed. Otherwise the bands go through
+	 * a pipeline : read loads the pixels of a band from the input file while the previous
+	 * band is processed, and write stores the processed band in the output file and releases
+	 * its pages, so the disk works while the threads compute. The throughput of each stage
+	 * is printed at the end.
+	 * \tparam R Callable as read(size_t first, size_t last), the pixels of a band.
+	 * \tparam P Callable as process(size_t first, size_t last).
+	 * \tparam W Callable as write(size_t first, size_t last).
+	 * \param size_t nbPixels - The number of pixels of the image.
+	 * \param size_t band - The number of pixels of a band, from bandPixels.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	template <typename R, typename P, typename W>
+	void forEachBand(size_t nbPixels, size_t band, R read, P process, W write)
+	{
+		if (band >= nbPixels)
+		{
+			process(0, nbPixels);
+			return;
+		}
+		Pipeline pipeline;
+		pipeline.run(nbPixels, band, read, process, write);
+		printPipelineStats(pipeline);
+	};
+
+	/**
+	 * \brief Print the number of bands and the throughput of each stage of a pipeline.
+	 * \param const Pipeline &pipeline - The pipeline, after its run.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void printPipelineStats(const Pipeline &pipeline) const;
+
+	/**
+	 * \brief Stop the processing if a band could not be written to an image, see failImage.
+	 * \param bool written - The result of PgmView::flush.
+	 * \param const char *path - The image.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void checkWriting(bool written, const char *path);
+
+	/**
+	 * \brief Table of the ciphertexts with bitsCompressed zero LSB of the public key.
+	 * \details The table is built at the first call for this number of bits and shared by
+	 * the images of a batch or the requests of the daemon, which may mix both numbers of bits.
+	 * \param int bitsCompressed - The number of zero LSB.
+	 * \return const ZeroLsbTable* - The table, NULL if n is too large for a table.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	const ZeroLsbTable *getZeroLsbTable(int bitsCompressed);
+
+	/**
+	 * \brief Largest n, in bits, that the image kernels support for every key of that size.
+	 * \details checkParameters refuses a larger -bits before the key is written, a controller
+	 * of another format overrides it with its own kernels.
+	 * \param bool packed - True for the kernels of the packed images (-pack).
+	 * \return unsigned - The number of bits, 0 if no key is supported.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	virtual unsigned maxImageKeyBits(bool packed) const;
+
+	/**
+	 * \brief Extension of the images given on the command line.
+	 * \details checkParameters accepts the images with this extension, a controller of another
+	 * format overrides it.
+	 * \param bool isEncryption - True for the images to encrypt, false for the encrypted images.
+	 * \return string - ".pgm".
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	virtual string imageExtension(bool isEncryption) const;
+
+	/**
+	 * \brief Stop the processing of an image on an error.
+	 * \details Outside the daemon the message is printed and the program stops. In the daemon
+	 * the message is thrown as a std::runtime_error, caught by runFileRequest which answers
+	 * the request with DaemonProtocol::ERROR, so that one image never stops the daemon.
+	 * \param const string &message - The error.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	[[noreturn]] void failImage(const string &message);
+
+	/**
+	 * \brief Stop the processing if an image could not be mapped in memory, see failImage.
+	 * \param bool mapped - The result of PgmView::open or PgmView::create.
+	 * \param const char *path - The image.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void checkMapping(bool mapped, const char *path);
+
+	/**
+	 * \brief Answer the requests of a client of the daemon until it disconnects.
+	 * \param UnixSocket &client - The connection of the client.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void serveClient(UnixSocket &client);
+
+	/**
+	 * \brief Encrypt or decrypt an image file for a client of the daemon.
+	 * \details The options and the image are checked before processImage, so that an invalid
+	 * request is answered by an error instead of stopping the daemon.
+	 * \param const string &arguments - The options followed by the image.
+	 * \param bool isEncryption - True to encrypt, false to decrypt.
+	 * \return string - The reply, OK followed by the image written or ERROR followed by the reason.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	string runFileRequest(const string &arguments, bool isEncryption);
+
+	/**
+	 * \brief Encrypt or decrypt a buffer of pixels for a client of the daemon.
+	 * \details The pixels announced in the request are read, processed and sent back after
+	 * the reply line.
+	 * \param UnixSocket &client - The connection of the client.
+	 * \param const string &arguments - The number of pixels.
+	 * \param bool isEncryption - True to encrypt, false to decrypt.
+	 * \return bool - False if the connection cannot be used any more.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	bool runPixelsRequest(UnixSocket &client, const string &arguments, bool isEncryption);
+
+	/**
+	 * \brief Split an encrypted pixel on two bytes, least significant byte first.
+	 * \details The two bytes are the little-endian layout of the pixel, so on a
+	 * little-endian processor this is a single 16-bit store.
+	 * \param uint16_t pixel - The encrypted pixel.
+	 * \param uint8_t *out - The two bytes.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	static void splitPixel(uint16_t pixel, uint8_t *out)
+	{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+		memcpy(out, &pixel, 2);
+#else
+		out[0] = static_cast<uint8_t>(pixel);
+		out[1] = static_cast<uint8_t>(pixel >> 8);
+#endif
+	};
+
+	/**
+	 * \brief Merge two bytes, least significant byte first, into an encrypted pixel.
+	 * \param const uint8_t *in - The two bytes.
+	 * \return uint16_t - The encrypted pixel.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	static uint16_t mergePixel(const uint8_t *in)
+	{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+		uint16_t pixel;
+		memcpy(&pixel, in, 2);
+		return pixel;
+#else
+		return static_cast<uint16_t>(in[0] | (in[1] << 8));
+#endif
+	};
+
+	/**
+	 * \brief Decrypt a pixel, with the lookup table when it is built.
+	 * \tparam T_in The input integer type.
+	 * \tparam T_out The output integer type.
+	 * \param Paillier<T_in, T_out> &paillier - A Paillier object used for decryption.
+	 * \param const PaillierPrivateKey &privateKey - The private key.
+	 * \param T_out pixel - The encrypted pixel.
+	 * \return T_in - The decrypted pixel.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	template <typename T_in, typename T_out>
+	T_in decryptPixel(Paillier<T_in, T_out> &paillier, const PaillierPrivateKey &privateKey, T_out pixel)
+	{
+		if (decryptionTable.isBuilt())
+		{
+			return static_cast<T_in>(decryptionTable.decrypt(pixel));
+		}
+		return paillier.paillierDecryption(privateKey, pixel);
+	};
+
+public:
+	/**
+	 * \brief
+	 * \brief Default constructor.
+	 * \details This constructor initializes the PaillierControllerPGM object with
+	 * default values.
+	 * \author Katia Auxilien
+	 * \date 29 May 2024, 13:55:00
+	 */
+	PaillierControllerPGM();
+
+	/**
+	 * \brief Destructor.
+	 * \details This destructor frees the memory allocated by the PaillierControllerPGM object.
+	 * \author Katia Auxilien
+	 * \date 29 May 2024, 13:55:00
+	 */
+	~PaillierControllerPGM();
+
+	/**
+	 * \brief
+	 *
+	 */
+	void init();
+
+	/**
+	 * \brief
+	 * \brief Getter for the c_file attribute.
+	 * \details This method returns the value of the c_file attribute.
+	 * \return A constant pointer to the char array containing the file name.
+	 * \author Katia Auxilien
+	 * \date 29 May 2024, 13:55:00
+	 */
+	const char *getCFile() const;
+
+	/**
+	 * \brief Setter for the c_file attribute.
+	 * \details This method sets the value of the c_file attribute.
+	 * \param newCFile A pointer to the char array containing the new file name.
+	 * \author Katia Auxilien
+	 * \date 29 May 2024, 13:55:00
+	 */
+	void setCFile(char *newCFile);
+
+	/**
+	 * \brief Getter for the number of threads processing the pixels.
+	 * \return unsigned - The number of threads.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	unsigned getThreads() const;
+
+	/**
+	 * \brief Setter for the number of threads processing the pixels.
+	 * \param unsigned threads - The number of threads, 0 for the number of cores.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void setThreads(unsigned threads);
+
+	/**
+	 * \brief Getter for the number of rows of the bands the images are streamed by.
+	 * \return unsigned - The number of rows, 0 for the whole image.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	unsigned getBandRows() const;
+
+	/**
+	 * \brief Setter for the number of rows of the bands the images are streamed by.
+	 * \param unsigned rows - The number of rows, 0 for the whole image.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void setBandRows(unsigned rows);
+
+	/**
+	 * \brief Getter for the folder of the batch mode.
+	 * \return string - The folder, empty if a single image is processed.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	string getFolder() const;
+
+	/**
+	 * \brief Setter for the folder of the batch mode.
+	 * \param string newFolder - The folder.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void setFolder(string newFolder);
+
+	/**
+	 * \brief Getter for the guard bits of the slots of the packed images.
+	 * \return int - The guard bits, -1 if the pixels are not packed.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	int getPackGuardBits() const;
+
+	/**
+	 * \brief Setter for the guard bits of the slots of the packed images.
+	 * \param int guardBits - The guard bits, -1 not to pack the pixels.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void setPackGuardBits(int guardBits);
+
+	/**
+	 *  \brief Check the parameters passed to the program.
+	 *  \details This method checks the parameters passed to the program and sets the
+	 * 	corresponding attributes of the PaillierControllerPGM object.
+	 * \param arg_in An array of char pointers containing the arguments passed to
+	 * the program.
+	 *  \param size_arg The size of the arg_in array.
+	 *  \param bool param[] array of flags to be set based on the command line
+	 * arguments.
+	 *				0	bool isEncryption = false ;
+	 *				1	bool useKeys = false;
+	 *				2	bool distributeOnTwo = false;
+	 *				3	bool recropPixels = false;
+	 *				4	bool optimisationLSB32 = false;
+	 *				5	bool optimisationLSB16 = false;
+	 *				6 	bool needHelp = false;
+	 *				7 	bool useDecryptionTable = false;
+	 *				8 	bool isKeyGeneration = false;
+	 *				9 	bool printStats = false;
+	 *  \authors Katia Auxilien
+	 *  \date 29 May 2024, 13:55:00
+	 */
+	void checkParameters(char *arg_in[], int size_arg, bool param[]);
+
+	/**
+	 * \brief Print the man page message.
+	 * \details This method prints the help message for the program.
+	 * \author Katia Auxilien
+	 * \date 29 May 2024, 13:55:00
+	 */
+	void printHelp();
+
+	/**
+	 * \brief Load the decryption lookup table of the private key, or build and save it.
+	 * \details The table file is stored next to the private key file (key.bin gives key_lut.bin).
+	 * When n² is too large for a table, a warning is printed and decryption stays per pixel.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void loadDecryptionTable();
+
+	/**
+	 * \brief Encrypt or decrypt an image with the options of the command line.
+	 * \param string s_file - The image.
+	 * \param bool isEncryption - True to encrypt, false to decrypt.
+	 * \param bool distributeOnTwo - True to split the encrypted pixels on two bytes.
+	 * \param bool recropPixels - True to expand the histogram before encryption.
+	 * \param bool optimisationLSB32 - True for the -olsbr32 compression.
+	 * \param bool optimisationLSB16 - True for the -olsbr16 compression.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void processImage(string s_file, bool isEncryption, bool distributeOnTwo, bool recropPixels, bool optimisationLSB32, bool optimisationLSB16);
+
+	/**
+	 * \brief Tell whether an image of the folder can be encrypted.
+	 * \details An image to encrypt has a maximum value of 255 and no packed layout. The images
+	 * that cannot be read are kept, their error is reported when they are processed.
+	 * \param const string &path - The image.
+	 * \return bool - False for an encrypted image.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	bool isPlainImage(const string &path);
+
+	/**
+	 * \brief Encrypt or decrypt every image of the folder with the options of the command line.
+	 * \details The key and the tables derived from it are loaded once for all the images. The
+	 * images are tasks of the thread pool, and the pixels of each image are loops of the same
+	 * pool, so the threads move from an image to another as they finish their work. Encryption
+	 * skips the images already encrypted or decrypted (_E.pgm and _D.pgm) and the other
+	 * encrypted images (see isPlainImage), decryption only takes the encrypted images (_E.pgm).
+	 * The number of images and of megabytes per second
+	 * is printed at the end.
+	 * \param bool isEncryption - True to encrypt, false to decrypt.
+	 * \param bool distributeOnTwo - True to split the encrypted pixels on two bytes.
+	 * \param bool recropPixels - True to expand the histogram before encryption.
+	 * \param bool optimisationLSB32 - True for the -olsbr32 compression.
+	 * \param bool optimisationLSB16 - True for the -olsbr16 compression.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void processFolder(bool isEncryption, bool distributeOnTwo, bool recropPixels, bool optimisationLSB32, bool optimisationLSB16);
+
+	/**
+	 * \brief Read the arguments of the daemon mode and load its keys.
+	 * \details ./PaillierPgm.out daemon [-public KEY.bin] [-private KEY.bin] [-socket PATH]
+	 * [-t N] [-band N] [-lut], with at least one key. The decryption table of -lut is
+	 * loaded or built here, once for all the requests.
+	 * \param char *arg_in[] - The arguments of the command line.
+	 * \param int size_arg - The number of arguments.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void checkDaemonParameters(char *arg_in[], int size_arg);
+
+	/**
+	 * \brief Run the daemon : accept clients on the Unix socket and answer their requests.
+	 * \details The keys, the decryption table, the ciphertexts with zero LSB and the thread
+	 * pool stay in memory between the requests. Each client is served by its own thread,
+	 * and the pixels of all the requests are shared by the threads of the pool. The daemon
+	 * returns after a SHUTDOWN request, once the connected clients are gone. The requests
+	 * are described in DaemonProtocol.hpp.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void serve();
+
+	/**
+	 * \brief Read the arguments of the eval mode and load its public key.
+	 * \details ./PaillierPgm.out eval -k PUBLIC_KEY.bin FILE_E.pgm [-add OTHER_E.pgm]
+	 * [-addconst K] [-mulconst S] [-downscale F] [-sum | -region X Y W H] [-t N] [-stats], with
+	 * at least one operation. The operations are applied in the order of the command line, the
+	 * downscaling and the sums after them, which need a packed image of a single slot.
+	 * \param char *arg_in[] - The arguments of the command line.
+	 * \param int size_arg - The number of arguments.
+	 * \return bool - True if the profile must be printed at the end (-stats).
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	bool checkEvalParameters(char *arg_in[], int size_arg);
+
+	/**
+	 * \brief Apply the operations of the eval mode to an encrypted image, without decrypting it.
+	 * \details The image may be encrypted with or without -d, or with -pack, whose layout is
+	 * read from the header; the images added must have the same layout. The result, written to
+	 * NAME_H.pgm for NAME.pgm, has the layout of the image and is decrypted with the same
+	 * options. Every block of ciphertexts goes through all the operations while it is in the
+	 * cache, the blocks being shared by the threads. The 16-bit ciphertexts (n² < 2¹⁶) are
+	 * processed by HomomorphicKernel, the packed ones by a Montgomery context of n².
+	 *
+	 * The results are plaintexts modulo n : the sums wrap modulo n for a 16-bit ciphertext,
+	 * and for a packed one each slot holds its sum as long as it stays below 2^(8 + G).
+	 *
+	 * With -downscale the image written to NAME_H.pgm is the downscaled one, see
+	 * downscaleCiphers, and with -sum or -region the sum is written to NAME_S.pgm, see
+	 * sumCiphers; both need packed ciphertexts of a single slot, and refuse the sums that
+	 * could reach n instead of writing them wrapped.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void evaluate();
+
+	/**
+	 * \brief Encrypt a buffer of pixels with the public key.
+	 * \param const uint8_t *pixels - The pixels.
+	 * \param size_t count - The number of pixels.
+	 * \param uint8_t *encrypted - The 2 * count bytes of the encrypted pixels, little-endian.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void encryptPixels(const uint8_t *pixels, size_t count, uint8_t *encrypted);
+
+	/**
+	 * \brief Decrypt a buffer of encrypted pixels with the private key.
+	 * \param const uint8_t *encrypted - The 2 * count bytes of the encrypted pixels, little-endian.
+	 * \param size_t count - The number of pixels.
+	 * \param uint8_t *pixels - The decrypted pixels.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void decryptPixels(const uint8_t *encrypted, size_t count, uint8_t *pixels);
+
+	/*********************** Encryption/Decryption ***********************/
+	/**
+	 *  \brief Perform histogram expansion on an image pixel.
+	 * \details This method performs histogram expansion on an image pixel to increase
+	 * the dynamic range of the image.
+	 * \param ImgPixel The input image pixel.
+	 * \param recropPixels A bool value indicating whether to recrop the pixels.
+	 * \return The histogram-expanded image pixel.
+	 * \author Katia Auxilien
+	 * \date 29 May 2024, 13:55:00
+	 */
+	uint8_t histogramExpansion(OCTET ImgPixel, bool recropPixels);
+
+	/**
+	 * \brief Perform histogram expansion on the pixels [begin, end) of an image.
+	 * \details The block is expanded before its encryption, so that the profiling times
+	 * the expansion apart from the encryption.
+	 * \param const OCTET *ImgIn - The pixels of the image.
+	 * \param size_t begin - The first pixel.
+	 * \param size_t end - The pixel after the last one.
+	 * \param bool recropPixels - True to expand the histogram, false to copy the pixels.
+	 * \return std::vector<uint8_t> - The end - begin pixels.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	std::vector<uint8_t> histogramExpansion(const OCTET *ImgIn, size_t begin, size_t end, bool recropPixels);
+
+	/**
+	 * \brief Print the time of each stage and the counters recorded by the profiler.
+	 * \details Prints a warning if the program is compiled without PAILLIER_PROFILING.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void printProfile();
+
+	/************** 8bits **************/
+	/**
+	 *  \brief Encrypt an image using the Paillier cryptosystem.
+	 * \details This method encrypts an image using the Paillier cryptosystem and
+	 * writes the encrypted image to a file.
+	 * \tparam T_in The input integer type.
+	 * \tparam T_out The output integer type.
+	 * \param s_file The image.
+	 * \param distributeOnTwo A bool value indicating whether to distribute the
+	 * encrypted pixels over two bytes.
+	 * \param recropPixels A bool value indicating whether to recrop the pixels.
+	 * \param paillier A Paillier object used for encryption.
+	 * \author Katia Auxilien
+	 * \date 29 May 2024, 13:55:00
+	 */
+	template <typename T_in, typename T_out>
+	void encrypt(string s_file, bool distributeOnTwo, bool recropPixels, Paillier<T_in, T_out> paillier);
+
+	/**
+	 *  \brief Decrypt an image using the Paillier cryptosystem.
+	 * \details This method decrypts an image using the Paillier cryptosystem and
+	 * writes the decrypted image to a file.
+	 * \tparam T_in The input integer type.
+	 * \tparam T_out The output integer type.
+	 * \param s_file The image.
+	 * \param distributeOnTwo A bool value indicating whether the encrypted pixels
+	 * were distributed over two bytes.
+	 * \param paillier A Paillier object used for decryption.
+	 * \author Katia Auxilien
+	 * \date 29 May 2024, 13:55:00
+	 */
+	template <typename T_in, typename T_out>
+	void decrypt(string s_file, bool distributeOnTwo, Paillier<T_in, T_out> paillier);
+
+	/**
+	 * \brief Encrypt an image using the Paillier cryptosystem with compression mod bitsCompressed.
+	 * \details This method encrypts an image using the Paillier cryptosystem with
+	 * compression and writes the encrypted image to a file.
+	 * \tparam T_in The input integer type.
+	 * \tparam T_out The output integer type.
+	 * \param s_file The image.
+	 * \param recropPixels A bool value indicating whether to recrop the pixels.
+	 * \param paillier A Paillier object used for encryption.
+	 * \param bitsCompressed An int representing how many bits to free.
+	 * \author Katia Auxilien
+	 * \date 19 June 2024
+	 */
+	template <typename T_in, typename T_out>
+	void encryptCompression_16bpp(string s_file, bool recropPixels, Paillier<T_in, T_out> paillier, int bitsCompressed);
+
+	/**
+	 * \brief This function compresses the encrypted bits of an image.
+	 * \details The bitsCompressed least significant bits of each encrypted pixel are at 0, so
+	 * only its 16 - bitsCompressed high bits are kept : they are packed one pixel after the
+	 * other, with BitPacker, into the nbPixelsComp 16-bit pixels of the caller's buffer, the
+	 * whole compressed image or the band of the pixels given. The words after the packed bits
+	 * are set to 0.
+	 * \param ImgInEnc The nbPixel encrypted pixels to compress.
+	 * \param nbPixel The number of pixels of the encrypted image, or of the band of the image to compress.
+	 * \param bitsCompressed An integer representig how many bits are at 0.
+	 * \param ImgOutEnc The pixels of the compressed image, in the byte order of the processor, usually mapped in the output file.
+	 * \param nbPixelsComp The number of 16-bit pixels of the compressed image, or of the band.
+	 * \authors Katia Auxilien
+	 * \date 29 May 2024, 13:55:00
+	 */
+	void compressBits_16bpp(uint16_t *ImgInEnc, size_t nbPixel, int bitsCompressed, uint8_t *ImgOutEnc, size_t nbPixelsComp);
+
+	/**
+	 * \brief Method to decompress an encrypted 16BPP PGM image.
+	 * \details This method decompresses an encrypted 8-bit PGM image that was
+	 * previously compressed using the encryptCompression method.
+	 * \param const uint8_t *ImgInEnc pointer to the encrypted and compressed image data, 16-bit pixels in the byte order of the processor.
+	 * \param size_t sizeComp number of 16-bit pixels readable from ImgInEnc.
+	 * \param bitsCompressed An integer representig how many bits are at 0.
+	 * \param uint16_t *ImgOutEnc pointer to the decompressed image data.
+	 * \param size_t nbPixel number of pixels to decompress, the whole image or a band.
+	 * \author Katia Auxilien
+	 * \date 29 mai 2024, 13:55:00
+	 */
+	void decompressBits_16bpp(const uint8_t *ImgInEnc, size_t sizeComp, int bitsCompressed, uint16_t *ImgOutEnc, size_t nbPixel);
+
+
+	/**
+	 * \brief This function compresses the encrypted bits of an image.
+	 * \details As compressBits_16bpp, the 16 - bitsCompressed high bits of each encrypted
+	 * pixel are packed one pixel after the other, with BitPacker, but into the nbPixelsComp
+	 * 8-bit pixels of the caller's buffer, the whole compressed image or the band of the
+	 * pixels given. The bytes after the packed bits are set to 0.
+	 * \param ImgInEnc The nbPixel encrypted pixels to compress.
+	 * \param nbPixel The number of pixels of the encrypted image, or of the band of the image to compress.
+	 * \param bitsCompressed An integer representig how many bits are at 0.
+	 * \param ImgOutEnc The pixels of the compressed image, usually mapped in the output file.
+	 * \param nbPixelsComp The number of 8-bit pixels of the compressed image, or of the band.
+	 * \authors Katia Auxilien
+	 * \date 29 May 2024, 13:55:00
+	 */
+	void compressBits_8bpp(uint16_t *ImgInEnc, size_t nbPixel, int bitsCompressed, uint8_t *ImgOutEnc, size_t nbPixelsComp);
+
+	/**
+	 * \brief Method to decompress an encrypted 8-bit PGM image.
+	 * \details This method decompresses an encrypted 8-bit PGM image that was
+	 * previously compressed using the encryptCompression method.
+	 * \param const uint8_t *ImgInEnc pointer to the encrypted and compressed image data.
+	 * \param size_t sizeComp number of 8-bit pixels readable from ImgInEnc.
+	 * \param bitsCompressed An integer representig how many bits are at 0.
+	 * \param uint16_t *ImgOutEnc pointer to the decompressed image data.
+	 * \param size_t nbPixel number of pixels to decompress, the whole image or a band.
+	 * \author Katia Auxilien
+	 * \date 29 mai 2024, 13:55:00
+	 */
+	void decompressBits_8bpp(const uint8_t *ImgInEnc, size_t sizeComp, int bitsCompressed, uint16_t *ImgOutEnc, size_t nbPixel);
+
+
+	/**
+	 * \brief Method to decompose the dimensions of a compressed image.
+	 * \details This method decomposes the dimensions of a compressed image into its
+	 * height and width components.
+	 * \param size_t n size of the compressed image in pixels.
+	 * \return pair<size_t, size_t> pair containing the height and width of the decomposed
+	 * image, the height being the largest divisor of n not above its square root.
+	 * \author Katia Auxilien
+	 * \date 29 mai 2024, 13:55:00
+	 */
+	pair<size_t, size_t> decomposeDimension(size_t n);
+
+	/**
+	 * \brief Height and width of a compressed image, which must fit in a PGM header.
+	 * \param size_t nbPixelsComp - The number of pixels of the compressed image.
+	 * \param const char *path - The compressed image.
+	 * \return pair<int, int> - The height and the width, from decomposeDimension.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	pair<int, int> compressedDimension(size_t nbPixelsComp, const char *path);
+
+	/**
+	 * \brief Method to decrypt an 16-bit PGM image with compression mod32
+	 * \details This method decrypts an 16-bit PGM image that was previously encrypted
+	 * using the encryptCompression method and performs decompression on the decrypted
+	 * image before writing it to a file.
+	 * \tparam T_in input integer type for Paillier cryptosystem.
+	 * \tparam T_out output integer type for Paillier cryptosystem.
+	 * \param s_file The image.
+	 * \param Paillier<T_in, T_out> paillier instance of the Paillier cryptosystem.
+	 * \param bitsCompressed An int representing how many bits to free.
+	 * \author Katia Auxilien
+	 * \date 19 June 2024
+	 */
+	template <typename T_in, typename T_out>
+	void decryptCompression_16bpp(string s_file, Paillier<T_in, T_out> paillier, int bitsCompressed);
+
+	/**
+	 * \brief Encrypt an image using the Paillier cryptosystem with compression mod bitsCompressed.
+	 * \details This method encrypts an image using the Paillier cryptosystem with
+	 * compression and writes the encrypted image to a file.
+	 * \tparam T_in The input integer type.
+	 * \tparam T_out The output integer type.
+	 * \param s_file The image.
+	 * \param recropPixels A bool value indicating whether to recrop the pixels.
+	 * \param paillier A Paillier object used for encryption.
+	 * \param bitsCompressed An int representing how many bits to free.
+	 * \author Katia Auxilien
+	 * \date 27 June 2024 9:19:00
+	 */
+	template <typename T_in, typename T_out>
+	void encryptCompression_8bpp(string s_file, bool recropPixels, Paillier<T_in, T_out> paillier, int bitsCompressed);
+
+
+	/**
+	 * \brief Method to decrypt an 8-bit PGM image with compression mod bitsCompressed
+	 * \details This method decrypts an 8-bit PGM image that was previously encrypted
+	 * using the encryptCompression method and performs decompression on the decrypted
+	 * image before writing it to a file.
+	 * \tparam T_in input integer type for Paillier cryptosystem.
+	 * \tparam T_out output integer type for Paillier cryptosystem.
+	 * \param s_file The image.
+	 * \param Paillier<T_in, T_out> paillier instance of the Paillier cryptosystem.
+	 * \param bitsCompressed An int representing how many bits to free.
+	 * \author Katia Auxilien
+	 * \date 27 June 2024 9:19:00
+	 */
+	template <typename T_in, typename T_out>
+	void decryptCompression_8bpp(string s_file, Paillier<T_in, T_out> paillier, int bitsCompressed);
+
+	/************** n > 8bits**************/
+
+	/**
+	 * \brief Encrypt an image with several pixels per ciphertext.
+	 * \details The pixels are packed in the slots of the plaintexts (see SlotPacking), so an
+	 * image of N pixels costs N / k encryptions and N·B / k bytes instead of N and N·B. The
+	 * ciphertexts are shared by the threads, each writes its ciphertexts in the output file.
+	 * \tparam T_in The input integer type, holding a packed plaintext.
+	 * \tparam T_out The output integer type.
+	 * \param string s_file - The image, NAME.pgm, the packed image is written to NAME_E.pgm.
+	 * \param bool recropPixels - True to expand the histogram before encryption.
+	 * \param Paillier<T_in, T_out> paillier - A Paillier object used for encryption.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	template <typename T_in, typename T_out>
+	void encryptPacked(string s_file, bool recropPixels, Paillier<T_in, T_out> paillier);
+
+	/**
+	 * \brief Decrypt a packed image of sums, written by the eval mode.
+	 * \details Each slot holds a sum up to layout.getMaxValue(), decrypted without the clamping
+	 * of the pixels (see SlotPacking::unpack). The sums are written as a 16-bit image of that
+	 * maximum value if it is at most 65535, and printed a row per line if it is larger or if the
+	 * image is a single sum.
+	 * \tparam T_in The input integer type, holding a plaintext.
+	 * \tparam T_out The output integer type.
+	 * \param const PgmView &imageIn - The packed image, mapped.
+	 * \param const SlotPacking &layout - Its layout, which holds sums.
+	 * \param const char *file - The 16-bit image of the sums.
+	 * \param Paillier<T_in, T_out> paillier - A Paillier object used for decryption.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	template <typename T_in, typename T_out>
+	void decryptSums(const PgmView &imageIn, const SlotPacking &layout, const char *file, Paillier<T_in, T_out> paillier);
+
+	/**
+	 * \brief Decrypt an image encrypted by encryptPacked.
+	 * \details The layout of the slots is read from the header of the image.
+	 * \tparam T_in The input integer type, holding a packed plaintext.
+	 * \tparam T_out The output integer type.
+	 * \param string s_file - The packed image, NAME.pgm, decrypted to NAME_D.pgm.
+	 * \param Paillier<T_in, T_out> paillier - A Paillier object used for decryption.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	template <typename T_in, typename T_out>
+	void decryptPacked(string s_file, Paillier<T_in, T_out> paillier);
+};
+
+template <typename T_in, typename T_out>
+void PaillierControllerPGM::processImageWith(string s_file, bool isEncryption, bool distributeOnTwo, bool recropPixels, bool optimisationLSB32, bool optimisationLSB16)
+{
+	Paillier<T_in, T_out> paillier;
+	/*********************** Chiffrement ***********************/
+
+	if (isEncryption)
+	{
+		// Taken once here, the copies of paillier of the threads and the next images share the table.
+		PaillierPublicKey publicKey = model->getInstance()->getPublicKey();
+		paillier.buildGmTable(publicKey.getN(), publicKey.getG());
+		if (!optimisationLSB32 && !optimisationLSB16)
+		{
+			this->encrypt(s_file, distributeOnTwo, recropPixels, paillier);
+		}
+		if (optimisationLSB32 && !distributeOnTwo)
+		{
+			this->encryptCompression_16bpp(s_file, recropPixels, paillier, 5);
+		}
+		if (optimisationLSB16 && !distributeOnTwo)
+		{
+			this->encryptCompression_16bpp(s_file, recropPixels, paillier, 4);
+		}
+		if (optimisationLSB32 && distributeOnTwo)
+		{
+			this->encryptCompression_8bpp(s_file, recropPixels, paillier, 5);
+		}
+		if (optimisationLSB16 && distributeOnTwo)
+		{
+			this->encryptCompression_8bpp(s_file, recropPixels, paillier, 4);
+		}
+	}
+	/*********************** Déchiffrement ***********************/
+	else
+	{
+		if (!optimisationLSB32 && !optimisationLSB16)
+		{
+			this->decrypt(s_file, distributeOnTwo, paillier);
+		}
+		if (optimisationLSB32 && !distributeOnTwo)
+		{
+			this->decryptCompression_16bpp(s_file, paillier, 5);
+		}
+		if (optimisationLSB16 && !distributeOnTwo)
+		{
+			this->decryptCompression_16bpp(s_file, paillier, 4);
+		}
+		if (optimisationLSB32 && distributeOnTwo)
+		{
+			this->decryptCompression_8bpp(s_file, paillier, 5);
+		}
+		if (optimisationLSB16 && distributeOnTwo)
+		{
+			this->decryptCompression_8bpp(s_file, paillier, 4);
+		}
+	}
+}
+
+/************** 8bits **************/
+
+template <typename T_in, typename T_out>
+void PaillierControllerPGM::encrypt(string s_file, bool distributeOnTwo, bool recropPixels, Paillier<T_in, T_out> paillier)
+{
+
+	char cNomImgLue[250];
+	strcpy(cNomImgLue, s_file.c_str());
+
+	string toErase = ".pgm";
+	size_t pos = s_file.find(".pgm");
+	s_file.erase(pos, toErase.length());
+	string s_fileNew = s_file + "_E.pgm";
+	char cNomImgEcriteEnc[250];
+	strcpy(cNomImgEcriteEnc, s_fileNew.c_str());
+
+	int nH, nW;
+	size_t nTaille;
+	uint64_t n = model->getInstance()->getPublicKey().getN();
+	uint64_t g = model->getInstance()->getPublicKey().getG();
+
+	PgmView imageIn;
+	checkMapping(imageIn.open(cNomImgLue, 1), cNomImgLue);
+	nH = imageIn.getHeight();
+	nW = imageIn.getWidth();
+	nTaille = (size_t)nH * nW;
+	const OCTET *ImgIn = imageIn.data();
+	size_t band = bandPixels(nTaille, nW);
+
+	// The encrypted pixels are written directly in the output file, created with its final size.
+	PgmView imageOut;
+	if (distributeOnTwo)
+	{
+		// T_in *ImgOutEnc;
+		checkMapping(imageOut.create(cNomImgEcriteEnc, nH, nW * 2, static_cast<uint8_t>(n), nTaille * 2), cNomImgEcriteEnc);
+		uint8_t *ImgOutEnc = imageOut.data();
+
+		// int bitsCompressed = 4;
+		// int mod = pow((double)2,(double)bitsCompressed);
+
+		forEachBand(nTaille, band, [&](size_t first, size_t last)
+		{ imageIn.prefetch(first, last - first); },
+		[&](size_t first, size_t last)
+		{
+			parallelPixels(first, last, [&](size_t begin, size_t end)
+			{
+				std::vector<uint8_t> pixels = histogramExpansion(ImgIn, begin, end, recropPixels);
+				PROFILE_STAGE(ENCRYPTION);
+				PROFILE_COUNT(PIXELS_ENCRYPTED, end - begin);
+				Paillier<T_in, T_out> paillierThread = paillier;
+				NoisePool &noise = NoisePool::threadInstance(n);
+				noise.expect(end - begin);
+				for (size_t i = begin; i < end; i++)
+				{
+					uint8_t pixel = pixels[i - begin];
+					uint16_t pixel_enc = paillierThread.paillierEncryptionWithNoise(n, g, pixel, noise.next());
+					splitPixel(pixel_enc, ImgOutEnc + 2 * i);
+				}
+			});
+		},
+		[&](size_t first, size_t last)
+		{
+			checkWriting(imageOut.flush(2 * first, 2 * (last - first)), cNomImgEcriteEnc);
+			imageIn.release(first, last - first);
+			imageOut.release(2 * first, 2 * (last - first));
+		});
+	}
+	else
+	{
+		checkMapping(imageOut.create(cNomImgEcriteEnc, nH, nW, static_cast<uint16_t>(n * n), nTaille * 2), cNomImgEcriteEnc);
+
+		forEachBand(nTaille, band, [&](size_t first, size_t last)
+		{ imageIn.prefetch(first, last - first); },
+		[&](size_t first, size_t last)
+		{
+			parallelPixels(first, last, [&](size_t begin, size_t end)
+			{
+				std::vector<uint8_t> pixels = histogramExpansion(ImgIn, begin, end, recropPixels);
+				PROFILE_STAGE(ENCRYPTION);
+				PROFILE_COUNT(PIXELS_ENCRYPTED, end - begin);
+				Paillier<T_in, T_out> paillierThread = paillier;
+				NoisePool &noise = NoisePool::threadInstance(n);
+				noise.expect(end - begin);
+				for (size_t i = begin; i < end; i++)
+				{
+					uint8_t pixel = pixels[i - begin];
+					uint16_t pixel_enc = paillierThread.paillierEncryptionWithNoise(n, g, pixel, noise.next());
+					imageOut.set<uint16_t>(i, pixel_enc);
+				}
+			});
+		},
+		[&](size_t first, size_t last)
+		{
+			checkWriting(imageOut.flush(2 * first, 2 * (last - first)), cNomImgEcriteEnc);
+			imageIn.release(first, last - first);
+			imageOut.release(2 * first, 2 * (last - first));
+		});
+	}
+}
+
+template <typename T_in, typename T_out>
+void PaillierControllerPGM::decrypt(string s_file, bool distributeOnTwo, Paillier<T_in, T_out> paillier)
+{
+	char cNomImgLue[250];
+	strcpy(cNomImgLue, s_file.c_str());
+
+	string toErase = ".pgm";
+	size_t pos = s_file.find(".pgm");
+	s_file.erase(pos, toErase.length());
+	string s_fileNew = s_file + "_D.pgm";
+	char cNomImgEcriteDec[250];
+	strcpy(cNomImgEcriteDec, s_fileNew.c_str());
+
+	int nH, nW;
+	size_t nTaille;
+	PaillierPrivateKey privateKey = model->getInstance()->getPrivateKey();
+
+	PgmView imageIn, imageOut;
+	checkMapping(imageIn.open(cNomImgLue, distributeOnTwo ? 1 : 2), cNomImgLue);
+	nH = imageIn.getHeight();
+	nW = imageIn.getWidth();
+
+	if (distributeOnTwo)
+	{
+		nTaille = (size_t)nH * (nW / 2);
+		const uint8_t *ImgIn = imageIn.data();
+		checkMapping(imageOut.create(cNomImgEcriteDec, nH, nW / 2, 255, nTaille), cNomImgEcriteDec);
+		OCTET *ImgOutDec = imageOut.data();
+
+		forEachBand(nTaille, bandPixels(nTaille, nW / 2), [&](size_t first, size_t last)
+		{ imageIn.prefetch(2 * first, 2 * (last - first)); },
+		[&](size_t first, size_t last)
+		{
+			parallelPixels(first, last, [&](size_t begin, size_t end)
+			{
+				PROFILE_STAGE(DECRYPTION);
+				PROFILE_COUNT(PIXELS_DECRYPTED, end - begin);
+				Paillier<T_in, T_out> paillierThread = paillier;
+				for (size_t i = begin; i < end; i++)
+				{
+					uint16_t pixel = mergePixel(ImgIn + 2 * i);
+					uint8_t c = decryptPixel(paillierThread, privateKey, pixel);
+					ImgOutDec[i] = static_cast<OCTET>(c);
+				}
+			});
+		},
+		[&](size_t first, size_t last)
+		{
+			checkWriting(imageOut.flush(first, last - first), cNomImgEcriteDec);
+			imageIn.release(2 * first, 2 * (last - first));
+			imageOut.release(first, last - first);
+		});
+	}
+	else
+	{
+		nTaille = (size_t)nH * nW;
+		checkMapping(imageOut.create(cNomImgEcriteDec, nH, nW, 255, nTaille), cNomImgEcriteDec);
+		OCTET *ImgOutDec = imageOut.data();
+
+		forEachBand(nTaille, bandPixels(nTaille, nW), [&](size_t first, size_t last)
+		{ imageIn.prefetch(2 * first, 2 * (last - first)); },
+		[&](size_t first, size_t last)
+		{
+			parallelPixels(first, last, [&](size_t begin, size_t end)
+			{
+				PROFILE_STAGE(DECRYPTION);
+				PROFILE_COUNT(PIXELS_DECRYPTED, end - begin);
+				Paillier<T_in, T_out> paillierThread = paillier;
+				for (size_t i = begin; i < end; i++)
+				{
+					uint16_t pixel = imageIn.get<uint16_t>(i);
+					uint8_t c = decryptPixel(paillierThread, privateKey, pixel);
+					ImgOutDec[i] = static_cast<OCTET>(c);
+				}
+			});
+		},
+		[&](size_t first, size_t last)
+		{
+			checkWriting(imageOut.flush(first, last - first), cNomImgEcriteDec);
+			imageIn.release(2 * first, 2 * (last - first));
+			imageOut.release(first, last - first);
+		});
+	}
+}
+
+template <typename T_in, typename T_out>
+void PaillierControllerPGM::encryptCompression_16bpp(string s_file, bool recropPixels, Paillier<T_in, T_out> paillier, int bitsCompressed)
+{
+
+	char cNomImgLue[250];
+	strcpy(cNomImgLue, s_file.c_str());
+
+	string toErase = ".pgm";
+	size_t pos = s_file.find(".pgm");
+	s_file.erase(pos, toErase.length());
+	string s_fileNew = s_file + "_E.pgm";
+	char cNomImgEcriteEnc[250];
+	strcpy(cNomImgEcriteEnc, s_fileNew.c_str());
+
+	int nH, nW; // TODO : Change nH nW to uint16_t
+	size_t nTaille;
+	uint64_t n = model->getInstance()->getPublicKey().getN();
+	uint64_t g = model->getInstance()->getPublicKey().getG();
+
+	PgmView imageIn;
+	checkMapping(imageIn.open(cNomImgLue, 1), cNomImgLue);
+	nH = imageIn.getHeight();
+	nW = imageIn.getWidth();
+	const OCTET *ImgIn = imageIn.data();
+
+	nTaille = (size_t)nH * nW;
+
+	size_t nbPixelsComp = BitPacker::packedSize<uint16_t>(nTaille, bitsCompressed);
+
+	pair<int, int> dimensionComp = compressedDimension(nbPixelsComp, cNomImgEcriteEnc);
+	int nHComp = dimensionComp.first;
+	int nWComp = dimensionComp.second;
+
+	// The bits are packed directly in the output file, created with its final size. A band
+	// is a multiple of 64 pixels, so its packed bits start on a 64-bit word of the stream.
+	PgmView imageOut;
+	checkMapping(imageOut.create(cNomImgEcriteEnc, nHComp, nWComp, static_cast<uint16_t>(n * n), nbPixelsComp * 2, nH, nW), cNomImgEcriteEnc);
+	size_t band = bandPixels(nTaille, nW, 64);
+	size_t bitsPerPixel = 16 - bitsCompressed;
+
+	// A vector, the buffer is freed when a band fails and the daemon goes on.
+	std::vector<uint16_t> ImgOutEnc(band);
+
+	// The ciphertexts with bitsCompressed zero LSB are drawn from a table when n² is small
+	// enough, otherwise the pixel is encrypted again until its ciphertext fits.
+	const ZeroLsbTable *zeroLsbTable = getZeroLsbTable(bitsCompressed);
+	bool useTable = zeroLsbTable != NULL;
+	std::atomic<int> missingPixel(-1);
+
+	// Bytes of the compressed image holding the packed bits of the pixels [first, last).
+	auto packedRange = [&](size_t first, size_t last)
+	{
+		size_t offset = first * bitsPerPixel / 8;
+		return std::make_pair(offset, last < nTaille ? (last - first) * bitsPerPixel / 8 : 2 * nbPixelsComp - offset);
+	};
+
+	int mod = pow((double)2,(double)bitsCompressed);
+	forEachBand(nTaille, band, [&](size_t first, size_t last)
+	{ imageIn.prefetch(first, last - first); },
+	[&](size_t first, size_t last)
+	{
+		parallelPixels(first, last, [&](size_t begin, size_t end)
+		{
+			std::vector<uint8_t> pixels = histogramExpansion(ImgIn, begin, end, recropPixels);
+			PROFILE_STAGE(ENCRYPTION);
+			PROFILE_COUNT(PIXELS_ENCRYPTED, end - begin);
+			uint64_t reencryptions = 0;
+			Paillier<T_in, T_out> paillierThread = paillier;
+			for (size_t i = begin; i < end; i++)
+			{
+				uint8_t pixel = pixels[i - begin];
+				uint16_t pixel_enc;
+				if (useTable)
+				{
+					uint64_t m = pixel % n;
+					if (zeroLsbTable->count(m) == 0)
+					{
+						missingPixel = m;
+						continue;
+					}
+					pixel_enc = zeroLsbTable->encrypt(m);
+				}
+				else
+				{
+					pixel_enc = paillierThread.paillierEncryption(n, g, pixel);
+					while (pixel_enc % mod != 0)
+					{
+						pixel_enc = paillierThread.paillierEncryption(n, g, pixel);
+						reencryptions++;
+					}
+				}
+
+				ImgOutEnc[i - first] = pixel_enc;
+			}
+			PROFILE_COUNT(REENCRYPTIONS, reencryptions);
+		});
+
+		pair<size_t, size_t> range = packedRange(first, last);
+		compressBits_16bpp(ImgOutEnc.data(), last - first, bitsCompressed, imageOut.data() + range.first, range.second / 2);
+	},
+	[&](size_t first, size_t last)
+	{
+		pair<size_t, size_t> range = packedRange(first, last);
+		checkWriting(imageOut.flush(range.first, range.second), cNomImgEcriteEnc);
+		imageIn.release(first, last - first);
+		imageOut.release(range.first, range.second);
+	});
+
+	if (missingPixel >= 0)
+	{
+		remove(cNomImgEcriteEnc);
+		failImage("No ciphertext of the pixel value " + to_string(missingPixel) + " has its " + to_string(bitsCompressed) + " LSB at 0 with this key, please retry with another key.\n");
+	}
+}
+
+template <typename T_in, typename T_out>
+void PaillierControllerPGM::decryptCompression_16bpp(string s_file, Paillier<T_in, T_out> paillier, int bitsCompressed)
+{
+	char cNomImgLue[250];
+	strcpy(cNomImgLue, s_file.c_str());
+
+	string toErase = ".pgm";
+	size_t pos = s_file.find(".pgm");
+	s_file.erase(pos, toErase.length());
+	string s_fileNew = s_file + "_D.pgm";
+	char cNomImgEcriteDec[250];
+	strcpy(cNomImgEcriteDec, s_fileNew.c_str());
+
+	int nH, nW, nHComp, nWComp;
+	size_t nTaille;
+	PaillierPrivateKey privateKey = model->getInstance()->getPrivateKey();
+
+	PgmView imageIn;
+	checkMapping(imageIn.open(cNomImgLue, 2, true), cNomImgLue);
+	nHComp = imageIn.getHeight();
+	nWComp = imageIn.getWidth();
+	const uint8_t *ImgInComp = imageIn.data();
+	size_t sizeComp = (size_t)nHComp * nWComp * 2;
+
+	nH = imageIn.getOriginalHeight();
+	nW = imageIn.getOriginalWidth();
+	nTaille = (size_t)nH * nW;
+
+	PgmView imageOut;
+	checkMapping(imageOut.create(cNomImgEcriteDec, nH, nW, 255, nTaille), cNomImgEcriteDec);
+	OCTET *ImgOutDec = imageOut.data();
+
+	// A band is a multiple of 64 pixels, so its packed bits start on a 64-bit word of the stream.
+	size_t band = bandPixels(nTaille, nW, 64);
+	size_t bitsPerPixel = 16 - bitsCompressed;
+	std::vector<uint16_t> ImgInEnc(band);
+
+	// Bytes of the compressed image holding the packed bits of the pixels [first, last).
+	auto packedRange = [&](size_t first, size_t last)
+	{
+		size_t offset = std::min(first * bitsPerPixel / 8, sizeComp);
+		return std::make_pair(offset, std::min((last - first) * bitsPerPixel / 8, sizeComp - offset));
+	};
+
+	forEachBand(nTaille, band, [&](size_t first, size_t last)
+	{
+		pair<size_t, size_t> range = packedRange(first, last);
+		imageIn.prefetch(range.first, range.second);
+	},
+	[&](size_t first, size_t last)
+	{
+		size_t offset = packedRange(first, last).first;
+		decompressBits_16bpp(ImgInComp + offset, (sizeComp - offset) / 2, bitsCompressed, ImgInEnc.data(), last - first);
+
+		parallelPixels(first, last, [&](size_t begin, size_t end)
+		{
+			PROFILE_STAGE(DECRYPTION);
+			PROFILE_COUNT(PIXELS_DECRYPTED, end - begin);
+			Paillier<T_in, T_out> paillierThread = paillier;
+			for (size_t i = begin; i < end; i++)
+			{
+				uint16_t pixel = ImgInEnc[i - first];
+				uint8_t c = decryptPixel(paillierThread, privateKey, pixel);
+				ImgOutDec[i] = static_cast<OCTET>(c);
+			}
+		});
+	},
+	[&](size_t first, size_t last)
+	{
+		pair<size_t, size_t> range = packedRange(first, last);
+		checkWriting(imageOut.flush(first, last - first), cNomImgEcriteDec);
+		imageIn.release(range.first, range.second);
+		imageOut.release(first, last - first);
+	});
+}
+
+template <typename T_in, typename T_out>
+void PaillierControllerPGM::encryptCompression_8bpp(string s_file, bool recropPixels, Paillier<T_in, T_out> paillier, int bitsCompressed)
+{
+
+	char cNomImgLue[250];
+	strcpy(cNomImgLue, s_file.c_str());
+
+	string toErase = ".pgm";
+	size_t pos = s_file.find(".pgm");
+	s_file.erase(pos, toErase.length());
+	string s_fileNew = s_file + "_E.pgm";
+	char cNomImgEcriteEnc[250];
+	strcpy(cNomImgEcriteEnc, s_fileNew.c_str());
+
+	int nH, nW; // TODO : Change nH nW to uint16_t
+	size_t nTaille;
+	uint64_t n = model->getInstance()->getPublicKey().getN();
+	uint64_t g = model->getInstance()->getPublicKey().getG();
+
+	PgmView imageIn;
+	checkMapping(imageIn.open(cNomImgLue, 1), cNomImgLue);
+	nH = imageIn.getHeight();
+	nW = imageIn.getWidth();
+	const OCTET *ImgIn = imageIn.data();
+
+	nTaille = (size_t)nH * nW;
+
+	size_t nbPixelsComp = BitPacker::packedSize<uint16_t>(nTaille, bitsCompressed);
+
+	nbPixelsComp = nbPixelsComp * 2;
+	pair<int, int> dimensionComp = compressedDimension(nbPixelsComp, cNomImgEcriteEnc);
+	int nHComp = dimensionComp.first;
+	int nWComp = dimensionComp.second;
+
+	// The bits are packed directly in the output file, created with its final size. A band
+	// is a multiple of 64 pixels, so its packed bits start on a 64-bit word of the stream.
+	PgmView imageOut;
+	checkMapping(imageOut.create(cNomImgEcriteEnc, nHComp, nWComp, 255, nbPixelsComp, nH, nW), cNomImgEcriteEnc);
+	size_t band = bandPixels(nTaille, nW, 64);
+	size_t bitsPerPixel = 16 - bitsCompressed;
+
+	// A vector, the buffer is freed when a band fails and the daemon goes on.
+	std::vector<uint16_t> ImgOutEnc(band);
+
+	// The ciphertexts with bitsCompressed zero LSB are drawn from a table when n² is small
+	// enough, otherwise the pixel is encrypted again until its ciphertext fits.
+	const ZeroLsbTable *zeroLsbTable = getZeroLsbTable(bitsCompressed);
+	bool useTable = zeroLsbTable != NULL;
+	std::atomic<int> missingPixel(-1);
+
+	// Bytes of the compressed image holding the packed bits of the pixels [first, last).
+	auto packedRange = [&](size_t first, size_t last)
+	{
+		size_t offset = first * bitsPerPixel / 8;
+		return std::make_pair(offset, last < nTaille ? (last - first) * bitsPerPixel / 8 : nbPixelsComp - offset);
+	};
+
+	int mod = pow((double)2,(double)bitsCompressed);
+	forEachBand(nTaille, band, [&](size_t first, size_t last)
+	{ imageIn.prefetch(first, last - first); },
+	[&](size_t first, size_t last)
+	{
+		parallelPixels(first, last, [&](size_t begin, size_t end)
+		{
+			std::vector<uint8_t> pixels = histogramExpansion(ImgIn, begin, end, recropPixels);
+			PROFILE_STAGE(ENCRYPTION);
+			PROFILE_COUNT(PIXELS_ENCRYPTED, end - begin);
+			uint64_t reencryptions = 0;
+			Paillier<T_in, T_out> paillierThread = paillier;
+			for (size_t i = begin; i < end; i++)
+			{
+				uint8_t pixel = pixels[i - begin];
+				uint16_t pixel_enc;
+				if (useTable)
+				{
+					uint64_t m = pixel % n;
+					if (zeroLsbTable->count(m) == 0)
+					{
+						missingPixel = m;
+						continue;
+					}
+					pixel_enc = zeroLsbTable->encrypt(m);
+				}
+				else
+				{
+					pixel_enc = paillierThread.paillierEncryption(n, g, pixel);
+					while (pixel_enc % mod != 0)
+					{
+						pixel_enc = paillierThread.paillierEncryption(n, g, pixel);
+						reencryptions++;
+					}
+				}
+
+				ImgOutEnc[i - first] = pixel_enc;
+			}
+			PROFILE_COUNT(REENCRYPTIONS, reencryptions);
+		});
+
+		pair<size_t, size_t> range = packedRange(first, last);
+		compressBits_8bpp(ImgOutEnc.data(), last - first, bitsCompressed, imageOut.data() + range.first, range.second);
+	},
+	[&](size_t first, size_t last)
+	{
+		pair<size_t, size_t> range = packedRange(first, last);
+		checkWriting(imageOut.flush(range.first, range.second), cNomImgEcriteEnc);
+		imageIn.release(first, last - first);
+		imageOut.release(range.first, range.second);
+	});
+
+	if (missingPixel >= 0)
+	{
+		remove(cNomImgEcriteEnc);
+		failImage("No ciphertext of the pixel value " + to_string(missingPixel) + " has its " + to_string(bitsCompressed) + " LSB at 0 with this key, please retry with another key.\n");
+	}
+}
+
+template <typename T_in, typename T_out>
+void PaillierControllerPGM::decryptCompression_8bpp(string s_file, Paillier<T_in, T_out> paillier, int bitsCompressed)
+{
+	char cNomImgLue[250];
+	strcpy(cNomImgLue, s_file.c_str());
+
+	string toErase = ".pgm";
+	size_t pos = s_file.find(".pgm");
+	s_file.erase(pos, toErase.length());
+	string s_fileNew = s_file + "_D.pgm";
+	char cNomImgEcriteDec[250];
+	strcpy(cNomImgEcriteDec, s_fileNew.c_str());
+
+	int nH, nW, nHComp, nWComp;
+	size_t nTaille;
+	PaillierPrivateKey privateKey = model->getInstance()->getPrivateKey();
+
+	PgmView imageIn;
+	checkMapping(imageIn.open(cNomImgLue, 1, true), cNomImgLue);
+	nHComp = imageIn.getHeight();
+	nWComp = imageIn.getWidth();
+	const uint8_t *ImgInComp = imageIn.data();
+	size_t sizeComp = (size_t)nHComp * nWComp * 1;
+
+	nH = imageIn.getOriginalHeight();
+	nW = imageIn.getOriginalWidth();
+	nTaille = (size_t)nH * nW;
+
+	PgmView imageOut;
+	checkMapping(imageOut.create(cNomImgEcriteDec, nH, nW, 255, nTaille), cNomImgEcriteDec);
+	OCTET *ImgOutDec = imageOut.data();
+
+	// A band is a multiple of 64 pixels, so its packed bits start on a 64-bit word of the stream.
+	size_t band = bandPixels(nTaille, nW, 64);
+	size_t bitsPerPixel = 16 - bitsCompressed;
+	std::vector<uint16_t> ImgInEnc(band);
+
+	// Bytes of the compressed image holding the packed bits of the pixels [first, last).
+	auto packedRange = [&](size_t first, size_t last)
+	{
+		size_t offset = std::min(first * bitsPerPixel / 8, sizeComp);
+		return std::make_pair(offset, std::min((last - first) * bitsPerPixel / 8, sizeComp - offset));
+	};
+
+	forEachBand(nTaille, band, [&](size_t first, size_t last)
+	{
+		pair<size_t, size_t> range = packedRange(first, last);
+		imageIn.prefetch(range.first, range.second);
+	},
+	[&](size_t first, size_t last)
+	{
+		size_t offset = packedRange(first, last).first;
+		decompressBits_8bpp(ImgInComp + offset, sizeComp - offset, bitsCompressed, ImgInEnc.data(), last - first);
+
+		parallelPixels(first, last, [&](size_t begin, size_t end)
+		{
+			PROFILE_STAGE(DECRYPTION);
+			PROFILE_COUNT(PIXELS_DECRYPTED, end - begin);
+			Paillier<T_in, T_out> paillierThread = paillier;
+			for (size_t i = begin; i < end; i++)
+			{
+				uint16_t pixel = ImgInEnc[i - first];
+				uint8_t c = decryptPixel(paillierThread, privateKey, pixel);
+				ImgOutDec[i] = static_cast<OCTET>(c);
+			}
+		});
+	},
+	[&](size_t first, size_t last)
+	{
+		pair<size_t, size_t> range = packedRange(first, last);
+		checkWriting(imageOut.flush(first, last - first), cNomImgEcriteDec);
+		imageIn.release(range.first, range.second);
+		imageOut.release(first, last - first);
+	});
+}
+
+template <typename T_in, typename T_out>
+void PaillierControllerPGM::processPackedImageWith(string s_file, bool isEncryption, bool distributeOnTwo, bool recropPixels, bool optimisationLSB32, bool optimisationLSB16)
+{
+	(void)distributeOnTwo;
+	(void)optimisationLSB32;
+	(void)optimisationLSB16;
+	Paillier<T_in, T_out> paillier;
+	if (isEncryption)
+	{
+		// Taken once here, the copies of paillier of the threads and the next images share the table.
+		PaillierPublicKey publicKey = model->getInstance()->getPublicKey();
+		paillier.buildGmTable(publicKey.getN(), publicKey.getG());
+		this->encryptPacked(s_file, recropPixels, paillier);
+	}
+	else
+	{
+		this->decryptPacked(s_file, paillier);
+	}
+}
+
+/************** n > 8bits **************/
+
+template <typename T_in, typename T_out>
+void PaillierControllerPGM::encryptPacked(string s_file, bool recropPixels, Paillier<T_in, T_out> paillier)
+{
+	char cNomImgLue[250];
+	strcpy(cNomImgLue, s_file.c_str());
+
+	string toErase = ".pgm";
+	size_t pos = s_file.find(".pgm");
+	s_file.erase(pos, toErase.length());
+	string s_fileNew = s_file + "_E.pgm";
+	char cNomImgEcriteEnc[250];
+	strcpy(cNomImgEcriteEnc, s_fileNew.c_str());
+
+	int nH, nW;
+	uint64_t n = model->getInstance()->getPublicKey().getN();
+	uint64_t g = model->getInstance()->getPublicKey().getG();
+
+	PgmView imageIn;
+	checkMapping(imageIn.open(cNomImgLue, 1), cNomImgLue);
+	nH = imageIn.getHeight();
+	nW = imageIn.getWidth();
+	const OCTET *ImgIn = imageIn.data();
+
+	SlotPacking layout;
+	if (!SlotPacking::forKey(n, this->packGuardBits, nW, layout))
+	{
+		failImage("Error ! n is too small to pack pixels with " + std::to_string(this->packGuardBits) + " guard bits, it needs at least " + std::to_string(SlotPacking::PIXEL_BITS + this->packGuardBits + 1) + " bits.\n");
+	}
+	int cipherBytes = layout.getCipherBytes();
+	size_t nbCiphers = layout.groupsPerRow() * nH;
+
+	PgmView imageOut;
+	checkMapping(imageOut.create(cNomImgEcriteEnc, nH, layout.groupsPerRow() * cipherBytes, 255, nbCiphers * cipherBytes, 0, 0, 1, layout.toComment()), cNomImgEcriteEnc);
+	uint8_t *ImgOutEnc = imageOut.data();
+
+	parallelPixels(nbCiphers, [&](size_t begin, size_t end)
+	{
+		size_t first = layout.firstPixel(begin), last = layout.firstPixel(end);
+		std::vector<uint8_t> pixels = histogramExpansion(ImgIn, first, last, recropPixels);
+		PROFILE_STAGE(ENCRYPTION);
+		PROFILE_COUNT(PIXELS_ENCRYPTED, last - first);
+		Paillier<T_in, T_out> paillierThread = paillier;
+		NoisePool &noise = NoisePool::threadInstance(n);
+		noise.expect(end - begin);
+		size_t pixel = first;
+		for (size_t i = begin; i < end; i++)
+		{
+			size_t next = layout.firstPixel(i + 1);
+			T_in m = static_cast<T_in>(layout.pack(pixels.data() + (pixel - first), next - pixel));
+			layout.store(paillierThread.paillierEncryptionWithNoise(n, g, m, noise.next()), ImgOutEnc + i * cipherBytes);
+			pixel = next;
+		}
+	});
+}
+
+template <typename T_in, typename T_out>
+void PaillierControllerPGM::decryptPacked(string s_file, Paillier<T_in, T_out> paillier)
+{
+	char cNomImgLue[250];
+	strcpy(cNomImgLue, s_file.c_str());
+
+	string toErase = ".pgm";
+	size_t pos = s_file.find(".pgm");
+	s_file.erase(pos, toErase.length());
+	string s_fileNew = s_file + "_D.pgm";
+	char cNomImgEcriteDec[250];
+	strcpy(cNomImgEcriteDec, s_fileNew.c_str());
+
+	int nH, nW;
+	size_t nTaille;
+	PaillierPrivateKey privateKey = model->getInstance()->getPrivateKey();
+
+	PgmView imageIn;
+	checkMapping(imageIn.open(cNomImgLue, 1), cNomImgLue);
+	SlotPacking layout;
+	if (!SlotPacking::fromComment(imageIn.getComment(), privateKey.getN(), layout) || (size_t)imageIn.getWidth() != layout.groupsPerRow() * layout.getCipherBytes())
+	{
+		failImage("Error ! " + string(cNomImgLue) + " is not an image packed with this key.\n");
+	}
+	nH = imageIn.getHeight();
+	nW = layout.getWidth();
+	nTaille = (size_t)nH * nW;
+	int cipherBytes = layout.getCipherBytes();
+	size_t nbCiphers = layout.groupsPerRow() * nH;
+	const uint8_t *ImgIn = imageIn.data();
+
+	if (layout.holdsSums())
+	{
+		this->decryptSums(imageIn, layout, cNomImgEcriteDec, paillier);
+		return;
+	}
+
+	PgmView imageOut;
+	checkMapping(imageOut.create(cNomImgEcriteDec, nH, nW, 255, nTaille), cNomImgEcriteDec);
+	OCTET *ImgOutDec = imageOut.data();
+
+	parallelPixels(nbCiphers, [&](size_t begin, size_t end)
+	{
+		PROFILE_STAGE(DECRYPTION);
+		PROFILE_COUNT(PIXELS_DECRYPTED, layout.firstPixel(end) - layout.firstPixel(begin));
+		Paillier<T_in, T_out> paillierThread = paillier;
+		size_t pixel = layout.firstPixel(begin);
+		for (size_t i = begin; i < end; i++)
+		{
+			size_t next = layout.firstPixel(i + 1);
+			T_out c = static_cast<T_out>(layout.load(ImgIn + i * cipherBytes));
+			layout.unpack(decryptPixel(paillierThread, privateKey, c), ImgOutDec + pixel, next - pixel);
+			pixel = next;
+		}
+	});
+}
+
+template <typename T_in, typename T_out>
+void PaillierControllerPGM::decryptSums(const PgmView &imageIn, const SlotPacking &layout, const char *file, Paillier<T_in, T_out> paillier)
+{
+	PaillierPrivateKey privateKey = model->getInstance()->getPrivateKey();
+	int nH = imageIn.getHeight(), nW = layout.getWidth();
+	size_t nTaille = (size_t)nH * nW;
+	int cipherBytes = layout.getCipherBytes();
+	const uint8_t *ImgIn = imageIn.data();
+
+	std::vector<uint64_t> sums(nTaille);
+	parallelPixels(layout.groupsPerRow() * nH, [&](size_t begin, size_t end)
+	{
+		PROFILE_STAGE(DECRYPTION);
+		PROFILE_COUNT(PIXELS_DECRYPTED, layout.firstPixel(end) - layout.firstPixel(begin));
+		Paillier<T_in, T_out> paillierThread = paillier;
+		size_t pixel = layout.firstPixel(begin);
+		for (size_t i = begin; i < end; i++)
+		{
+			size_t next = layout.firstPixel(i + 1);
+			T_out c = static_cast<T_out>(layout.load(ImgIn + i * cipherBytes));
+			layout.unpack(decryptPixel(paillierThread, privateKey, c), sums.data() + pixel, next - pixel);
+			pixel = next;
+		}
+	});
+
+	if (layout.getMaxValue() <= 65535)
+	{
+		PgmView imageOut;
+		checkMapping(imageOut.create(file, nH, nW, layout.getMaxValue(), 2 * nTaille), file);
+		for (size_t i = 0; i < nTaille; i++)
+		{
+			imageOut.set<uint16_t>(i, static_cast<uint16_t>(sums[i]));
+		}
+	}
+	if (layout.getMaxValue() > 65535 || nTaille == 1)
+	{
+		// The sums larger than the samples of a PGM image are only printed.
+		for (int row = 0; row < nH; row++)
+		{
+			for (int col = 0; col < nW; col++)
+			{
+				printf(col == 0 ? "%" PRIu64 : " %" PRIu64, sums[(size_t)row * nW + col]);
+			}
+			printf("\n");
+		}
+	}
+}
+
 #endif // PAILLIERCONTROLLER_PGM
\ No newline at end of file
@@ -0,0 +1,282 @@
+/**
+ * \file PaillierControllerPPM.hpp
+ * \brief Header file for the PaillierControllerPPM class, which is a
+ * controller for the Paillier cryptosystem applied to PPM (Portable Pixmap)
+ * colour images.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ * \details A colour image is split into its R, G and B planes, which are encrypted as one
+ * greyscale image of three times the height : the encrypted image is a three-plane
+ * container, a PGM file whose rows are those of the R plane, then of the G plane, then of
+ * the B plane, each pixel encrypted as by PaillierControllerPGM::encrypt (16 bits, or two
+ * 8-bit pixels with -d). Its decryption merges the planes back into a PPM file.
+ */
+
+#ifndef PAILLIERCONTROLLER_PPM
+#define PAILLIERCONTROLLER_PPM
+
+#include "PaillierControllerPGM.hpp"
+#include "../../include/model/image/RgbPlanes.hpp"
+
+/**
+ * \class PaillierControllerPPM
+ * \brief Controller for the Paillier cryptosystem applied to PPM images.
+ * \details The command line, the keys, the threads and the decryption table are those of
+ * PaillierControllerPGM, only the images differ.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ */
+class PaillierControllerPPM : public PaillierControllerPGM
+{
+private:
+	/**
+	 * \brief Processing of a colour image with a Paillier instantiation, see processImageWith.
+	 */
+	typedef void (PaillierControllerPPM::*ColourKernel)(string, bool, bool, bool);
+
+	/**
+	 * \struct ColourKernelEntry
+	 * \brief Entry of the dispatch table of the colour image kernels.
+	 */
+	struct ColourKernelEntry
+	{
+		bool (*supportsKey)(uint64_t n); /*!< True if the instantiation holds the plaintexts and the ciphertexts of n. */
+		ColourKernel kernel;            /*!< The processing of a colour image with the instantiation. */
+	};
+
+	static const ColourKernelEntry COLOUR_KERNELS[]; /*!< Instantiations of the colour image kernels, narrowest ciphertexts first. */
+
+	/**
+	 * \brief Encrypt or decrypt a colour image with the Paillier instantiation chosen for the key.
+	 * \tparam T_in The input integer type.
+	 * \tparam T_out The output integer type.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	template <typename T_in, typename T_out>
+	void processImageWith(string s_file, bool isEncryption, bool distributeOnTwo, bool recropPixels);
+
+	/**
+	 * \brief Encrypt a PPM image into a three-plane container.
+	 * \details The planes are split from the interleaved pixels in a single pass, then the
+	 * 3 × nH × nW samples are encrypted by the thread pool, so the three planes are encrypted
+	 * concurrently and each thread writes a contiguous range of the container.
+	 * \tparam T_in The input integer type.
+	 * \tparam T_out The output integer type.
+	 * \param string s_file - The image, NAME.ppm, the container is written to NAME_E.pgm.
+	 * \param bool distributeOnTwo - True to split the encrypted pixels on two bytes.
+	 * \param bool recropPixels - True to expand the histogram of each plane before encryption.
+	 * \param Paillier<T_in, T_out> paillier - A Paillier object used for encryption.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	template <typename T_in, typename T_out>
+	void encrypt(string s_file, bool distributeOnTwo, bool recropPixels, Paillier<T_in, T_out> paillier);
+
+	/**
+	 * \brief Decrypt a three-plane container into a PPM image.
+	 * \details The samples of the three planes are decrypted concurrently, then the planes
+	 * are merged into interleaved pixels in a single pass.
+	 * \tparam T_in The input integer type.
+	 * \tparam T_out The output integer type.
+	 * \param string s_file - The container, NAME_E.pgm, the image is written to NAME_E_D.ppm.
+	 * \param bool distributeOnTwo - True if the encrypted pixels are split on two bytes.
+	 * \param Paillier<T_in, T_out> paillier - A Paillier object used for decryption.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	template <typename T_in, typename T_out>
+	void decrypt(string s_file, bool distributeOnTwo, Paillier<T_in, T_out> paillier);
+
+protected:
+	/**
+	 * \brief Extension of the images given on the command line.
+	 * \param bool isEncryption - True for the images to encrypt, false for the containers.
+	 * \return string - ".ppm" to encrypt, ".pgm" to decrypt.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	string imageExtension(bool isEncryption) const override;
+
+	/**
+	 * \brief Largest n, in bits, that the colour kernels support for every key of that size.
+	 * \param bool packed - Ignored, the colour images are not packed.
+	 * \return unsigned - The number of bits.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	unsigned maxImageKeyBits(bool packed) const override;
+
+public:
+	/**
+	 * \brief Default constructor.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	PaillierControllerPPM();
+
+	/**
+	 * \brief Destructor.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	~PaillierControllerPPM();
+
+	/**
+	 * \brief Print the man page message.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void printHelp();
+
+	/**
+	 * \brief Encrypt or decrypt a colour image with the options of the command line.
+	 * \param string s_file - The image to encrypt (.ppm) or the container to decrypt (_E.pgm).
+	 * \param bool isEncryption - True to encrypt, false to decrypt.
+	 * \param bool distributeOnTwo - True to split the encrypted pixels on two bytes.
+	 * \param bool recropPixels - True to expand the histogram before encryption.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void processImage(string s_file, bool isEncryption, bool distributeOnTwo, bool recropPixels);
+};
+
+template <typename T_in, typename T_out>
+void PaillierControllerPPM::processImageWith(string s_file, bool isEncryption, bool distributeOnTwo, bool recropPixels)
+{
+	Paillier<T_in, T_out> paillier;
+	if (isEncryption)
+	{
+		// Taken once here, the copies of paillier of the threads and the next images share the table.
+		PaillierPublicKey publicKey = model->getInstance()->getPublicKey();
+		paillier.buildGmTable(publicKey.getN(), publicKey.getG());
+		this->encrypt(s_file, distributeOnTwo, recropPixels, paillier);
+	}
+	else
+	{
+		this->decrypt(s_file, distributeOnTwo, paillier);
+	}
+}
+
+template <typename T_in, typename T_out>
+void PaillierControllerPPM::encrypt(string s_file, bool distributeOnTwo, bool recropPixels, Paillier<T_in, T_out> paillier)
+{
+	char cNomImgLue[250];
+	strcpy(cNomImgLue, s_file.c_str());
+
+	string toErase = ".ppm";
+	size_t pos = s_file.find(".ppm");
+	s_file.erase(pos, toErase.length());
+	string s_fileNew = s_file + "_E.pgm";
+	char cNomImgEcriteEnc[250];
+	strcpy(cNomImgEcriteEnc, s_fileNew.c_str());
+
+	int nH, nW;
+	size_t nTaille;
+	uint64_t n = model->getInstance()->getPublicKey().getN();
+	uint64_t g = model->getInstance()->getPublicKey().getG();
+
+	PgmView imageIn;
+	checkMapping(imageIn.open(cNomImgLue, 1, false, 3), cNomImgLue);
+	nH = imageIn.getHeight();
+	nW = imageIn.getWidth();
+	nTaille = (size_t)nH * nW;
+	const OCTET *ImgIn = imageIn.data();
+
+	// The three planes follow each other, sample c of pixel i is ImgPlanes[c * nTaille + i].
+	std::vector<OCTET> ImgPlanes(3 * nTaille);
+	OCTET *planeR = ImgPlanes.data(), *planeV = planeR + nTaille, *planeB = planeV + nTaille;
+	parallelPixels(nTaille, [&](size_t begin, size_t end)
+	{
+		PROFILE_STAGE(PLANES);
+		RgbPlanes::deinterleave(ImgIn + 3 * begin, end - begin, planeR + begin, planeV + begin, planeB + begin);
+	});
+
+	// The container is written directly in the output file, created with its final size.
+	PgmView imageOut;
+	if (distributeOnTwo)
+	{
+		checkMapping(imageOut.create(cNomImgEcriteEnc, 3 * nH, nW * 2, static_cast<uint8_t>(n), 3 * nTaille * 2), cNomImgEcriteEnc);
+	}
+	else
+	{
+		checkMapping(imageOut.create(cNomImgEcriteEnc, 3 * nH, nW, static_cast<uint16_t>(n * n), 3 * nTaille * 2), cNomImgEcriteEnc);
+	}
+	uint8_t *ImgOutEnc = imageOut.data();
+
+	parallelPixels(3 * nTaille, [&](size_t begin, size_t end)
+	{
+		std::vector<uint8_t> pixels = histogramExpansion(ImgPlanes.data(), begin, end, recropPixels);
+		PROFILE_STAGE(ENCRYPTION);
+		PROFILE_COUNT(PIXELS_ENCRYPTED, end - begin);
+		Paillier<T_in, T_out> paillierThread = paillier;
+		NoisePool &noise = NoisePool::threadInstance(n);
+		noise.expect(end - begin);
+		for (size_t i = begin; i < end; i++)
+		{
+			uint16_t pixel_enc = paillierThread.paillierEncryptionWithNoise(n, g, pixels[i - begin], noise.next());
+			if (distributeOnTwo)
+			{
+				splitPixel(pixel_enc, ImgOutEnc + 2 * i);
+			}
+			else
+			{
+				imageOut.set<uint16_t>(i, pixel_enc);
+			}
+		}
+	});
+}
+
+template <typename T_in, typename T_out>
+void PaillierControllerPPM::decrypt(string s_file, bool distributeOnTwo, Paillier<T_in, T_out> paillier)
+{
+	char cNomImgLue[250];
+	strcpy(cNomImgLue, s_file.c_str());
+
+	string toErase = ".pgm";
+	size_t pos = s_file.find(".pgm");
+	s_file.erase(pos, toErase.length());
+	string s_fileNew = s_file + "_D.ppm";
+	char cNomImgEcriteDec[250];
+	strcpy(cNomImgEcriteDec, s_fileNew.c_str());
+
+	int nH, nW;
+	size_t nTaille;
+	PaillierPrivateKey privateKey = model->getInstance()->getPrivateKey();
+
+	PgmView imageIn;
+	checkMapping(imageIn.open(cNomImgLue, distributeOnTwo ? 1 : 2), cNomImgLue);
+	if (imageIn.getHeight() % 3 != 0 || (distributeOnTwo && imageIn.getWidth() % 2 != 0))
+	{
+		failImage("Error ! " + string(cNomImgLue) + " is not a three-plane container, its height must be a multiple of 3.\n");
+	}
+	nH = imageIn.getHeight() / 3;
+	nW = distributeOnTwo ? imageIn.getWidth() / 2 : imageIn.getWidth();
+	nTaille = (size_t)nH * nW;
+	const uint8_t *ImgIn = imageIn.data();
+
+	std::vector<OCTET> ImgPlanes(3 * nTaille);
+	parallelPixels(3 * nTaille, [&](size_t begin, size_t end)
+	{
+		PROFILE_STAGE(DECRYPTION);
+		PROFILE_COUNT(PIXELS_DECRYPTED, end - begin);
+		Paillier<T_in, T_out> paillierThread = paillier;
+		for (size_t i = begin; i < end; i++)
+		{
+			uint16_t pixel = distributeOnTwo ? mergePixel(ImgIn + 2 * i) : imageIn.get<uint16_t>(i);
+			ImgPlanes[i] = static_cast<OCTET>(decryptPixel(paillierThread, privateKey, pixel));
+		}
+	});
+
+	PgmView imageOut;
+	checkMapping(imageOut.create(cNomImgEcriteDec, nH, nW, 255, 3 * nTaille, 0, 0, 3), cNomImgEcriteDec);
+	OCTET *ImgOutDec = imageOut.data();
+	const OCTET *planeR = ImgPlanes.data(), *planeV = planeR + nTaille, *planeB = planeV + nTaille;
+	parallelPixels(nTaille, [&](size_t begin, size_t end)
+	{
+		PROFILE_STAGE(PLANES);
+		RgbPlanes::interleave(planeR + begin, planeV + begin, planeB + begin, end - begin, ImgOutDec + 3 * begin);
+	});
+}
+
+#endif // PAILLIERCONTROLLER_PPM
@@ -0,0 +1,326 @@
+/**
+ * \file BitPacker.hpp
+ * \brief Packing of the significant bits of 16-bit encrypted pixels into a bit stream.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ * \details With the -olsbr16 and -olsbr32 options the b least significant bits of every
+ * encrypted pixel are 0, so only the bits 15 down to b are kept. They are appended to a
+ * stream pixel after pixel, most significant bit first, and bit j of the stream is bit
+ * j % W of word j / W of the packed image (W = 16 or 8). Pixels are processed four at a
+ * time in a 64-bit word: the bits of each 16-bit lane are reversed with masks and shifts,
+ * then the kept bits of the four lanes are gathered with pext (BMI2) when the processor
+ * has it, or with shifts otherwise.
+ */
+
+#ifndef COMPRESSION_BIT_PACKER
+#define COMPRESSION_BIT_PACKER
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BIT_PACKER_BMI2
+#endif
+
+/**
+ * \class BitPacker
+ * \brief Packing and unpacking of the (16 - b) significant bits of 16-bit pixels.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ */
+class BitPacker
+{
+private:
+	/**
+	 * \brief Reverse the bits inside each 16-bit lane of a 64-bit word.
+	 * \param uint64_t x - Four 16-bit lanes.
+	 * \return uint64_t - The four lanes with their bits reversed.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	static uint64_t reverseLanes(uint64_t x)
+	{
+		x = ((x >> 1) & 0x5555555555555555ULL) | ((x & 0x5555555555555555ULL) << 1);
+		x = ((x >> 2) & 0x3333333333333333ULL) | ((x & 0x3333333333333333ULL) << 2);
+		x = ((x >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((x & 0x0F0F0F0F0F0F0F0FULL) << 4);
+		x = ((x >> 8) & 0x00FF00FF00FF00FFULL) | ((x & 0x00FF00FF00FF00FFULL) << 8);
+		return x;
+	};
+
+	/**
+	 * \brief Mask of the width low bits of each 16-bit lane.
+	 * \param int width - The number of kept bits of a pixel.
+	 * \return uint64_t - The mask.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	static uint64_t laneMask(int width)
+	{
+		return 0x0001000100010001ULL * ((1ULL << width) - 1);
+	};
+
+	/**
+	 * \brief Load up to four pixels in the lanes of a 64-bit word, missing pixels are 0.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	static uint64_t loadLanes(const uint16_t *in, size_t i, size_t count)
+	{
+		uint64_t x = 0;
+		for (size_t k = 0; k < 4 && i + k < count; k++)
+		{
+			x |= (uint64_t)in[i + k] << (16 * k);
+		}
+		return x;
+	};
+
+	/**
+	 * \brief Store up to four pixels from the lanes of a 64-bit word.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	static void storeLanes(uint64_t x, uint16_t *out, size_t i, size_t count)
+	{
+		for (size_t k = 0; k < 4 && i + k < count; k++)
+		{
+			out[i + k] = (uint16_t)(x >> (16 * k));
+		}
+	};
+
+	/**
+	 * \struct Writer
+	 * \brief Appends bits to a stream of Word, through a 64-bit accumulator.
+	 */
+	template <typename Word>
+	struct Writer
+	{
+		static const unsigned W = 8 * sizeof(Word);
+		Word *out;
+		size_t index;
+		uint64_t acc;
+		unsigned filled;
+
+		explicit Writer(Word *out) : out(out), index(0), acc(0), filled(0) {};
+
+		void flush()
+		{
+			for (unsigned k = 0; k < 64; k += W)
+			{
+				out[index++] = (Word)(acc >> k);
+			}
+		};
+
+		void append(uint64_t value, unsigned nbits)
+		{
+			acc |= value << filled;
+			if (filled + nbits >= 64)
+			{
+				flush();
+				acc = filled ? value >> (64 - filled) : 0;
+				filled = filled + nbits - 64;
+			}
+			else
+			{
+				filled += nbits;
+			}
+		};
+
+		/** Write the last incomplete words and set the remaining words of out to 0. */
+		void finish(size_t outCount)
+		{
+			for (unsigned k = 0; k < filled && index < outCount; k += W)
+			{
+				out[index++] = (Word)(acc >> k);
+			}
+			while (index < outCount)
+			{
+				out[index++] = 0;
+			}
+		};
+	};
+
+	/**
+	 * \struct Reader
+	 * \brief Takes bits from a stream of Word, words past the end read as 0.
+	 */
+	template <typename Word>
+	struct Reader
+	{
+		static const unsigned W = 8 * sizeof(Word);
+		const Word *in;
+		size_t inCount;
+		size_t index;
+		uint64_t acc;
+		unsigned avail;
+
+		Reader(const Word *in, size_t inCount) : in(in), inCount(inCount), index(0), acc(0), avail(0) {};
+
+		/** Take nbits bits, nbits <= 32. */
+		uint64_t take(unsigned nbits)
+		{
+			while (avail <= 64 - W)
+			{
+				uint64_t word = index < inCount ? in[index] : 0;
+				index++;
+				acc |= word << avail;
+				avail += W;
+			}
+			uint64_t value = acc & ((1ULL << nbits) - 1);
+			acc = nbits < 64 ? acc >> nbits : 0;
+			avail -= nbits;
+			return value;
+		};
+	};
+
+	/**
+	 * \brief Gather the width low bits of the four lanes, with shifts.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	static uint64_t compactLanes(uint64_t x, int width)
+	{
+		uint64_t m = (1ULL << width) - 1;
+		return (x & m) | (((x >> 16) & m) << width) | (((x >> 32) & m) << (2 * width)) | (((x >> 48) & m) << (3 * width));
+	};
+
+	/**
+	 * \brief Spread 4 * width bits to the width low bits of the four lanes, with shifts.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	static uint64_t expandLanes(uint64_t x, int width)
+	{
+		uint64_t m = (1ULL << width) - 1;
+		return (x & m) | (((x >> width) & m) << 16) | (((x >> (2 * width)) & m) << 32) | (((x >> (3 * width)) & m) << 48);
+	};
+
+	template <typename Word>
+	static void packGeneric(const uint16_t *in, size_t count, int width, Writer<Word> &writer)
+	{
+		for (size_t i = 0; i < count; i += 4)
+		{
+			size_t lanes = count - i < 4 ? count - i : 4;
+			writer.append(compactLanes(reverseLanes(loadLanes(in, i, count)), width), lanes * width);
+		}
+	};
+
+	template <typename Word>
+	static void unpackGeneric(Reader<Word> &reader, int width, uint16_t *out, size_t count)
+	{
+		for (size_t i = 0; i < count; i += 4)
+		{
+			uint64_t bits = reader.take(2 * width);
+			bits |= reader.take(2 * width) << (2 * width);
+			storeLanes(reverseLanes(expandLanes(bits, width)), out, i, count);
+		}
+	};
+
+#ifdef BIT_PACKER_BMI2
+	template <typename Word>
+	__attribute__((target("bmi2"))) static void packBMI2(const uint16_t *in, size_t count, int width, Writer<Word> &writer)
+	{
+		uint64_t mask = laneMask(width);
+		for (size_t i = 0; i < count; i += 4)
+		{
+			size_t lanes = count - i < 4 ? count - i : 4;
+			writer.append(_pext_u64(reverseLanes(loadLanes(in, i, count)), mask), lanes * width);
+		}
+	};
+
+	template <typename Word>
+	__attribute__((target("bmi2"))) static void unpackBMI2(Reader<Word> &reader, int width, uint16_t *out, size_t count)
+	{
+		uint64_t mask = laneMask(width);
+		for (size_t i = 0; i < count; i += 4)
+		{
+			uint64_t bits = reader.take(2 * width);
+			bits |= reader.take(2 * width) << (2 * width);
+			storeLanes(reverseLanes(_pdep_u64(bits, mask)), out, i, count);
+		}
+	};
+
+	static bool hasBMI2()
+	{
+		static const bool supported = __builtin_cpu_supports("bmi2");
+		return supported;
+	};
+#endif
+
+public:
+	/**
+	 * \brief Number of words of the packed stream.
+	 * \tparam Word uint16_t or uint8_t, the type of the words of the packed image.
+	 * \param size_t count - The number of pixels.
+	 * \param int bitsCompressed - The number of least significant bits dropped, from 0 to 16.
+	 * \return size_t - ceil(count * (16 - bitsCompressed) / W).
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	template <typename Word>
+	static size_t packedSize(size_t count, int bitsCompressed)
+	{
+		const size_t W = 8 * sizeof(Word);
+		return (count * (16 - bitsCompressed) + W - 1) / W;
+	};
+
+	/**
+	 * \brief Pack the bits 15 down to bitsCompressed of every pixel.
+	 * \tparam Word uint16_t or uint8_t, the type of the words of the packed image.
+	 * \param const uint16_t *in - The pixels.
+	 * \param size_t count - The number of pixels.
+	 * \param int bitsCompressed - The number of least significant bits dropped, from 0 to 16.
+	 * \param Word *out - The packed image.
+	 * \param size_t outCount - The number of words of out, at least packedSize(count, bitsCompressed),
+	 * the words after the stream are set to 0.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	template <typename Word>
+	static void pack(const uint16_t *in, size_t count, int bitsCompressed, Word *out, size_t outCount)
+	{
+		int width = 16 - bitsCompressed;
+		Writer<Word> writer(out);
+#ifdef BIT_PACKER_BMI2
+		if (hasBMI2())
+		{
+			packBMI2(in, count, width, writer);
+		}
+		else
+#endif
+		{
+			packGeneric(in, count, width, writer);
+		}
+		writer.finish(outCount);
+	};
+
+	/**
+	 * \brief Unpack pixels packed by pack, their bitsCompressed least significant bits are 0.
+	 * \tparam Word uint16_t or uint8_t, the type of the words of the packed image.
+	 * \param const Word *in - The packed image.
+	 * \param size_t inCount - The number of words of in, missing words are read as 0.
+	 * \param int bitsCompressed - The number of least significant bits dropped, from 0 to 16.
+	 * \param uint16_t *out - The pixels.
+	 * \param size_t count - The number of pixels.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	template <typename Word>
+	static void unpack(const Word *in, size_t inCount, int bitsCompressed, uint16_t *out, size_t count)
+	{
+		int width = 16 - bitsCompressed;
+		Reader<Word> reader(in, inCount);
+#ifdef BIT_PACKER_BMI2
+		if (hasBMI2())
+		{
+			unpackBMI2(reader, width, out, count);
+		}
+		else
+#endif
+		{
+			unpackGeneric(reader, width, out, count);
+		}
+	};
+};
+
+#endif // COMPRESSION_BIT_PACKER
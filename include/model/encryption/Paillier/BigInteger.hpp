@@ -0,0 +1,413 @@
+/**
+ * \file BigInteger.hpp
+ * \brief Header of the arbitrary-precision unsigned integers used by the Paillier
+ * cryptosystem with real key sizes (2048, 3072 bits).
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ * \details Integers are stored as arrays of 64-bit limbs, least significant limb first.
+ * Multiplication is schoolbook under KARATSUBA_THRESHOLD limbs and Karatsuba above,
+ * division is Knuth's algorithm D, and modular exponentiation uses Montgomery reduction
+ * (see BigMontgomeryContext). The class is self-contained, it only relies on the
+ * standard library and the 128-bit integers of g++.
+ */
+
+#ifndef BIG_INTEGER
+#define BIG_INTEGER
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * \class BigInteger
+ * \brief Arbitrary-precision unsigned integer.
+ * \details Values are always normalised: the limb array has no most significant
+ * zero limb, so zero is the empty array. Subtraction requires a >= b.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ */
+class BigInteger
+{
+private:
+    std::vector<uint64_t> limbs; //!< Limbs of the integer, least significant first.
+
+    /**
+     * \brief Remove the most significant zero limbs.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    void normalize();
+
+public:
+    static const size_t KARATSUBA_THRESHOLD = 32; //!< Limb count from which Karatsuba is used.
+
+    /**
+     * \brief Construct the integer 0.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    BigInteger();
+
+    /**
+     * \brief Construct an integer from a 64-bit value.
+     * \param uint64_t value - The value.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    BigInteger(uint64_t value);
+
+    /**
+     * \brief Construct an integer from its limbs.
+     * \param const std::vector<uint64_t> &l - The limbs, least significant first.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    explicit BigInteger(const std::vector<uint64_t> &l);
+
+    /**
+     * \brief Parse a hexadecimal string, with or without 0x prefix.
+     * \param const std::string &hex - The hexadecimal string.
+     * \return BigInteger - The parsed integer.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    static BigInteger fromHex(const std::string &hex);
+
+    /**
+     * \brief Parse a decimal string.
+     * \param const std::string &dec - The decimal string.
+     * \return BigInteger - The parsed integer.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    static BigInteger fromDecimal(const std::string &dec);
+
+    /**
+     * \brief Hexadecimal representation, without prefix.
+     * \return std::string - The lower case hexadecimal string.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    std::string toHex() const;
+
+    /**
+     * \brief Decimal representation.
+     * \return std::string - The decimal string.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    std::string toDecimal() const;
+
+    /**
+     * \brief Getter for the limbs.
+     * \return const std::vector<uint64_t>& - The limbs, least significant first.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    const std::vector<uint64_t> &getLimbs() const { return limbs; };
+
+    /**
+     * \brief Number of limbs of the normalised integer.
+     * \return size_t - The number of limbs.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    size_t limbCount() const { return limbs.size(); };
+
+    /**
+     * \brief Get a limb, 0 beyond the most significant one.
+     * \param size_t i - The index of the limb.
+     * \return uint64_t - The limb.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    uint64_t limb(size_t i) const { return i < limbs.size() ? limbs[i] : 0; };
+
+    /**
+     * \brief The lowest 64 bits of the integer.
+     * \return uint64_t - The lowest limb.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    uint64_t toUint64() const { return limb(0); };
+
+    /**
+     * \brief Number of significant bits.
+     * \return size_t - The bit length, 0 for the integer 0.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    size_t bitLength() const;
+
+    /**
+     * \brief Test a bit.
+     * \param size_t i - The index of the bit.
+     * \return bool - The value of the bit.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    bool testBit(size_t i) const;
+
+    /**
+     * \brief Test if the integer is 0.
+     * \return bool - True if the integer is 0.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    bool isZero() const { return limbs.empty(); };
+
+    /**
+     * \brief Test if the integer is odd.
+     * \return bool - True if the integer is odd.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    bool isOdd() const { return !limbs.empty() && (limbs[0] & 1); };
+
+    /**
+     * \brief Three-way comparison.
+     * \param const BigInteger &other - The integer to compare with.
+     * \return int - -1, 0 or 1 if this integer is lower, equal or greater.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    int compare(const BigInteger &other) const;
+
+    bool operator==(const BigInteger &other) const { return compare(other) == 0; };
+    bool operator!=(const BigInteger &other) const { return compare(other) != 0; };
+    bool operator<(const BigInteger &other) const { return compare(other) < 0; };
+    bool operator<=(const BigInteger &other) const { return compare(other) <= 0; };
+    bool operator>(const BigInteger &other) const { return compare(other) > 0; };
+    bool operator>=(const BigInteger &other) const { return compare(other) >= 0; };
+
+    BigInteger operator+(const BigInteger &other) const;
+    BigInteger operator-(const BigInteger &other) const;
+    BigInteger operator*(const BigInteger &other) const;
+    BigInteger operator/(const BigInteger &other) const;
+    BigInteger operator%(const BigInteger &other) const;
+    BigInteger operator<<(size_t bits) const;
+    BigInteger operator>>(size_t bits) const;
+
+    /**
+     * \brief Euclidean division.
+     * \param const BigInteger &a - The dividend.
+     * \param const BigInteger &b - The divisor, not 0.
+     * \param BigInteger &quotient - The quotient a / b.
+     * \param BigInteger &remainder - The remainder a mod b.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    static void divMod(const BigInteger &a, const BigInteger &b, BigInteger &quotient, BigInteger &remainder);
+
+    /**
+     * \brief Remainder of the division by a 64-bit value.
+     * \param uint64_t m - The divisor, not 0.
+     * \return uint64_t - This integer mod m.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    uint64_t modSmall(uint64_t m) const;
+
+    /**
+     * \brief Product of limb arrays, schoolbook or Karatsuba depending on the size.
+     * \param const uint64_t *a - The first factor.
+     * \param size_t na - The number of limbs of a.
+     * \param const uint64_t *b - The second factor.
+     * \param size_t nb - The number of limbs of b.
+     * \param uint64_t *result - The na + nb limbs of the product.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    static void mulLimbs(const uint64_t *a, size_t na, const uint64_t *b, size_t nb, uint64_t *result);
+
+    /**
+     * \brief Greatest common divisor.
+     * \param BigInteger a - The first integer.
+     * \param BigInteger b - The second integer.
+     * \return BigInteger - gcd(a, b).
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    static BigInteger gcd(BigInteger a, BigInteger b);
+
+    /**
+     * \brief Least common multiple.
+     * \param const BigInteger &a - The first integer.
+     * \param const BigInteger &b - The second integer.
+     * \return BigInteger - lcm(a, b).
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    static BigInteger lcm(const BigInteger &a, const BigInteger &b);
+
+    /**
+     * \brief Modular inverse with the extended Euclidean algorithm.
+     * \param const BigInteger &a - The integer to invert.
+     * \param const BigInteger &m - The modulus.
+     * \return BigInteger - a⁻¹ mod m, 0 if a is not invertible.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    static BigInteger modInverse(const BigInteger &a, const BigInteger &m);
+
+    /**
+     * \brief Modular exponentiation.
+     * \details Uses a BigMontgomeryContext for odd moduli, schoolbook reduction otherwise.
+     * \param const BigInteger &base - The base.
+     * \param const BigInteger &e - The exponent.
+     * \param const BigInteger &m - The modulus.
+     * \return BigInteger - base^e mod m.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    static BigInteger modPow(const BigInteger &base, const BigInteger &e, const BigInteger &m);
+
+    /**
+     * \brief Uniform random integer of at most a given number of bits.
+     * \param size_t bits - The number of bits.
+     * \return BigInteger - A random integer in [0, 2^bits).
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    static BigInteger randomBits(size_t bits);
+
+    /**
+     * \brief Uniform random integer below a bound, by rejection sampling.
+     * \param const BigInteger &bound - The exclusive upper bound, not 0.
+     * \return BigInteger - A random integer in [0, bound).
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    static BigInteger randomBelow(const BigInteger &bound);
+
+    /**
+     * \brief Miller-Rabin probabilistic primality test.
+     * \details Trial division by the small primes first, then rounds of Miller-Rabin
+     * with random bases.
+     * \param const BigInteger &n - The integer to test.
+     * \param int rounds - The number of Miller-Rabin rounds.
+     * \return bool - False if n is composite, true if n is prime with probability at least 1 - 4^-rounds.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    static bool isProbablePrime(const BigInteger &n, int rounds = 40);
+
+    /**
+     * \brief Generate a random prime of a given bit length.
+     * \details The two most significant bits are set so that the product of two such
+     * primes has exactly twice their bit length.
+     * \param size_t bits - The bit length of the prime, at least 3.
+     * \return BigInteger - A probable prime of exactly bits bits.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    static BigInteger randomPrime(size_t bits);
+};
+
+/**
+ * \class BigMontgomeryContext
+ * \brief Precomputed constants and operations for Montgomery arithmetic modulo an odd BigInteger.
+ * \details With k the limb count of the modulus m and R = 2^(64k), the context holds
+ * R mod m, R² mod m and -m⁻¹ mod 2⁶⁴. Products are computed with BigInteger::mulLimbs
+ * and reduced word by word (REDC), with scratch buffers kept in the context, so an
+ * exponentiation does not allocate. A context is not thread-safe, use one per thread.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ */
+class BigMontgomeryContext
+{
+private:
+    BigInteger modulus;                   //!< The modulus m, odd.
+    size_t k;                             //!< Number of limbs of m.
+    uint64_t m_inv;                       //!< -m⁻¹ mod 2⁶⁴.
+    std::vector<uint64_t> r_mod;          //!< R mod m on k limbs, 1 in Montgomery form.
+    std::vector<uint64_t> r2_mod;         //!< R² mod m on k limbs.
+    mutable std::vector<uint64_t> buffer; //!< Scratch buffer of 2k + 1 limbs for products.
+
+    /**
+     * \brief Montgomery product of two k-limb values, result = a·b·R⁻¹ mod m.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    void mul(const uint64_t *a, const uint64_t *b, uint64_t *result) const;
+
+    /**
+     * \brief Convert a BigInteger lower than m to k limbs.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    std::vector<uint64_t> toLimbs(const BigInteger &x) const;
+
+public:
+    /**
+     * \brief Construct an empty context.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    BigMontgomeryContext();
+
+    /**
+     * \brief Construct the context of an odd modulus.
+     * \param const BigInteger &m - The modulus, odd and greater than 1.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    explicit BigMontgomeryContext(const BigInteger &m);
+
+    /**
+     * \brief Getter for the modulus.
+     * \return const BigInteger& - The modulus.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    const BigInteger &getModulus() const { return modulus; };
+
+    /**
+     * \brief Modular multiplication of plain values.
+     * \param const BigInteger &a - The first factor.
+     * \param const BigInteger &b - The second factor.
+     * \return BigInteger - a·b mod m.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    BigInteger mulMod(const BigInteger &a, const BigInteger &b) const;
+
+    /**
+     * \brief Modular exponentiation with a fixed 4-bit window.
+     * \param const BigInteger &base - The base.
+     * \param const BigInteger &e - The exponent.
+     * \return BigInteger - base^e mod m.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    BigInteger pow(const BigInteger &base, const BigInteger &e) const;
+
+    /**
+     * \brief Compute x^a · y^b mod m with a single conversion out of Montgomery form.
+     * \param const BigInteger &x - The first base.
+     * \param const BigInteger &a - The first exponent.
+     * \param const BigInteger &y - The second base.
+     * \param const BigInteger &b - The second exponent.
+     * \return BigInteger - x^a · y^b mod m.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    BigInteger powProduct(const BigInteger &x, const BigInteger &a, const BigInteger &y, const BigInteger &b) const;
+
+private:
+    /**
+     * \brief Exponentiation with the result left in Montgomery form on k limbs.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    std::vector<uint64_t> powMontgomery(const BigInteger &base, const BigInteger &e) const;
+
+    /**
+     * \brief Convert k limbs in Montgomery form back to a plain BigInteger.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    BigInteger fromMontgomery(const std::vector<uint64_t> &x) const;
+};
+
+#endif // BIG_INTEGER
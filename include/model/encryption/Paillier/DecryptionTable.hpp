@@ -0,0 +1,119 @@
+/**
+ * \file DecryptionTable.hpp
+ * \brief Header of the decryption lookup table for small Paillier moduli.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ * \details When n² is small (n <= 256 gives at most 65536 ciphertexts), every
+ * ciphertext of Z/n²Z can be decrypted once and for all. Decrypting an image then
+ * becomes a memory-bound gather in the table instead of one exponentiation per pixel.
+ * The table is built in parallel and can be saved next to the private key file.
+ */
+
+#ifndef PAILLIER_DECRYPTION_TABLE
+#define PAILLIER_DECRYPTION_TABLE
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "keys/Paillier_private_key.hpp"
+#include "../../parallel/ThreadPool.hpp"
+
+/**
+ * \class DecryptionTable
+ * \brief Dense table mapping every ciphertext of Z/n²Z to its plaintext.
+ * \details The table file starts with the magic "PLUT", then lambda, mu and n of the
+ * private key it was built for (a file of another key is rejected), then the n²
+ * plaintexts on 16 bits.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ */
+class DecryptionTable
+{
+private:
+	std::vector<uint16_t> table; //!< Plaintext of every ciphertext c < n².
+	uint64_t lambda;             //!< lambda of the private key of the table.
+	uint64_t mu;                 //!< mu of the private key of the table.
+	uint64_t n;                  //!< n of the private key of the table.
+
+public:
+	static const uint64_t MAX_SIZE = 1 << 24; //!< Largest n² supported (32 MB table).
+
+	/**
+	 * \brief Construct an empty table.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	DecryptionTable();
+
+	/**
+	 * \brief Test if the table is built or loaded.
+	 * \return bool - True if the table can be used.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	bool isBuilt() const { return !table.empty(); };
+
+	/**
+	 * \brief Test if a private key can use a table.
+	 * \param const PaillierPrivateKey &key - The private key.
+	 * \return bool - True if n² does not exceed MAX_SIZE.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	static bool isSupported(const PaillierPrivateKey &key);
+
+	/**
+	 * \brief Decrypt every ciphertext of Z/n²Z.
+	 * \details The range [0, n²) is split between the threads of the pool, each block with
+	 * its own Paillier object.
+	 * \param const PaillierPrivateKey &key - The private key.
+	 * \param ThreadPool &threadPool - The threads decrypting the ciphertexts.
+	 * \return bool - False if the key is not supported.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	bool build(const PaillierPrivateKey &key, ThreadPool &threadPool);
+
+	/**
+	 * \brief Load a table file built for a private key.
+	 * \param const std::string &path - The table file.
+	 * \param const PaillierPrivateKey &key - The private key.
+	 * \return bool - False if the file does not exist, is truncated or belongs to another key.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	bool load(const std::string &path, const PaillierPrivateKey &key);
+
+	/**
+	 * \brief Save the table to a file.
+	 * \param const std::string &path - The table file.
+	 * \return bool - False if the file cannot be written.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	bool save(const std::string &path) const;
+
+	/**
+	 * \brief Path of the table file of a private key file, key.bin gives key_lut.bin.
+	 * \param const std::string &keyFile - The private key file.
+	 * \return std::string - The table file.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	static std::string pathForKey(const std::string &keyFile);
+
+	/**
+	 * \brief Decrypt a ciphertext with the table.
+	 * \param uint64_t c - The ciphertext.
+	 * \return uint16_t - The plaintext, 0 if c is not lower than n².
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	uint16_t decrypt(uint64_t c) const
+	{
+		return c < table.size() ? table[c] : 0;
+	};
+};
+
+#endif // PAILLIER_DECRYPTION_TABLE
@@ -0,0 +1,159 @@
+/**
+ * \file GmTable.hpp
+ * \brief Table of the powers g^m mod n² of a Paillier public key.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ * \details The message part g^m mod n² of a ciphertext only depends on the key and the
+ * message, so it is computed once per key for every message of the domain. The table is
+ * immutable once built, the threads encrypting an image share it read-only and only keep
+ * their small mutable state (Montgomery contexts, noise pool) each, and the table of the
+ * last key is kept for the next images of a folder or of the daemon.
+ */
+
+#ifndef PAILLIER_GM_TABLE
+#define PAILLIER_GM_TABLE
+
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <mutex>
+
+#include "Montgomery.hpp"
+
+/**
+ * \class GmTable
+ * \brief g^m mod n² in Montgomery form for the messages m of a public key.
+ * \details g^m = low[m mod LOW_SIZE] · high[m / LOW_SIZE], so the messages of [0, n) cost
+ * one product below LOW_SIZE and two beyond, for n < 2³² and tables of at most LOW_SIZE
+ * entries each. The larger messages are reduced modulo n first, g^m and g^(m mod n)
+ * both decrypt to m mod n.
+ * \tparam Context The Montgomery context of n², on the words of the ciphertexts.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ */
+template <typename Context>
+class GmTable
+{
+public:
+    typedef typename Context::word_type Word; //!< A residue modulo n².
+
+    static const uint64_t LOW_SIZE = 65536; //!< Messages covered by low alone.
+
+private:
+    uint64_t n;             //!< n of the public key.
+    uint64_t g;             //!< g of the public key.
+    Context context;        //!< Montgomery context of n².
+    std::vector<Word> low;  //!< g^m for m in [0, min(n, LOW_SIZE)).
+    std::vector<Word> high; //!< g^(h·LOW_SIZE) for h·LOW_SIZE < n, empty if n <= LOW_SIZE.
+
+public:
+    /**
+     * \brief Build the table of a public key.
+     * \details The tables cost one Montgomery product per entry. They stay empty if n² is
+     * even, the powers are then computed per message.
+     * \param uint64_t n - The n parameter of public key, below 2³².
+     * \param uint64_t g - The generator value.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    GmTable(uint64_t n, uint64_t g) : n(n), g(g), context(n * n)
+    {
+        if (!context.isMontgomery())
+        {
+            return;
+        }
+        low.resize(n < LOW_SIZE ? n : LOW_SIZE);
+        Word g_mont = context.toMontgomery(g);
+        Word power = context.toMontgomery(1);
+        for (Word &entry : low)
+        {
+            entry = power;
+            power = context.mulMontgomery(power, g_mont);
+        }
+        if (n > LOW_SIZE)
+        {
+            // power is now g^LOW_SIZE.
+            high.resize((n + LOW_SIZE - 1) / LOW_SIZE);
+            Word step = power;
+            power = context.toMontgomery(1);
+            for (Word &entry : high)
+            {
+                entry = power;
+                power = context.mulMontgomery(power, step);
+            }
+        }
+    };
+
+    /**
+     * \brief Get the table of a public key, shared by the whole process.
+     * \details The table of the last key is kept, so the images of a folder (-dir) and the
+     * requests of the daemon, which all use the same key, build it only once.
+     * \param uint64_t n - The n parameter of public key, below 2³².
+     * \param uint64_t g - The generator value.
+     * \return std::shared_ptr<const GmTable> - The table of the key.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    static std::shared_ptr<const GmTable> forKey(uint64_t n, uint64_t g)
+    {
+        static std::mutex mutex;
+        static std::shared_ptr<const GmTable> last;
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!last || !last->isFor(n, g))
+        {
+            last = std::make_shared<const GmTable>(n, g);
+        }
+        return last;
+    };
+
+    /**
+     * \brief Test if the table was built for a public key.
+     * \param uint64_t n - The n parameter of public key.
+     * \param uint64_t g - The generator value.
+     * \return bool - True if the table holds the powers of this g modulo this n².
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    bool isFor(uint64_t n, uint64_t g) const
+    {
+        return this->n == n && this->g == g;
+    };
+
+    /**
+     * \brief Getter for the Montgomery context of n².
+     * \return const Context& - The context the entries are in the form of.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    const Context &getContext() const
+    {
+        return context;
+    };
+
+    /**
+     * \brief Calculate g^(m mod n) · y mod n².
+     * \details The pixels of an image key (n = 143) go beyond n, they are reduced, as the
+     * shortcut of g = n + 1 does, instead of costing an exponentiation.
+     * \param uint64_t m - The message.
+     * \param Word y - The plain factor, lower than n².
+     * \return Word - g^(m mod n) · y mod n², a ciphertext of m mod n.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    Word powerTimes(uint64_t m, Word y) const
+    {
+        m %= n;
+        if (m < low.size())
+        {
+            return context.mulMontgomery(low[m], y);
+        }
+        if (!high.empty())
+        {
+            Word gm = context.mulMontgomery(low[m % LOW_SIZE], high[m / LOW_SIZE]);
+            return context.mulMontgomery(gm, y);
+        }
+        return context.powMul(g, m, y);
+    };
+};
+
+#endif // PAILLIER_GM_TABLE
@@ -0,0 +1,296 @@
+/**
+ * \file HomomorphicKernel.hpp
+ * \brief Arithmetic modulo n² on arrays of 16-bit ciphertexts, for the homomorphic operations.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ * \details The Paillier scheme is additively homomorphic : E(x)·E(y) mod n² = E(x + y),
+ * E(x)·g^k mod n² = E(x + k) and E(x)^s mod n² = E(s·x). Over an encrypted image these are
+ * products and powers of every ciphertext, modulo n² < 2¹⁶ for the images of 16-bit pixels.
+ *
+ * The products are reduced with a Montgomery reduction of R = 2¹⁶ whose intermediate values
+ * all fit in 32 bits : with m = t·N⁻¹ mod R, the low halves of t and m·N are equal, so
+ * t·R⁻¹ mod N = (t >> 16) - (m·N >> 16), plus N if negative. With AVX2 it runs on 16
+ * ciphertexts at once in two registers of eight 32-bit lanes, and a power shares its
+ * exponent between the lanes; without AVX2 the same reduction is scalar.
+ */
+
+#ifndef PAILLIER_HOMOMORPHIC_KERNEL
+#define PAILLIER_HOMOMORPHIC_KERNEL
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HOMOMORPHIC_KERNEL_AVX2
+#endif
+
+/**
+ * \class HomomorphicKernel
+ * \brief Products and powers modulo an odd N < 2¹⁶ of arrays of 16-bit ciphertexts.
+ * \details The arrays are the pixels of the encrypted images, 16-bit values in the byte
+ * order of the processor and not necessarily aligned. The output may be one of the inputs.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ */
+class HomomorphicKernel
+{
+private:
+	uint32_t modulus; //!< N, odd.
+	uint32_t inverse; //!< N⁻¹ mod R.
+	uint32_t r_mod;   //!< R mod N, 1 in Montgomery form.
+	uint32_t r2_mod;  //!< R² mod N, to enter Montgomery form.
+
+	static uint16_t load(const uint8_t *p, size_t i)
+	{
+		uint16_t c;
+		memcpy(&c, p + 2 * i, 2);
+		return c;
+	};
+
+	static void store(uint8_t *p, size_t i, uint32_t c)
+	{
+		uint16_t value = static_cast<uint16_t>(c);
+		memcpy(p + 2 * i, &value, 2);
+	};
+
+	/**
+	 * \brief Montgomery reduction, t·R⁻¹ mod N.
+	 * \param uint32_t t - A product of two residues, lower than N·R.
+	 * \return uint32_t - The reduction, lower than N.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	uint32_t redc(uint32_t t) const
+	{
+		uint32_t m = (t * inverse) & 0xFFFF;
+		int32_t u = (int32_t)(t >> 16) - (int32_t)((m * modulus) >> 16);
+		return u < 0 ? u + modulus : u;
+	};
+
+	void multiplyGeneric(const uint8_t *a, const uint8_t *b, uint8_t *out, size_t begin, size_t count) const
+	{
+		for (size_t i = begin; i < count; i++)
+		{
+			store(out, i, redc(redc((uint32_t)load(a, i) * load(b, i)) * r2_mod));
+		}
+	};
+
+	void multiplyByGeneric(const uint8_t *a, uint32_t factorMontgomery, uint8_t *out, size_t begin, size_t count) const
+	{
+		for (size_t i = begin; i < count; i++)
+		{
+			store(out, i, redc((uint32_t)load(a, i) * factorMontgomery));
+		}
+	};
+
+	void powerGeneric(const uint8_t *a, uint64_t e, uint8_t *out, size_t begin, size_t count) const
+	{
+		int top = e == 0 ? -1 : 63 - __builtin_clzll(e);
+		for (size_t i = begin; i < count; i++)
+		{
+			uint32_t base = redc((uint32_t)load(a, i) * r2_mod);
+			uint32_t c = r_mod;
+			for (int bit = top; bit >= 0; bit--)
+			{
+				c = redc(c * c);
+				if ((e >> bit) & 1)
+				{
+					c = redc(c * base);
+				}
+			}
+			store(out, i, redc(c));
+		}
+	};
+
+#ifdef HOMOMORPHIC_KERNEL_AVX2
+	/**
+	 * \brief Montgomery reduction of eight 32-bit lanes, see redc.
+	 */
+	__attribute__((target("avx2"))) static __m256i redc8(__m256i t, __m256i inv, __m256i mod)
+	{
+		__m256i m = _mm256_and_si256(_mm256_mullo_epi32(t, inv), _mm256_set1_epi32(0xFFFF));
+		__m256i u = _mm256_sub_epi32(_mm256_srli_epi32(t, 16), _mm256_srli_epi32(_mm256_mullo_epi32(m, mod), 16));
+		return _mm256_add_epi32(u, _mm256_and_si256(_mm256_srai_epi32(u, 31), mod));
+	};
+
+	/**
+	 * \brief Load 16 ciphertexts in two registers of eight 32-bit lanes.
+	 */
+	__attribute__((target("avx2"))) static void load16(const uint8_t *p, __m256i &lo, __m256i &hi)
+	{
+		lo = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+		hi = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 16)));
+	};
+
+	/**
+	 * \brief Store two registers of eight 32-bit lanes lower than 2¹⁶ as 16 ciphertexts.
+	 */
+	__attribute__((target("avx2"))) static void store16(uint8_t *p, __m256i lo, __m256i hi)
+	{
+		__m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0xD8);
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(p), packed);
+	};
+
+	__attribute__((target("avx2"))) void multiplyAVX2(const uint8_t *a, const uint8_t *b, uint8_t *out, size_t count) const
+	{
+		__m256i inv = _mm256_set1_epi32(inverse), mod = _mm256_set1_epi32(modulus), r2 = _mm256_set1_epi32(r2_mod);
+		size_t i = 0;
+		for (; i + 16 <= count; i += 16)
+		{
+			__m256i alo, ahi, blo, bhi;
+			load16(a + 2 * i, alo, ahi);
+			load16(b + 2 * i, blo, bhi);
+			__m256i lo = redc8(_mm256_mullo_epi32(redc8(_mm256_mullo_epi32(alo, blo), inv, mod), r2), inv, mod);
+			__m256i hi = redc8(_mm256_mullo_epi32(redc8(_mm256_mullo_epi32(ahi, bhi), inv, mod), r2), inv, mod);
+			store16(out + 2 * i, lo, hi);
+		}
+		multiplyGeneric(a, b, out, i, count);
+	};
+
+	__attribute__((target("avx2"))) void multiplyByAVX2(const uint8_t *a, uint32_t factorMontgomery, uint8_t *out, size_t count) const
+	{
+		__m256i inv = _mm256_set1_epi32(inverse), mod = _mm256_set1_epi32(modulus), factor = _mm256_set1_epi32(factorMontgomery);
+		size_t i = 0;
+		for (; i + 16 <= count; i += 16)
+		{
+			__m256i alo, ahi;
+			load16(a + 2 * i, alo, ahi);
+			store16(out + 2 * i, redc8(_mm256_mullo_epi32(alo, factor), inv, mod), redc8(_mm256_mullo_epi32(ahi, factor), inv, mod));
+		}
+		multiplyByGeneric(a, factorMontgomery, out, i, count);
+	};
+
+	__attribute__((target("avx2"))) void powerAVX2(const uint8_t *a, uint64_t e, uint8_t *out, size_t count) const
+	{
+		__m256i inv = _mm256_set1_epi32(inverse), mod = _mm256_set1_epi32(modulus), r2 = _mm256_set1_epi32(r2_mod);
+		__m256i one = _mm256_set1_epi32(1);
+		int top = e == 0 ? -1 : 63 - __builtin_clzll(e);
+		size_t i = 0;
+		for (; i + 16 <= count; i += 16)
+		{
+			__m256i alo, ahi;
+			load16(a + 2 * i, alo, ahi);
+			__m256i baseLo = redc8(_mm256_mullo_epi32(alo, r2), inv, mod), baseHi = redc8(_mm256_mullo_epi32(ahi, r2), inv, mod);
+			__m256i lo = _mm256_set1_epi32(r_mod), hi = lo;
+			for (int bit = top; bit >= 0; bit--)
+			{
+				lo = redc8(_mm256_mullo_epi32(lo, lo), inv, mod);
+				hi = redc8(_mm256_mullo_epi32(hi, hi), inv, mod);
+				if ((e >> bit) & 1)
+				{
+					lo = redc8(_mm256_mullo_epi32(lo, baseLo), inv, mod);
+					hi = redc8(_mm256_mullo_epi32(hi, baseHi), inv, mod);
+				}
+			}
+			store16(out + 2 * i, redc8(_mm256_mullo_epi32(lo, one), inv, mod), redc8(_mm256_mullo_epi32(hi, one), inv, mod));
+		}
+		powerGeneric(a, e, out, i, count);
+	};
+
+	static bool hasAVX2()
+	{
+		static const bool supported = __builtin_cpu_supports("avx2");
+		return supported;
+	};
+#endif
+
+public:
+	/**
+	 * \brief Test if a modulus can be used by the kernel.
+	 * \param uint64_t n2 - The modulus, n².
+	 * \return bool - True if n² is odd and lower than 2¹⁶.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	static bool supports(uint64_t n2)
+	{
+		return n2 > 1 && n2 < 65536 && (n2 & 1);
+	};
+
+	/**
+	 * \brief Construct the kernel of a modulus.
+	 * \param uint32_t n2 - The modulus, n², which must pass supports.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	explicit HomomorphicKernel(uint32_t n2) : modulus(n2)
+	{
+		// Newton iteration, each step doubles the number of correct low bits of N⁻¹.
+		uint32_t x = n2;
+		for (int i = 0; i < 4; i++)
+		{
+			x *= 2 - n2 * x;
+		}
+		inverse = x & 0xFFFF;
+		r_mod = 65536 % n2;
+		r2_mod = (uint32_t)(((uint64_t)r_mod * r_mod) % n2);
+	};
+
+	/**
+	 * \brief Products of two arrays of ciphertexts, E(x + y) from E(x) and E(y).
+	 * \param const uint8_t *a - The count ciphertexts of the first array.
+	 * \param const uint8_t *b - The count ciphertexts of the second array.
+	 * \param uint8_t *out - The count products a[i]·b[i] mod N.
+	 * \param size_t count - The number of ciphertexts.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void multiply(const uint8_t *a, const uint8_t *b, uint8_t *out, size_t count) const
+	{
+#ifdef HOMOMORPHIC_KERNEL_AVX2
+		if (hasAVX2())
+		{
+			multiplyAVX2(a, b, out, count);
+			return;
+		}
+#endif
+		multiplyGeneric(a, b, out, 0, count);
+	};
+
+	/**
+	 * \brief Products of an array of ciphertexts by a constant, E(x + k) from E(x) and g^k.
+	 * \param const uint8_t *a - The count ciphertexts.
+	 * \param uint32_t factor - The constant, lower than N.
+	 * \param uint8_t *out - The count products a[i]·factor mod N.
+	 * \param size_t count - The number of ciphertexts.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void multiplyBy(const uint8_t *a, uint32_t factor, uint8_t *out, size_t count) const
+	{
+		uint32_t factorMontgomery = (uint32_t)(((uint64_t)factor << 16) % modulus);
+#ifdef HOMOMORPHIC_KERNEL_AVX2
+		if (hasAVX2())
+		{
+			multiplyByAVX2(a, factorMontgomery, out, count);
+			return;
+		}
+#endif
+		multiplyByGeneric(a, factorMontgomery, out, 0, count);
+	};
+
+	/**
+	 * \brief Powers of an array of ciphertexts, E(s·x) from E(x).
+	 * \param const uint8_t *a - The count ciphertexts.
+	 * \param uint64_t e - The exponent, s.
+	 * \param uint8_t *out - The count powers a[i]^e mod N.
+	 * \param size_t count - The number of ciphertexts.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void power(const uint8_t *a, uint64_t e, uint8_t *out, size_t count) const
+	{
+#ifdef HOMOMORPHIC_KERNEL_AVX2
+		if (hasAVX2())
+		{
+			powerAVX2(a, e, out, count);
+			return;
+		}
+#endif
+		powerGeneric(a, e, out, 0, count);
+	};
+};
+
+#endif // PAILLIER_HOMOMORPHIC_KERNEL
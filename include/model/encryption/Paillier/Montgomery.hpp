@@ -0,0 +1,285 @@
+/**
+ * \file Montgomery.hpp
+ * \brief Montgomery-form modular arithmetic on 32-bit and 64-bit moduli.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ * \details Modular exponentiation used by the Paillier cryptosystem. A context is
+ * precomputed once per modulus (R mod m, R² mod m and -m⁻¹ mod 2⁶⁴ with R = 2⁶⁴),
+ * after which products are reduced with REDC on 128-bit intermediates, so the hot
+ * loop performs no hardware division and stays correct for any 64-bit modulus.
+ * Moduli below 2³² get a context on 32-bit words, whose products fit in 64 bits and
+ * whose fallback reduction is a native 64-bit division instead of a 128-bit one.
+ */
+
+#ifndef MONTGOMERY_CONTEXT
+#define MONTGOMERY_CONTEXT
+
+#include <cstdint>
+#include <type_traits>
+
+typedef unsigned __int128 uint128_t;
+
+/**
+ * \class MontgomeryContextT
+ * \brief Precomputed constants and operations for Montgomery arithmetic modulo m.
+ * \details Montgomery reduction needs an odd modulus. For an even modulus (p or q
+ * equal to 2) the context falls back to plain double-word multiplication and reduction,
+ * so callers never have to care about the parity of n².
+ * \tparam Word The word of the residues, R = 2^(bits of Word), the modulus must fit in it.
+ * \tparam DoubleWord The unsigned type of twice the bits of Word, holding the products.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ */
+template <typename Word, typename DoubleWord>
+class MontgomeryContextT
+{
+    static_assert(std::is_unsigned<Word>::value && sizeof(Word) >= 4, "Word must be an unsigned type of 32 bits or more.");
+    static_assert(sizeof(DoubleWord) == 2 * sizeof(Word), "DoubleWord must be twice as wide as Word.");
+
+public:
+    typedef Word word_type;                           //!< The word of the residues.
+    static const int WORD_BITS = 8 * sizeof(Word);    //!< R = 2^WORD_BITS.
+
+private:
+    Word modulus; //!< The modulus m.
+    Word r_mod;   //!< R mod m, i.e. 1 in Montgomery form.
+    Word r2_mod;  //!< R² mod m, used to enter Montgomery form.
+    Word m_inv;   //!< -m⁻¹ mod R.
+    bool odd;     //!< True if Montgomery reduction can be used.
+
+public:
+    /**
+     * \brief Construct an empty context.
+     * \details The modulus is 0 until the context is initialised, so any lookup
+     * against a real modulus misses.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    MontgomeryContextT() : modulus(0), r_mod(0), r2_mod(0), m_inv(0), odd(false) {};
+
+    /**
+     * \brief Construct the context of a modulus.
+     * \param uint64_t m - The modulus, 1 < m < 2^WORD_BITS.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    explicit MontgomeryContextT(uint64_t m)
+    {
+        init(m);
+    };
+
+    /**
+     * \brief Precompute R mod m, R² mod m and -m⁻¹ mod R.
+     * \details The inverse of m modulo R is obtained by Newton iteration, each
+     * step doubling the number of correct low bits (m is its own inverse mod 2³).
+     * \param uint64_t m - The modulus, 1 < m < 2^WORD_BITS.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    void init(uint64_t m)
+    {
+        modulus = (Word)m;
+        odd = (m & 1) && m > 1;
+        r_mod = (Word)((Word)0 - modulus) % modulus;
+        r2_mod = (Word)(((DoubleWord)r_mod * r_mod) % modulus);
+
+        Word inv = modulus;
+        for (int i = 0; i < 5; i++)
+        {
+            inv *= (Word)2 - modulus * inv;
+        }
+        m_inv = (Word)0 - inv;
+    };
+
+    /**
+     * \brief Getter for the modulus of the context.
+     * \return Word - The modulus m.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    Word getModulus() const
+    {
+        return modulus;
+    };
+
+    /**
+     * \brief Test if the context uses Montgomery reduction.
+     * \return bool - True if the modulus is odd, false for the plain fallback.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    bool isMontgomery() const
+    {
+        return odd;
+    };
+
+    /**
+     * \brief Montgomery reduction (REDC).
+     * \param DoubleWord t - A value lower than m·R.
+     * \return Word - t·R⁻¹ mod m.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    Word redc(DoubleWord t) const
+    {
+        Word t_lo = (Word)t;
+        Word k = t_lo * m_inv;
+        DoubleWord km = (DoubleWord)k * modulus;
+        // t_lo + low(km) is 0 mod R, it carries unless t_lo is 0.
+        DoubleWord u = (t >> WORD_BITS) + (km >> WORD_BITS) + (t_lo != 0);
+        if (u >= modulus)
+        {
+            u -= modulus;
+        }
+        return (Word)u;
+    };
+
+    /**
+     * \brief Multiply two values, at least one of them in Montgomery form.
+     * \details With aR and bR the result is abR (Montgomery form), with aR and b
+     * the result is ab (plain form).
+     * \param Word a - The first factor.
+     * \param Word b - The second factor, lower than m.
+     * \return Word - a·b·R⁻¹ mod m.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    Word mulMontgomery(Word a, Word b) const
+    {
+        return redc((DoubleWord)a * b);
+    };
+
+    /**
+     * \brief Convert a plain value to Montgomery form.
+     * \param uint64_t x - The plain value.
+     * \return Word - x·R mod m.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    Word toMontgomery(uint64_t x) const
+    {
+        return redc((DoubleWord)(Word)(x % modulus) * r2_mod);
+    };
+
+    /**
+     * \brief Convert a value in Montgomery form back to plain form.
+     * \param Word x - The value in Montgomery form.
+     * \return Word - x·R⁻¹ mod m.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    Word fromMontgomery(Word x) const
+    {
+        return redc(x);
+    };
+
+    /**
+     * \brief Multiply two plain values modulo m.
+     * \param Word a - The first factor.
+     * \param Word b - The second factor.
+     * \return Word - a·b mod m.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    Word mulMod(Word a, Word b) const
+    {
+        return (Word)(((DoubleWord)a * b) % modulus);
+    };
+
+    /**
+     * \brief Modular exponentiation with the result left in Montgomery form.
+     * \details Left-to-right square-and-multiply starting at the highest set bit of
+     * the exponent, so the loop runs for the exponent length instead of 64 steps.
+     * \param uint64_t x - The plain base.
+     * \param uint64_t e - The exponent.
+     * \return Word - x^e·R mod m.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    Word powMontgomery(uint64_t x, uint64_t e) const
+    {
+        Word base = toMontgomery(x);
+        Word c = r_mod;
+        for (int i = e ? 63 - __builtin_clzll(e) : -1; i >= 0; i--)
+        {
+            c = mulMontgomery(c, c);
+            if ((e >> i) & 1)
+                c = mulMontgomery(c, base);
+        }
+        return c;
+    };
+
+    /**
+     * \brief Modular exponentiation.
+     * \param uint64_t x - The base.
+     * \param uint64_t e - The exponent.
+     * \return Word - x^e mod m.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    Word pow(uint64_t x, uint64_t e) const
+    {
+        if (!odd)
+        {
+            Word c = 1 % modulus;
+            Word base = (Word)(x % modulus);
+            for (int i = e ? 63 - __builtin_clzll(e) : -1; i >= 0; i--)
+            {
+                c = mulMod(c, c);
+                if ((e >> i) & 1)
+                    c = mulMod(c, base);
+            }
+            return c;
+        }
+        return fromMontgomery(powMontgomery(x, e));
+    };
+
+    /**
+     * \brief Compute x^e · y mod m.
+     * \details The power stays in Montgomery form and the REDC of its product with the
+     * plain y directly gives the plain result.
+     * \param uint64_t x - The base.
+     * \param uint64_t e - The exponent.
+     * \param uint64_t y - The plain factor.
+     * \return Word - x^e · y mod m.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    Word powMul(uint64_t x, uint64_t e, uint64_t y) const
+    {
+        if (!odd)
+        {
+            return mulMod(pow(x, e), (Word)(y % modulus));
+        }
+        return mulMontgomery(powMontgomery(x, e), (Word)(y % modulus));
+    };
+
+    /**
+     * \brief Compute x^a · y^b mod m.
+     * \details Both powers stay in Montgomery form and a single REDC recombines
+     * them, which is the shape of a Paillier encryption g^m · r^n mod n².
+     * \param uint64_t x - The first base.
+     * \param uint64_t a - The first exponent.
+     * \param uint64_t y - The second base.
+     * \param uint64_t b - The second exponent.
+     * \return Word - x^a · y^b mod m.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    Word powProduct(uint64_t x, uint64_t a, uint64_t y, uint64_t b) const
+    {
+        if (!odd)
+        {
+            return mulMod(pow(x, a), pow(y, b));
+        }
+        return fromMontgomery(mulMontgomery(powMontgomery(x, a), powMontgomery(y, b)));
+    };
+};
+
+/** Montgomery arithmetic modulo any 64-bit m, on 128-bit products. */
+typedef MontgomeryContextT<uint64_t, uint128_t> MontgomeryContext;
+
+/** Montgomery arithmetic modulo m < 2³², on 64-bit products. */
+typedef MontgomeryContextT<uint32_t, uint64_t> MontgomeryContext32;
+
+#endif // MONTGOMERY_CONTEXT
@@ -0,0 +1,153 @@
+/**
+ * \file NoisePool.hpp
+ * \brief Header of the pool of precomputed Paillier noise values r^n mod n².
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ * \details The noise r^n mod n² of a Paillier ciphertext does not depend on the
+ * message, so it can be computed ahead of time. The pool computes the values by
+ * batches, either on demand or on a background thread, and encryption then only
+ * costs g^m mod n² and one modular multiplication (see Paillier::paillierEncryptionWithNoise).
+ */
+
+#ifndef PAILLIER_NOISE_POOL
+#define PAILLIER_NOISE_POOL
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Montgomery.hpp"
+
+/**
+ * \class NoisePool
+ * \brief Batches of precomputed r^n mod n² values, with r random in Z/nZ*.
+ * \details The consumer announces with expect() how many values it will draw, and only
+ * those are computed. With a background thread, the producer computes the next batch of
+ * them while the consumer uses the current one, so the exponentiations overlap the rest of
+ * the encryption. next() must be called from a single thread.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ */
+class NoisePool
+{
+private:
+	uint64_t n;                    //!< The n parameter of public key.
+	MontgomeryContext montgomery;  //!< Montgomery context of n².
+	size_t batchSize;              //!< Number of values computed at once.
+
+	std::vector<uint64_t> current; //!< Batch being consumed.
+	size_t position;               //!< Next value of current to hand out.
+
+	bool background;               //!< True if a producer thread fills the pool.
+	std::thread producer;          //!< Producer thread.
+	std::mutex mutex;              //!< Protects ready, hasReady and stop.
+	std::condition_variable cond;  //!< Signals a ready batch or a consumed one.
+	std::vector<uint64_t> ready;   //!< Batch computed in advance by the producer.
+	bool hasReady;                 //!< True if ready holds a full batch.
+	bool stop;                     //!< Asks the producer to terminate.
+	size_t requested;              //!< Values announced by expect() whose computation has not started.
+	size_t queued;                 //!< Values of the batch being computed by the producer, or ready.
+
+	/**
+	 * \brief Compute a batch of noise values.
+	 * \param std::vector<uint64_t> &batch - The batch to fill.
+	 * \param size_t size - The number of values.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void computeBatch(std::vector<uint64_t> &batch, size_t size);
+
+	/**
+	 * \brief Main loop of the producer thread.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void produce();
+
+	/**
+	 * \brief Take the size of the next batch from the values requested, a full batch if none is.
+	 * \return size_t - The number of values of the batch.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	size_t takeRequested();
+
+	/**
+	 * \brief Replace the exhausted current batch.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void refill();
+
+public:
+	/**
+	 * \brief Construct a noise pool for a public key.
+	 * \param uint64_t n - The n parameter of public key.
+	 * \param size_t batchSize - The number of values computed at once.
+	 * \param bool background - True to compute the batches on a background thread.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	NoisePool(uint64_t n, size_t batchSize = 4096, bool background = false);
+
+	/**
+	 * \brief Destroy the pool, stopping the producer thread.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	~NoisePool();
+
+	NoisePool(const NoisePool &) = delete;
+	NoisePool &operator=(const NoisePool &) = delete;
+
+	/**
+	 * \brief Getter for n.
+	 * \return uint64_t - The n parameter of public key.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	uint64_t getN() const { return n; };
+
+	/**
+	 * \brief Announce the number of values the next calls to next() will draw.
+	 * \details The values left in the pool count, so only the missing ones are computed, by
+	 * batches of at most batchSize. Without announcement, a full batch is computed when the pool
+	 * is empty.
+	 * \param size_t count - The number of values.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void expect(size_t count);
+
+	/**
+	 * \brief Pool of the calling thread for a public key.
+	 * \details The pool is computed on demand by the calling thread, so the threads of -t are
+	 * the only ones computing the noise. It lives as long as the thread and is replaced when
+	 * n changes, so the values left at the end of a block or of an image serve the next one.
+	 * \param uint64_t n - The n parameter of public key.
+	 * \return NoisePool& - A pool owned by the calling thread.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	static NoisePool &threadInstance(uint64_t n);
+
+	/**
+	 * \brief Hand out the next precomputed value.
+	 * \return uint64_t - r^n mod n² for a fresh random r of Z/nZ*.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	uint64_t next()
+	{
+		if (position == current.size())
+		{
+			refill();
+		}
+		return current[position++];
+	};
+};
+
+#endif // PAILLIER_NOISE_POOL
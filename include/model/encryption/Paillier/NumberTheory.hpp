@@ -0,0 +1,139 @@
+/**
+ * \file NumberTheory.hpp
+ * \brief Greatest common divisor and modular inverses on 64-bit integers.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ * \details The GCD is computed with the binary algorithm of Stein (shifts and
+ * subtractions only), and inverses with the iterative extended Euclidean algorithm,
+ * so both run in O(log n) steps. Many inverses modulo the same n are computed with a
+ * single inversion by Montgomery's trick.
+ */
+
+#ifndef NUMBER_THEORY
+#define NUMBER_THEORY
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Montgomery.hpp"
+
+/**
+ * \class NumberTheory
+ * \brief Static number-theoretic functions used by key generation and sampling.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ */
+class NumberTheory
+{
+public:
+    /**
+     * \brief Greatest common divisor of two integers, by the binary algorithm.
+     * \param uint64_t a - The first integer.
+     * \param uint64_t b - The second integer.
+     * \return uint64_t - gcd(a, b), with gcd(a, 0) = a.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    static uint64_t gcd(uint64_t a, uint64_t b)
+    {
+        if (a == 0)
+        {
+            return b;
+        }
+        if (b == 0)
+        {
+            return a;
+        }
+        int shift = __builtin_ctzll(a | b);
+        a >>= __builtin_ctzll(a);
+        do
+        {
+            b >>= __builtin_ctzll(b);
+            if (a > b)
+            {
+                uint64_t t = a;
+                a = b;
+                b = t;
+            }
+            b -= a;
+        } while (b != 0);
+        return a << shift;
+    };
+
+    /**
+     * \brief Modular inverse, by the iterative extended Euclidean algorithm.
+     * \param uint64_t a - The integer to invert.
+     * \param uint64_t n - The modulus.
+     * \return uint64_t - a⁻¹ mod n, or 0 if a is not invertible modulo n.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    static uint64_t modInverse(uint64_t a, uint64_t n)
+    {
+        if (n <= 1)
+        {
+            return 0;
+        }
+        // Invariant: old_r = old_s * a (mod n) and r = s * a (mod n).
+        uint64_t old_r = a % n, r = n;
+        __int128 old_s = 1, s = 0;
+        while (r != 0)
+        {
+            uint64_t quotient = old_r / r;
+            uint64_t t = old_r - quotient * r;
+            old_r = r;
+            r = t;
+            __int128 ts = old_s - (__int128)quotient * s;
+            old_s = s;
+            s = ts;
+        }
+        if (old_r != 1)
+        {
+            return 0;
+        }
+        old_s %= (__int128)n;
+        return (uint64_t)(old_s < 0 ? old_s + n : old_s);
+    };
+
+    /**
+     * \brief Modular inverses of many integers with a single inversion (Montgomery's trick).
+     * \details The prefix products a₀, a₀a₁, ... are inverted once, then the inverses are
+     * peeled off backwards, so count inverses cost one inversion and 3(count - 1) products.
+     * \param const uint64_t *a - The integers to invert.
+     * \param uint64_t *out - The array receiving the inverses, may be a.
+     * \param size_t count - The number of integers.
+     * \param uint64_t n - The modulus.
+     * \return bool - True if every integer is invertible, false otherwise (out is then undefined).
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    static bool batchModInverse(const uint64_t *a, uint64_t *out, size_t count, uint64_t n)
+    {
+        if (count == 0)
+        {
+            return true;
+        }
+        std::vector<uint64_t> prefix(count);
+        prefix[0] = a[0] % n;
+        for (size_t i = 1; i < count; i++)
+        {
+            prefix[i] = (uint64_t)(((uint128_t)prefix[i - 1] * a[i]) % n);
+        }
+        uint64_t inverse = modInverse(prefix[count - 1], n);
+        if (inverse == 0)
+        {
+            return false;
+        }
+        for (size_t i = count - 1; i > 0; i--)
+        {
+            uint64_t ai = a[i] % n;
+            out[i] = (uint64_t)(((uint128_t)inverse * prefix[i - 1]) % n);
+            inverse = (uint64_t)(((uint128_t)inverse * ai) % n);
+        }
+        out[0] = inverse;
+        return true;
+    };
+};
+
+#endif // NUMBER_THEORY
@@ -0,0 +1,269 @@
+/**
+ * \file Paillier_big.hpp
+ * \brief Specialisation of the Paillier cryptosystem for arbitrary-precision integers.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ * \details Paillier<BigInteger, BigInteger> offers the same operations as the 64-bit
+ * implementation for real key sizes (n of 1024 to 3072 bits and more): key generation
+ * from random primes, encryption, standard and CRT decryption. Exponentiations use
+ * BigMontgomeryContext, cached per modulus in the object.
+ */
+
+#ifndef PAILLIER_CRYPTOSYSTEM_BIG
+#define PAILLIER_CRYPTOSYSTEM_BIG
+
+#include <stdexcept>
+
+#include "Paillier.hpp"
+#include "BigInteger.hpp"
+
+/**
+ * \class Paillier<BigInteger, BigInteger>
+ * \brief Paillier cryptosystem on arbitrary-precision integers.
+ * \details A Paillier object is not thread-safe because of its Montgomery contexts,
+ * use one object per thread.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ */
+template <>
+class Paillier<BigInteger, BigInteger>
+{
+private:
+    static const int MONTGOMERY_CACHE_SIZE = 3; //!< Enough for n², p² and q² (CRT decryption).
+
+    BigMontgomeryContext montgomery[MONTGOMERY_CACHE_SIZE]; //!< Montgomery contexts of the last moduli used.
+    int montgomery_next = 0;                                //!< Next slot of montgomery to be replaced.
+
+    /**
+     * \brief Get the Montgomery context of an odd modulus.
+     * \param const BigInteger &m - The modulus.
+     * \return const BigMontgomeryContext& - The context of m.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    const BigMontgomeryContext &getMontgomeryContext(const BigInteger &m)
+    {
+        for (int i = 0; i < MONTGOMERY_CACHE_SIZE; i++)
+        {
+            if (montgomery[i].getModulus() == m)
+            {
+                return montgomery[i];
+            }
+        }
+        BigMontgomeryContext &context = montgomery[montgomery_next];
+        montgomery_next = (montgomery_next + 1) % MONTGOMERY_CACHE_SIZE;
+        context = BigMontgomeryContext(m);
+        return context;
+    };
+
+public:
+    /**
+     * \brief Construct a new Paillier object
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    Paillier(){};
+
+    /**
+     * \brief Destroy the Paillier object
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    ~Paillier(){};
+
+    /**
+     * \brief Calculate the modular exponentiation of a base raised to a power modulo a modulus.
+     * \param const BigInteger &x - The base value.
+     * \param const BigInteger &e - The exponent value.
+     * \param const BigInteger &n - The modulus.
+     * \return BigInteger - x^e mod n.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    BigInteger fastMod(const BigInteger &x, const BigInteger &e, const BigInteger &n)
+    {
+        if (!n.isOdd())
+        {
+            return BigInteger::modPow(x, e, n);
+        }
+        return getMontgomeryContext(n).pow(x, e);
+    };
+
+    /**
+     * \brief Calculate L(x) = (x-1)/n.
+     * \param const BigInteger &x - The value of x, at least 1.
+     * \param const BigInteger &n - The n parameter of public key.
+     * \return BigInteger - The value of L(x).
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    BigInteger L(const BigInteger &x, const BigInteger &n)
+    {
+        return (x - 1) / n;
+    };
+
+    /**
+     * \brief Choose a random element from the set Z/nZ*.
+     * \param const BigInteger &n - The n parameter of public key.
+     * \return BigInteger - A random element of [1, n) coprime with n.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    BigInteger randomZNStar(const BigInteger &n)
+    {
+        BigInteger r;
+        do
+        {
+            r = BigInteger::randomBelow(n);
+        } while (r.isZero() || BigInteger::gcd(r, n) != BigInteger(1));
+        return r;
+    };
+
+    /**
+     * \brief Generate two distinct primes of a given bit length such that gcd(pq, (p-1)(q-1)) = 1.
+     * \param size_t bits - The bit length of each prime, n has 2·bits bits.
+     * \param BigInteger &p - The first prime.
+     * \param BigInteger &q - The second prime.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    void generatePrimes(size_t bits, BigInteger &p, BigInteger &q)
+    {
+        do
+        {
+            p = BigInteger::randomPrime(bits);
+            q = BigInteger::randomPrime(bits);
+        } while (p == q || BigInteger::gcd(p * q, (p - 1) * (q - 1)) != BigInteger(1));
+    };
+
+    /**
+     * \brief Generate g for Paillier cryptosystem.
+     * \details g = n + 1 is always valid: L((n+1)^lambda mod n²) = lambda, which is invertible mod n,
+     * and it keeps g^m mod n² = 1 + m·n cheap.
+     * \param const BigInteger &n - The n parameter of public key.
+     * \return BigInteger - The value of g.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    BigInteger generate_g(const BigInteger &n)
+    {
+        return n + 1;
+    };
+
+    /**
+     * \brief Generate private key for Paillier cryptosystem.
+     * \param BigInteger &lambda - The generated value of lambda.
+     * \param BigInteger &mu - The generated value of Mu.
+     * \param const BigInteger &p - The first prime factor of n.
+     * \param const BigInteger &q - The second prime factor of n.
+     * \param const BigInteger &n - The n parameter of public key.
+     * \param const BigInteger &g - The generator value.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    void generatePrivateKey(BigInteger &lambda, BigInteger &mu, const BigInteger &p, const BigInteger &q, const BigInteger &n, const BigInteger &g)
+    {
+        lambda = BigInteger::lcm(p - 1, q - 1);
+        mu = BigInteger::modInverse(L(fastMod(g, lambda, n * n), n), n);
+        if (mu.isZero())
+        {
+            throw std::runtime_error("Erreur mu n'existe pas pour ce g.");
+        }
+    };
+
+    /**
+     * \brief Generate the constants of the CRT decryption.
+     * \param BigInteger &hp - The generated value of hp = L_p(g^(p-1) mod p²)⁻¹ mod p.
+     * \param BigInteger &hq - The generated value of hq = L_q(g^(q-1) mod q²)⁻¹ mod q.
+     * \param BigInteger &p_inv_q - The generated value of p⁻¹ mod q.
+     * \param const BigInteger &p - The first prime factor of n.
+     * \param const BigInteger &q - The second prime factor of n.
+     * \param const BigInteger &g - The generator value.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    void generateCRTParameters(BigInteger &hp, BigInteger &hq, BigInteger &p_inv_q, const BigInteger &p, const BigInteger &q, const BigInteger &g)
+    {
+        hp = BigInteger::modInverse(L(fastMod(g, p - 1, p * p), p), p);
+        hq = BigInteger::modInverse(L(fastMod(g, q - 1, q * q), q), q);
+        p_inv_q = BigInteger::modInverse(p % q, q);
+    };
+
+    /**
+     * \overload
+     * \brief Encrypt a message using Paillier cryptosystem.
+     * \param const BigInteger &n - The modulus value.
+     * \param const BigInteger &g - The generator value.
+     * \param const BigInteger &m - The message to be encrypted, lower than n.
+     * \return BigInteger - The encrypted message.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    BigInteger paillierEncryption(const BigInteger &n, const BigInteger &g, const BigInteger &m)
+    {
+        return paillierEncryption(n, g, m, randomZNStar(n));
+    };
+
+    /**
+     * \overload
+     * \brief Encrypt a message using Paillier cryptosystem with a given random value.
+     * \details c = g^m · r^n mod n², computed with a single conversion out of Montgomery form.
+     * \param const BigInteger &n - The modulus value.
+     * \param const BigInteger &g - The generator value.
+     * \param const BigInteger &m - The message to be encrypted, lower than n.
+     * \param const BigInteger &r - The random value of Z/nZ*.
+     * \return BigInteger - The encrypted message.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    BigInteger paillierEncryption(const BigInteger &n, const BigInteger &g, const BigInteger &m, const BigInteger &r)
+    {
+        if (m >= n)
+        {
+            throw std::runtime_error("Erreur m doit être inférieur à n.");
+        }
+        return getMontgomeryContext(n * n).powProduct(g, m, r, n);
+    };
+
+    /**
+     * \overload
+     * \brief Decrypt a ciphertext using Paillier cryptosystem.
+     * \param const BigInteger &n - The modulus value.
+     * \param const BigInteger &lambda - The Carmichael function of n.
+     * \param const BigInteger &mu - The Mu value.
+     * \param const BigInteger &c - The ciphertext to be decrypted.
+     * \return BigInteger - The decrypted message.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    BigInteger paillierDecryption(const BigInteger &n, const BigInteger &lambda, const BigInteger &mu, const BigInteger &c)
+    {
+        return (L(fastMod(c, lambda, n * n), n) * mu) % n;
+    };
+
+    /**
+     * \brief Decrypt a ciphertext using Paillier cryptosystem and the Chinese remainder theorem.
+     * \details mp = L_p(c^(p-1) mod p²)·hp mod p and mq = L_q(c^(q-1) mod q²)·hq mod q are two
+     * half-size exponentiations, recombined with m = mp + p·((mq - mp)·p⁻¹ mod q).
+     * \param const BigInteger &p - The first prime factor of n.
+     * \param const BigInteger &q - The second prime factor of n.
+     * \param const BigInteger &hp - The CRT constant of p.
+     * \param const BigInteger &hq - The CRT constant of q.
+     * \param const BigInteger &p_inv_q - p⁻¹ mod q.
+     * \param const BigInteger &c - The ciphertext to be decrypted.
+     * \return BigInteger - The decrypted message.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    BigInteger paillierDecryptionCRT(const BigInteger &p, const BigInteger &q, const BigInteger &hp, const BigInteger &hq, const BigInteger &p_inv_q, const BigInteger &c)
+    {
+        BigInteger mp = (L(fastMod(c, p - 1, p * p), p) * hp) % p;
+        BigInteger mq = (L(fastMod(c, q - 1, q * q), q) * hq) % q;
+
+        BigInteger mp_q = mp % q;
+        BigInteger diff = mq >= mp_q ? mq - mp_q : mq + q - mp_q;
+        return mp + p * ((diff * p_inv_q) % q);
+    };
+};
+
+#endif // PAILLIER_CRYPTOSYSTEM_BIG
@@ -0,0 +1,79 @@
+/**
+ * \file PrimeGenerator.hpp
+ * \brief Header of the primality test and the random prime generation of 64-bit keys.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ * \details Candidates are first divided by the small primes of a sieve of Eratosthenes,
+ * which rejects most composites, then checked with a Miller-Rabin test on a set of
+ * bases that is deterministic for every 64-bit integer. Key primes are searched by
+ * several threads at once, each with its own random generator.
+ */
+
+#ifndef PAILLIER_PRIME_GENERATOR
+#define PAILLIER_PRIME_GENERATOR
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * \class PrimeGenerator
+ * \brief Primality test and random generation of the primes p and q of a key.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ */
+class PrimeGenerator
+{
+private:
+	static const uint64_t SIEVE_LIMIT = 1024; //!< The small primes are the primes below this bound.
+
+	/**
+	 * \brief Primes below SIEVE_LIMIT, computed once by a sieve of Eratosthenes.
+	 * \return const std::vector<uint64_t>& - The small primes, in increasing order.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	static const std::vector<uint64_t> &smallPrimes();
+
+	/**
+	 * \brief Random prime of exactly bits bits, safe (p = 2p' + 1 with p' prime) or not.
+	 * \param unsigned bits - The bit length, from 2 to 32.
+	 * \param bool safe - True to draw a safe prime.
+	 * \return uint64_t - The prime.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	static uint64_t randomPrime(unsigned bits, bool safe);
+
+public:
+	static const unsigned MIN_BITS = 8;       //!< Smallest modulus n that can be generated.
+	static const unsigned MIN_SAFE_BITS = 12; //!< Smallest modulus n that can be generated with safe primes.
+	static const unsigned MAX_BITS = 32;      //!< Largest modulus n, n² must fit on 64 bits.
+
+	/**
+	 * \brief Check if an integer is prime.
+	 * \details Trial division by the small primes, then a Miller-Rabin test with the bases
+	 * 2, 325, 9375, 28178, 450775, 9780504 and 1795265022, which has no false positive
+	 * below 2⁶⁴.
+	 * \param uint64_t n - The integer to check.
+	 * \return bool - True if n is prime.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	static bool isPrime(uint64_t n);
+
+	/**
+	 * \brief Generate the primes p and q of a key with a modulus n = pq of exactly bits bits.
+	 * \details p and q are distinct, of balanced sizes (bits/2 and bits - bits/2 bits), with
+	 * gcd(pq, (p-1)(q-1)) = 1. The search runs on threads threads, the first pair found is kept.
+	 * \param unsigned bits - The bit length of n, from MIN_BITS (MIN_SAFE_BITS for safe primes) to MAX_BITS.
+	 * \param bool safe - True to generate safe primes.
+	 * \param unsigned threads - The number of threads, 0 for the number of cores.
+	 * \param uint64_t &p - The first prime.
+	 * \param uint64_t &q - The second prime.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	static void generateKeyPrimes(unsigned bits, bool safe, unsigned threads, uint64_t &p, uint64_t &q);
+};
+
+#endif // PAILLIER_PRIME_GENERATOR
@@ -0,0 +1,302 @@
+/**
+ * \file SlotPacking.hpp
+ * \brief Packing of several 8-bit pixels into one Paillier plaintext.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ * \details A plaintext of Z/nZ holds bitLength(n) - 1 bits, so with a n of more than 8 bits
+ * a single pixel per ciphertext leaves most of it unused. The pixels are put in k slots of
+ * 8 + G bits, slot i being the bits [i(8 + G), (i + 1)(8 + G)) of the plaintext, and the k
+ * pixels are encrypted at once. The G guard bits left above each pixel keep the slots apart
+ * when ciphertexts are later multiplied, up to 2^G plaintexts can be added slot by slot.
+ *
+ * The packed images are 8-bit PGM images : each row of the original image is cut in groups
+ * of k pixels (the last group may be shorter) and each group is stored as its ciphertext of
+ * B bytes, B = ceil(bitLength(n² - 1) / 8), least significant byte first. The layout is
+ * recorded in the first comment line of the header :
+ *
+ *     # paillier-slots K SLOT_BITS B WIDTH [MAX]
+ *
+ * where WIDTH is the number of columns of the original image. MAX, written only when it is
+ * not 255, bounds the values of the slots once images are added (eval), up to 2^(8 + G) - 1,
+ * or n - 1 for a single slot whose sums (eval -downscale, -sum and -region) may use the whole
+ * plaintext. These images decrypt to 16-bit images instead of 8-bit pixels.
+ */
+
+#ifndef PAILLIER_SLOT_PACKING
+#define PAILLIER_SLOT_PACKING
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+/**
+ * \class SlotPacking
+ * \brief Layout of the slots of a packed image, and packing of the pixels of a ciphertext.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ */
+class SlotPacking
+{
+private:
+	int slots;       //!< Number of pixels per plaintext, k.
+	int slotBits;    //!< Bits of a slot, 8 + G.
+	int cipherBytes; //!< Bytes of a stored ciphertext, B.
+	int width;       //!< Number of columns of the original image.
+	uint64_t maxValue; //!< Largest value of a slot, 255 for pixels.
+	uint64_t slotMax;  //!< Largest value a slot can hold without reaching the next one or n.
+
+public:
+	static const int PIXEL_BITS = 8; //!< Bits of a pixel.
+	static const uint64_t PIXEL_MAX = 255; //!< Largest pixel.
+
+	SlotPacking() : slots(0), slotBits(0), cipherBytes(0), width(0), maxValue(PIXEL_MAX), slotMax(PIXEL_MAX) {};
+
+	/**
+	 * \brief Number of significant bits of an integer.
+	 * \param uint64_t x - The integer.
+	 * \return int - The position of its highest bit set plus one, 0 for 0.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	static int bitLength(uint64_t x)
+	{
+		return x == 0 ? 0 : 64 - __builtin_clzll(x);
+	};
+
+	/**
+	 * \brief Layout of the images of a key.
+	 * \details k is the largest number of slots whose k(8 + G) bits stay below bitLength(n) - 1,
+	 * so that every packed plaintext, and every sum of 2^G of them, is smaller than n.
+	 * \param uint64_t n - The n parameter of the key, n² of 64 bits at most.
+	 * \param int guardBits - G, the guard bits of each slot.
+	 * \param int width - The number of columns of the original image.
+	 * \param SlotPacking &layout - The layout, set if the key holds at least one slot.
+	 * \return bool - False if n is too small for a slot of 8 + G bits.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	static bool forKey(uint64_t n, int guardBits, int width, SlotPacking &layout)
+	{
+		if (n < 2 || guardBits < 0 || guardBits > 24)
+		{
+			return false;
+		}
+		int bits = PIXEL_BITS + guardBits;
+		int slots = (bitLength(n) - 1) / bits;
+		if (slots < 1)
+		{
+			return false;
+		}
+		layout.slots = slots;
+		layout.slotBits = bits;
+		layout.cipherBytes = (bitLength(n * n - 1) + 7) / 8;
+		layout.width = width;
+		layout.maxValue = PIXEL_MAX;
+		layout.slotMax = slots == 1 ? n - 1 : (1ULL << bits) - 1;
+		return true;
+	};
+
+	/**
+	 * \brief Read the layout recorded in the header of a packed image.
+	 * \param const std::string &comment - The first comment line of the header.
+	 * \param uint64_t n - The n parameter of the key the image is decrypted with.
+	 * \param SlotPacking &layout - The layout read.
+	 * \return bool - False if the comment is not a layout, or if the layout cannot come from n.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	static bool fromComment(const std::string &comment, uint64_t n, SlotPacking &layout)
+	{
+		int slots, bits, bytes, width;
+		unsigned long long maxValue = PIXEL_MAX;
+		int fields = sscanf(comment.c_str(), " paillier-slots %d %d %d %d %llu", &slots, &bits, &bytes, &width, &maxValue);
+		if (fields < 4 || width < 1)
+		{
+			return false;
+		}
+		if (!forKey(n, bits - PIXEL_BITS, width, layout))
+		{
+			return false;
+		}
+		if (maxValue < PIXEL_MAX || maxValue > layout.slotMax)
+		{
+			return false;
+		}
+		layout.maxValue = maxValue;
+		return layout.slots == slots && layout.cipherBytes == bytes;
+	};
+
+	/**
+	 * \brief Layout written in the header of a packed image.
+	 * \return std::string - The comment line, without '#'.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	std::string toComment() const
+	{
+		char line[96];
+		int length = snprintf(line, sizeof(line), " paillier-slots %d %d %d %d", slots, slotBits, cipherBytes, width);
+		if (maxValue != PIXEL_MAX)
+		{
+			snprintf(line + length, sizeof(line) - length, " %llu", (unsigned long long)maxValue);
+		}
+		return line;
+	};
+
+	/**
+	 * \brief Layout of an image of sums computed from an image of this layout.
+	 * \param int newWidth - The number of columns of the image of sums.
+	 * \param uint64_t newMaxValue - The largest sum, getSlotMax() at most.
+	 * \return SlotPacking - The layout, with the slots and the ciphertexts of this one.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	SlotPacking forSums(int newWidth, uint64_t newMaxValue) const
+	{
+		SlotPacking layout = *this;
+		layout.width = newWidth;
+		layout.maxValue = newMaxValue;
+		return layout;
+	};
+
+	/**
+	 * \brief Test if two images have the same slots, ciphertexts and width, whatever their sums.
+	 * \param const SlotPacking &other - The layout of the other image.
+	 * \return bool - True if their ciphertexts can be multiplied one by one.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	bool matches(const SlotPacking &other) const
+	{
+		return slots == other.slots && slotBits == other.slotBits && cipherBytes == other.cipherBytes && width == other.width;
+	};
+
+	int getSlots() const { return slots; };
+	int getSlotBits() const { return slotBits; };
+	int getCipherBytes() const { return cipherBytes; };
+	int getWidth() const { return width; };
+	uint64_t getMaxValue() const { return maxValue; };
+	uint64_t getSlotMax() const { return slotMax; };
+
+	/**
+	 * \brief True if the slots hold sums larger than a pixel, decrypted to 16-bit samples.
+	 */
+	bool holdsSums() const { return maxValue > PIXEL_MAX; };
+
+	/**
+	 * \brief Number of ciphertexts of a row.
+	 * \return size_t - ceil(WIDTH / k).
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	size_t groupsPerRow() const
+	{
+		return ((size_t)width + slots - 1) / slots;
+	};
+
+	/**
+	 * \brief Index of the first pixel of a ciphertext in the original image.
+	 * \details The pixels of the ciphertexts [a, b) are the pixels [firstPixel(a), firstPixel(b)),
+	 * firstPixel(rows × groupsPerRow()) being the number of pixels of the image.
+	 * \param size_t cipher - The index of the ciphertext.
+	 * \return size_t - The index of its first pixel.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	size_t firstPixel(size_t cipher) const
+	{
+		size_t groups = groupsPerRow();
+		return (cipher / groups) * width + (cipher % groups) * slots;
+	};
+
+	/**
+	 * \brief Pack pixels into a plaintext.
+	 * \param const uint8_t *pixels - The pixels, one per slot from slot 0.
+	 * \param size_t count - The number of pixels, k at most.
+	 * \return uint64_t - The plaintext.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	uint64_t pack(const uint8_t *pixels, size_t count) const
+	{
+		uint64_t m = 0;
+		for (size_t i = count; i-- > 0;)
+		{
+			m = (m << slotBits) | pixels[i];
+		}
+		return m;
+	};
+
+	/**
+	 * \brief Unpack the pixels of a plaintext.
+	 * \details For the layouts of pixels, a slot above 255, only from a wrong key, gives a white
+	 * pixel. The layouts that hold sums are unpacked by the other unpack.
+	 * \param uint64_t m - The plaintext.
+	 * \param uint8_t *pixels - The pixels, one per slot from slot 0.
+	 * \param size_t count - The number of pixels, k at most.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void unpack(uint64_t m, uint8_t *pixels, size_t count) const
+	{
+		uint64_t mask = (1ULL << slotBits) - 1;
+		for (size_t i = 0; i < count; i++, m >>= slotBits)
+		{
+			uint64_t value = m & mask;
+			pixels[i] = value > 255 ? 255 : static_cast<uint8_t>(value);
+		}
+	};
+
+	/**
+	 * \brief Unpack the sums of a plaintext, without clamping.
+	 * \details A single slot is the whole plaintext, its sum may go beyond SLOT_BITS bits.
+	 * \param uint64_t m - The plaintext.
+	 * \param uint64_t *values - The sums, one per slot from slot 0.
+	 * \param size_t count - The number of sums, k at most.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void unpack(uint64_t m, uint64_t *values, size_t count) const
+	{
+		uint64_t mask = slots == 1 ? UINT64_MAX : (1ULL << slotBits) - 1;
+		for (size_t i = 0; i < count; i++, m >>= slotBits)
+		{
+			values[i] = m & mask;
+		}
+	};
+
+	/**
+	 * \brief Write a ciphertext on B bytes, least significant byte first.
+	 * \param uint64_t c - The ciphertext.
+	 * \param uint8_t *out - The B bytes.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void store(uint64_t c, uint8_t *out) const
+	{
+		for (int i = 0; i < cipherBytes; i++, c >>= 8)
+		{
+			out[i] = static_cast<uint8_t>(c);
+		}
+	};
+
+	/**
+	 * \brief Read a ciphertext written by store.
+	 * \param const uint8_t *in - The B bytes.
+	 * \return uint64_t - The ciphertext.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	uint64_t load(const uint8_t *in) const
+	{
+		uint64_t c = 0;
+		for (int i = cipherBytes; i-- > 0;)
+		{
+			c = (c << 8) | in[i];
+		}
+		return c;
+	};
+};
+
+#endif // PAILLIER_SLOT_PACKING
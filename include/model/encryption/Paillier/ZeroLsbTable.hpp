@@ -0,0 +1,70 @@
+/**
+ * \file ZeroLsbTable.hpp
+ * \brief Header of the table of ciphertexts with zero least significant bits.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ * \details The -olsbr16 and -olsbr32 options keep only the ciphertexts divisible by
+ * 2^k (k = 4 or 5). Encrypting again until the ciphertext fits costs 2^k encryptions
+ * per pixel on average. The ciphertexts of m are the g^m r^n mod n² for r in Z/nZ*,
+ * so for a small n² every one of them can be computed once, and those divisible by
+ * 2^k kept. Encrypting a pixel then draws one of the kept ciphertexts of its value
+ * uniformly, which is the distribution of the rejection loop at the cost of a lookup.
+ */
+
+#ifndef PAILLIER_ZERO_LSB_TABLE
+#define PAILLIER_ZERO_LSB_TABLE
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * \class ZeroLsbTable
+ * \brief Ciphertexts divisible by 2^k of every plaintext m of Z/nZ.
+ * \details The ciphertexts are stored by plaintext in a single array, offsets[m] is
+ * the index of the first ciphertext of m.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ */
+class ZeroLsbTable
+{
+private:
+	std::vector<uint32_t> ciphertexts; //!< Kept ciphertexts, sorted by plaintext.
+	std::vector<uint32_t> offsets;     //!< First ciphertext of each plaintext, n + 1 entries.
+
+public:
+	static const uint64_t MAX_SIZE = 1 << 24; //!< Largest n² supported.
+
+	/**
+	 * \brief Compute the ciphertexts divisible by 2^bitsCompressed of every plaintext.
+	 * \details Costs φ(n) exponentiations for the r^n and n·φ(n) modular products.
+	 * \param uint64_t n - The n parameter of public key.
+	 * \param uint64_t g - The g parameter of public key.
+	 * \param int bitsCompressed - The number k of least significant bits at 0.
+	 * \return bool - False if n² exceeds MAX_SIZE.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	bool build(uint64_t n, uint64_t g, int bitsCompressed);
+
+	/**
+	 * \brief Number of kept ciphertexts of a plaintext.
+	 * \param uint64_t m - The plaintext, m < n.
+	 * \return size_t - The number of ciphertexts of m divisible by 2^k, 0 if m cannot be encrypted.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	size_t count(uint64_t m) const { return offsets[m + 1] - offsets[m]; };
+
+	/**
+	 * \brief Encrypt a plaintext with a random ciphertext divisible by 2^k.
+	 * \details The ciphertext is drawn with the ChaCha20 generator of the calling thread.
+	 * \param uint64_t m - The plaintext, m < n and count(m) > 0.
+	 * \return uint64_t - The ciphertext.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	uint64_t encrypt(uint64_t m) const;
+};
+
+#endif // PAILLIER_ZERO_LSB_TABLE
@@ -9,6 +9,8 @@
  * This class represents the private key used in the Paillier cryptosystem.
  * It contains the lambda and mu values, which are necessary for decryption,
  * and the n value, which is the modulus used in the encryption process.
+ * It can also carry the factorisation of n (p, q, p², q²) and the constants
+ * hp, hq and p⁻¹ mod q used by the CRT decryption.
  */
 
 #ifndef PAILLIER_PRIVATE_KEY
@@ -55,6 +57,23 @@ public:
      */
     PaillierPrivateKey(uint64_t l, uint64_t m, uint64_t n);
 
+    /**
+     * \brief Constructor for the PaillierPrivateKey class with CRT parameters.
+     * \details Initializes lambda, mu, n and the CRT parameters with the given values,
+     * p² and q² are computed from p and q.
+     * \param l The lambda value.
+     * \param m The mu value.
+     * \param nn The n value.
+     * \param pp The first prime factor of n.
+     * \param qq The second prime factor of n.
+     * \param h_p The hp value, L_p(g^(p-1) mod p²)⁻¹ mod p.
+     * \param h_q The hq value, L_q(g^(q-1) mod q²)⁻¹ mod q.
+     * \param p_inv_q The inverse of p modulo q.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    PaillierPrivateKey(uint64_t l, uint64_t m, uint64_t nn, uint64_t pp, uint64_t qq, uint64_t h_p, uint64_t h_q, uint64_t p_inv_q);
+
     /**
      * \brief Getter method for the lambda value.
      * \details Returns the lambda value.
@@ -81,6 +100,72 @@ public:
      */
     uint64_t getN() const;
 
+    /**
+     * \brief Getter method for the p value.
+     * \return The p value, 0 if the key has no CRT parameters.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    uint64_t getP() const;
+
+    /**
+     * \brief Getter method for the q value.
+     * \return The q value, 0 if the key has no CRT parameters.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    uint64_t getQ() const;
+
+    /**
+     * \brief Getter method for the p² value.
+     * \return The p² value.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    uint64_t getP2() const;
+
+    /**
+     * \brief Getter method for the q² value.
+     * \return The q² value.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    uint64_t getQ2() const;
+
+    /**
+     * \brief Getter method for the hp value.
+     * \return The hp value.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    uint64_t getHp() const;
+
+    /**
+     * \brief Getter method for the hq value.
+     * \return The hq value.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    uint64_t getHq() const;
+
+    /**
+     * \brief Getter method for the inverse of p modulo q.
+     * \return The p⁻¹ mod q value.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    uint64_t getPInvQ() const;
+
+    /**
+     * \brief Check if the key carries the CRT parameters.
+     * \details Keys read from files written before the CRT parameters existed only
+     * contain lambda, mu and n.
+     * \return True if the CRT decryption can be used with this key.
+     * \author Katia Auxilien
+     * \date 17 October 2026
+     */
+    bool hasCRT() const;
+
     /**
      * \brief Destructor for the PaillierPrivateKey class.
      * \details Frees any resources used by the class.
@@ -93,6 +178,14 @@ private:
     uint64_t lambda; /*!< Lambda value of the private key */
     uint64_t mu;     /*!< Mu value of the private key */
     uint64_t n;      /*!< n value of the public key */
+    // CRT parameters, kept after lambda, mu and n so that older key files stay readable.
+    uint64_t p;      /*!< First prime factor of n */
+    uint64_t q;      /*!< Second prime factor of n */
+    uint64_t p2;     /*!< p² */
+    uint64_t q2;     /*!< q² */
+    uint64_t hp;     /*!< L_p(g^(p-1) mod p²)⁻¹ mod p */
+    uint64_t hq;     /*!< L_q(g^(q-1) mod q²)⁻¹ mod q */
+    uint64_t p_inv_q; /*!< p⁻¹ mod q */
 };
 
 #endif // PAILLIER_PRIVATE_KEY
\ No newline at end of file
@@ -0,0 +1,121 @@
+/**
+ * \file ChaCha20.hpp
+ * \brief Header of the ChaCha20 cryptographically secure pseudo-random generator.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ * \details The generator runs the ChaCha20 block function (D. J. Bernstein, RFC 8439)
+ * in counter mode on a 256-bit key drawn from std::random_device. It satisfies the
+ * UniformRandomBitGenerator requirements, so it can replace std::mt19937 anywhere, and
+ * each thread gets its own instance with threadInstance().
+ */
+
+#ifndef CHACHA20_GENERATOR
+#define CHACHA20_GENERATOR
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * \class ChaCha20
+ * \brief ChaCha20 keystream used as a source of random 64-bit words.
+ * \details Four blocks (32 words of 64 bits) are generated at once and handed out one
+ * by one. An instance is not thread-safe, use threadInstance() to get the one of the
+ * calling thread.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ */
+class ChaCha20
+{
+private:
+	static const int BLOCKS = 4; //!< Number of blocks generated at once.
+
+	uint32_t state[16];            //!< Constants, key, 64-bit block counter and 64-bit nonce.
+	uint64_t buffer[BLOCKS * 8];   //!< Keystream not handed out yet.
+	unsigned position;             //!< Next word of buffer to hand out.
+
+	/**
+	 * \brief Generate the next BLOCKS blocks of keystream in buffer.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void refill();
+
+public:
+	typedef uint64_t result_type;
+
+	/**
+	 * \brief Construct a generator with a key and a nonce drawn from std::random_device.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	ChaCha20();
+
+	/**
+	 * \brief Construct a generator with a given key, nonce and counter.
+	 * \param const uint32_t key[8] - The 256-bit key.
+	 * \param uint64_t nonce - The nonce.
+	 * \param uint64_t counter - The first block counter.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	ChaCha20(const uint32_t key[8], uint64_t nonce, uint64_t counter = 0);
+
+	static constexpr result_type min() { return 0; };
+	static constexpr result_type max() { return UINT64_MAX; };
+
+	/**
+	 * \brief Next random 64-bit word.
+	 * \return uint64_t - A uniform random word.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	result_type operator()()
+	{
+		if (position == BLOCKS * 8)
+		{
+			refill();
+		}
+		return buffer[position++];
+	};
+
+	/**
+	 * \brief Fill an array with random 64-bit words.
+	 * \param uint64_t *out - The array.
+	 * \param size_t count - The number of words.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void fill(uint64_t *out, size_t count);
+
+	/**
+	 * \brief Uniform random integer in a range, by rejection sampling.
+	 * \details Words are masked to the bit length of max - min and drawn again when they
+	 * exceed it, so no value is favoured and fewer than two words are used on average.
+	 * \param uint64_t min - The minimum value of the range.
+	 * \param uint64_t max - The maximum value of the range, included.
+	 * \return uint64_t - A uniform random integer of [min, max].
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	uint64_t uniform(uint64_t min, uint64_t max);
+
+	/**
+	 * \brief Fill an array with uniform random elements of Z/nZ*.
+	 * \param uint64_t n - The modulus, n > 1.
+	 * \param uint64_t *out - The array.
+	 * \param size_t count - The number of elements.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void fillZNStar(uint64_t n, uint64_t *out, size_t count);
+
+	/**
+	 * \brief Generator of the calling thread.
+	 * \return ChaCha20& - A generator owned by the calling thread, seeded on first use.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	static ChaCha20 &threadInstance();
+};
+
+#endif // CHACHA20_GENERATOR
@@ -0,0 +1,200 @@
+/**
+ * \file PgmView.hpp
+ * \brief Header of the memory-mapped view of a PGM or PPM file.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ * \details The file is mapped in memory with mmap and its header parsed once, the pixels
+ * are then read or written in place in the mapping. An output file is created with its
+ * final size, so the threads encrypting or decrypting an image write their pixels
+ * directly in the file without intermediate buffer. The header and the pixel layout are
+ * those of image_pgm (pixels of more than 8 bits are stored in the byte order of the
+ * processor, compressed images carry the original dimensions before the dimensions).
+ * A PPM file (P6) is viewed the same way, its pixels being 3 interleaved samples. The
+ * first comment line of the header is kept, the packed images record their layout in it.
+ */
+
+#ifndef IMAGE_PGM_VIEW
+#define IMAGE_PGM_VIEW
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+/**
+ * \class PgmView
+ * \brief PGM file mapped in memory, read-only or created for writing.
+ * \details The pixels are accessed through get and set, which copy the bytes of a pixel
+ * so that the payload does not need to be aligned on the size of a pixel.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ */
+class PgmView
+{
+private:
+	uint8_t *mapping;    //!< Start of the mapped file.
+	size_t mappingSize;  //!< Size of the mapped file in bytes.
+	size_t headerSize;   //!< Offset of the first pixel.
+	int fd;              //!< File descriptor of the mapped file.
+	int width;           //!< Number of columns.
+	int height;          //!< Number of rows.
+	int originalWidth;   //!< Number of columns of the original image (compressed images).
+	int originalHeight;  //!< Number of rows of the original image (compressed images).
+	int channels;        //!< Samples per pixel, 1 for a PGM file (P5), 3 for a PPM file (P6).
+	uint64_t maxValue;   //!< Maximum value of the header.
+	std::string comment; //!< First comment line of the header, without '#', empty if none.
+
+	/**
+	 * \brief Parse the header of the mapped file.
+	 * \param bool compressed - True if the header carries the original dimensions.
+	 * \param int expectedChannels - 1 for a PGM file, 3 for a PPM file.
+	 * \return bool - False if the header is malformed or of the other format.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	bool parseHeader(bool compressed, int expectedChannels);
+
+public:
+	/**
+	 * \brief Construct a view of no file.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	PgmView();
+
+	/**
+	 * \brief Unmap and close the file.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	~PgmView();
+
+	PgmView(const PgmView &) = delete;
+	PgmView &operator=(const PgmView &) = delete;
+
+	/**
+	 * \brief Map an existing PGM file for reading.
+	 * \param const char *path - The file.
+	 * \param size_t bytesPerPixel - The size of a sample, 1, 2, 4 or 8.
+	 * \param bool compressed - True for a compressed image, whose header carries the original dimensions.
+	 * \param int channels - 1 to expect a PGM file, 3 to expect a PPM file.
+	 * \return bool - False if the file cannot be mapped, its header is malformed or it is too short.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	bool open(const char *path, size_t bytesPerPixel, bool compressed = false, int channels = 1);
+
+	/**
+	 * \brief Create a PGM file of its final size and map it for writing.
+	 * \param const char *path - The file, replaced if it exists.
+	 * \param int height - The number of rows.
+	 * \param int width - The number of columns.
+	 * \param uint64_t maxValue - The maximum value written in the header.
+	 * \param size_t payloadSize - The size of the pixels in bytes.
+	 * \param int originalHeight - The number of rows of the original image, 0 for an image that is not compressed.
+	 * \param int originalWidth - The number of columns of the original image.
+	 * \param int channels - 1 to create a PGM file, 3 to create a PPM file.
+	 * \param const std::string &comment - A line written as a comment after the magic number, empty for none.
+	 * \return bool - False if the file cannot be created or mapped.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	bool create(const char *path, int height, int width, uint64_t maxValue, size_t payloadSize, int originalHeight = 0, int originalWidth = 0, int channels = 1, const std::string &comment = "");
+
+	/**
+	 * \brief Unmap and close the file, the view is then empty.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void close();
+
+	int getWidth() const { return width; };
+	int getHeight() const { return height; };
+	int getOriginalWidth() const { return originalWidth; };
+	int getOriginalHeight() const { return originalHeight; };
+	int getChannels() const { return channels; };
+	uint64_t getMaxValue() const { return maxValue; };
+	const std::string &getComment() const { return comment; };
+
+	/**
+	 * \brief Pixels of the file.
+	 * \return uint8_t* - The first byte of the first pixel.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	uint8_t *data() const { return mapping + headerSize; };
+
+	/**
+	 * \brief Size of the pixels of the file.
+	 * \return size_t - The size in bytes.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	size_t dataSize() const { return mappingSize - headerSize; };
+
+	/**
+	 * \brief Release the pages of a range of pixels already processed.
+	 * \details The pages are dropped from the memory of the process, the written pixels stay
+	 * in the file, so the memory used while streaming an image is bounded by the range processed.
+	 * Only the pages entirely inside the range are released, the pages shared with the
+	 * neighbouring ranges may still be in use.
+	 * \param size_t offset - The first byte of the range, from the first pixel.
+	 * \param size_t length - The size of the range in bytes.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void release(size_t offset, size_t length);
+
+	/**
+	 * \brief Load the pages of a range of pixels from the file.
+	 * \details Every page of the range is read once, so the calling thread waits for the disk
+	 * instead of the threads processing the pixels afterwards.
+	 * \param size_t offset - The first byte of the range, from the first pixel.
+	 * \param size_t length - The size of the range in bytes.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void prefetch(size_t offset, size_t length) const;
+
+	/**
+	 * \brief Write the pages of a range of pixels to the file, and wait for the end.
+	 * \param size_t offset - The first byte of the range, from the first pixel.
+	 * \param size_t length - The size of the range in bytes.
+	 * \return bool - False if the pages could not be written.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	bool flush(size_t offset, size_t length);
+
+	/**
+	 * \brief Read a pixel.
+	 * \tparam T The type of the pixels.
+	 * \param size_t i - The index of the pixel.
+	 * \return T - The pixel.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	template <typename T>
+	T get(size_t i) const
+	{
+		T pixel;
+		memcpy(&pixel, data() + i * sizeof(T), sizeof(T));
+		return pixel;
+	};
+
+	/**
+	 * \brief Write a pixel.
+	 * \tparam T The type of the pixels.
+	 * \param size_t i - The index of the pixel.
+	 * \param T pixel - The pixel.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	template <typename T>
+	void set(size_t i, T pixel)
+	{
+		memcpy(data() + i * sizeof(T), &pixel, sizeof(T));
+	};
+};
+
+#endif // IMAGE_PGM_VIEW
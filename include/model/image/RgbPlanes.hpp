@@ -0,0 +1,202 @@
+/**
+ * \file RgbPlanes.hpp
+ * \brief Separation of the interleaved samples of a colour image into its R, G and B planes, and back.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ * \details The pixels of a PPM image are stored R G B R G B..., the planes are split in a
+ * single pass over the image instead of one strided loop per plane (image_ppm::planR, planV
+ * and planB). With SSSE3, 16 pixels (48 bytes) are loaded in three registers and each plane
+ * is gathered with three byte shuffles (pshufb) combined by or; the inverse pass builds the
+ * three output registers the same way from the planes. Without SSSE3 the pass is scalar.
+ */
+
+#ifndef IMAGE_RGB_PLANES
+#define IMAGE_RGB_PLANES
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define RGB_PLANES_SSSE3
+#endif
+
+/**
+ * \class RgbPlanes
+ * \brief Deinterleaving and interleaving of 8-bit RGB samples.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ */
+class RgbPlanes
+{
+private:
+	static void deinterleaveGeneric(const uint8_t *rgb, size_t begin, size_t count, uint8_t *r, uint8_t *g, uint8_t *b)
+	{
+		for (size_t i = begin; i < count; i++)
+		{
+			r[i] = rgb[3 * i];
+			g[i] = rgb[3 * i + 1];
+			b[i] = rgb[3 * i + 2];
+		}
+	};
+
+	static void interleaveGeneric(const uint8_t *r, const uint8_t *g, const uint8_t *b, size_t begin, size_t count, uint8_t *rgb)
+	{
+		for (size_t i = begin; i < count; i++)
+		{
+			rgb[3 * i] = r[i];
+			rgb[3 * i + 1] = g[i];
+			rgb[3 * i + 2] = b[i];
+		}
+	};
+
+#ifdef RGB_PLANES_SSSE3
+	/**
+	 * \brief Shuffle gathering the samples of a plane found in a 16-byte chunk of 16 pixels.
+	 * \details Byte j of the plane is byte 3j + channel of the 48 bytes, it is taken from the
+	 * chunk holding it and zeroed (0x80) in the shuffles of the two other chunks.
+	 * \param int channel - 0 for R, 1 for G, 2 for B.
+	 * \param int chunk - 0, 1 or 2, the 16-byte chunk of the 48 bytes.
+	 * \return __m128i - The shuffle.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	static __m128i deinterleaveMask(int channel, int chunk)
+	{
+		alignas(16) uint8_t mask[16];
+		for (int j = 0; j < 16; j++)
+		{
+			int source = 3 * j + channel;
+			mask[j] = source / 16 == chunk ? source % 16 : 0x80;
+		}
+		return _mm_load_si128(reinterpret_cast<const __m128i *>(mask));
+	};
+
+	/**
+	 * \brief Shuffle placing the samples of a plane in a 16-byte chunk of 16 interleaved pixels.
+	 * \details Byte p of chunk k is byte 16k + p of the 48 bytes, the sample (16k + p) % 3 of
+	 * the pixel (16k + p) / 3, it is zeroed (0x80) in the shuffles of the two other planes.
+	 * \param int channel - 0 for R, 1 for G, 2 for B.
+	 * \param int chunk - 0, 1 or 2, the 16-byte chunk of the 48 bytes.
+	 * \return __m128i - The shuffle.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	static __m128i interleaveMask(int channel, int chunk)
+	{
+		alignas(16) uint8_t mask[16];
+		for (int p = 0; p < 16; p++)
+		{
+			int target = 16 * chunk + p;
+			mask[p] = target % 3 == channel ? target / 3 : 0x80;
+		}
+		return _mm_load_si128(reinterpret_cast<const __m128i *>(mask));
+	};
+
+	__attribute__((target("ssse3"))) static void deinterleaveSSSE3(const uint8_t *rgb, size_t count, uint8_t *r, uint8_t *g, uint8_t *b)
+	{
+		uint8_t *planes[3] = {r, g, b};
+		__m128i masks[3][3];
+		for (int channel = 0; channel < 3; channel++)
+		{
+			for (int chunk = 0; chunk < 3; chunk++)
+			{
+				masks[channel][chunk] = deinterleaveMask(channel, chunk);
+			}
+		}
+
+		size_t i = 0;
+		for (; i + 16 <= count; i += 16)
+		{
+			__m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rgb + 3 * i));
+			__m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rgb + 3 * i + 16));
+			__m128i a2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rgb + 3 * i + 32));
+			for (int channel = 0; channel < 3; channel++)
+			{
+				__m128i plane = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a0, masks[channel][0]), _mm_shuffle_epi8(a1, masks[channel][1])), _mm_shuffle_epi8(a2, masks[channel][2]));
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(planes[channel] + i), plane);
+			}
+		}
+		deinterleaveGeneric(rgb, i, count, r, g, b);
+	};
+
+	__attribute__((target("ssse3"))) static void interleaveSSSE3(const uint8_t *r, const uint8_t *g, const uint8_t *b, size_t count, uint8_t *rgb)
+	{
+		__m128i masks[3][3];
+		for (int channel = 0; channel < 3; channel++)
+		{
+			for (int chunk = 0; chunk < 3; chunk++)
+			{
+				masks[channel][chunk] = interleaveMask(channel, chunk);
+			}
+		}
+
+		size_t i = 0;
+		for (; i + 16 <= count; i += 16)
+		{
+			__m128i pr = _mm_loadu_si128(reinterpret_cast<const __m128i *>(r + i));
+			__m128i pg = _mm_loadu_si128(reinterpret_cast<const __m128i *>(g + i));
+			__m128i pb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+			for (int chunk = 0; chunk < 3; chunk++)
+			{
+				__m128i out = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(pr, masks[0][chunk]), _mm_shuffle_epi8(pg, masks[1][chunk])), _mm_shuffle_epi8(pb, masks[2][chunk]));
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(rgb + 3 * i + 16 * chunk), out);
+			}
+		}
+		interleaveGeneric(r, g, b, i, count, rgb);
+	};
+
+	static bool hasSSSE3()
+	{
+		static const bool supported = __builtin_cpu_supports("ssse3");
+		return supported;
+	};
+#endif
+
+public:
+	/**
+	 * \brief Split interleaved RGB pixels into three planes.
+	 * \param const uint8_t *rgb - The 3 * count interleaved samples.
+	 * \param size_t count - The number of pixels.
+	 * \param uint8_t *r - The count samples of the R plane.
+	 * \param uint8_t *g - The count samples of the G plane.
+	 * \param uint8_t *b - The count samples of the B plane.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	static void deinterleave(const uint8_t *rgb, size_t count, uint8_t *r, uint8_t *g, uint8_t *b)
+	{
+#ifdef RGB_PLANES_SSSE3
+		if (hasSSSE3())
+		{
+			deinterleaveSSSE3(rgb, count, r, g, b);
+			return;
+		}
+#endif
+		deinterleaveGeneric(rgb, 0, count, r, g, b);
+	};
+
+	/**
+	 * \brief Merge three planes into interleaved RGB pixels.
+	 * \param const uint8_t *r - The count samples of the R plane.
+	 * \param const uint8_t *g - The count samples of the G plane.
+	 * \param const uint8_t *b - The count samples of the B plane.
+	 * \param size_t count - The number of pixels.
+	 * \param uint8_t *rgb - The 3 * count interleaved samples.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	static void interleave(const uint8_t *r, const uint8_t *g, const uint8_t *b, size_t count, uint8_t *rgb)
+	{
+#ifdef RGB_PLANES_SSSE3
+		if (hasSSSE3())
+		{
+			interleaveSSSE3(r, g, b, count, rgb);
+			return;
+		}
+#endif
+		interleaveGeneric(r, g, b, 0, count, rgb);
+	};
+};
+
+#endif // IMAGE_RGB_PLANES
@@ -0,0 +1,40 @@
+/**
+ * \file DaemonProtocol.hpp
+ * \brief Requests and replies exchanged by the encryption daemon and its clients.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ * \details A client sends requests on the Unix socket of the daemon, one line each, and
+ * gets a reply line for each of them, in order :
+ *
+ *     ENCRYPT [-d] [-hexp] [-olsbr32|-olsbr16] FILE.pgm   ->  OK FILE_E.pgm
+ *     DECRYPT [-d] [-olsbr32|-olsbr16] FILE_E.pgm         ->  OK FILE_E_D.pgm
+ *     ENCRYPT_PIXELS COUNT + COUNT bytes                  ->  OK 2*COUNT + 2*COUNT bytes
+ *     DECRYPT_PIXELS COUNT + 2*COUNT bytes                ->  OK COUNT + COUNT bytes
+ *     SHUTDOWN                                            ->  OK
+ *
+ * The images are given by absolute paths, the daemon does not run in the directory of its
+ * clients. The encrypted pixels of a buffer are 16 bits little-endian. A request that fails gets
+ * ERROR followed by the reason, the connection can still be used.
+ */
+
+#ifndef NETWORK_DAEMON_PROTOCOL
+#define NETWORK_DAEMON_PROTOCOL
+
+#include <cstddef>
+
+namespace DaemonProtocol
+{
+	static const char *const DEFAULT_SOCKET = "/tmp/PaillierPgm.sock"; //!< Socket of the daemon when none is specified.
+	static const size_t MAX_PIXELS = (size_t)1 << 26;                 //!< Largest pixel buffer of a request.
+
+	static const char *const ENCRYPT = "ENCRYPT";               //!< Encrypt an image file.
+	static const char *const DECRYPT = "DECRYPT";               //!< Decrypt an image file.
+	static const char *const ENCRYPT_PIXELS = "ENCRYPT_PIXELS"; //!< Encrypt a buffer of 8-bit pixels.
+	static const char *const DECRYPT_PIXELS = "DECRYPT_PIXELS"; //!< Decrypt a buffer of 16-bit encrypted pixels.
+	static const char *const SHUTDOWN = "SHUTDOWN";             //!< Stop the daemon once its connected clients are gone.
+
+	static const char *const OK = "OK";       //!< Start of a reply to a request done.
+	static const char *const ERROR = "ERROR"; //!< Start of a reply to a request that failed.
+}
+
+#endif // NETWORK_DAEMON_PROTOCOL
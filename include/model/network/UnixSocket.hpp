@@ -0,0 +1,148 @@
+/**
+ * \file UnixSocket.hpp
+ * \brief Header of the local stream socket between the encryption daemon and its clients.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ * \details A request or a reply is a line of text, followed for the pixel buffers by the
+ * bytes announced in the line. The lines are read through a buffer kept in the socket, so
+ * the bytes following a line are not lost and are returned by the next readExact.
+ */
+
+#ifndef NETWORK_UNIX_SOCKET
+#define NETWORK_UNIX_SOCKET
+
+#include <cstddef>
+#include <string>
+
+/**
+ * \class UnixSocket
+ * \brief Unix domain stream socket, listening or connected, closed at its destruction.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ */
+class UnixSocket
+{
+private:
+	int fd;             //!< File descriptor of the socket, -1 if closed.
+	std::string buffer; //!< Bytes received and not consumed yet.
+
+	/**
+	 * \brief Receive more bytes in the buffer.
+	 * \return bool - False at the end of the stream or on error.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	bool fill();
+
+public:
+	/**
+	 * \brief Construct a closed socket.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	UnixSocket();
+
+	/**
+	 * \brief Take ownership of a connected socket.
+	 * \param int fd - The file descriptor.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	explicit UnixSocket(int fd);
+
+	/**
+	 * \brief Close the socket.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	~UnixSocket();
+
+	UnixSocket(const UnixSocket &) = delete;
+	UnixSocket &operator=(const UnixSocket &) = delete;
+	UnixSocket(UnixSocket &&other);
+	UnixSocket &operator=(UnixSocket &&other);
+
+	/**
+	 * \brief Bind the socket to a path and listen for connections.
+	 * \details A file left at the path by a previous daemon is removed first.
+	 * \param const char *path - The path of the socket.
+	 * \return bool - False if the path is too long or the socket cannot be bound.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	bool listen(const char *path);
+
+	/**
+	 * \brief Connect to a listening socket.
+	 * \param const char *path - The path of the socket.
+	 * \return bool - False if no daemon listens at the path.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	bool connect(const char *path);
+
+	/**
+	 * \brief Wait for a connection on a listening socket.
+	 * \return UnixSocket - The connected socket, closed if the listening socket was shut down.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	UnixSocket accept();
+
+	/**
+	 * \brief Wake up the threads blocked on the socket, accept or read then fail.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void shutdown();
+
+	/**
+	 * \brief Close the socket.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void close();
+
+	bool isOpen() const { return fd >= 0; };
+
+	/**
+	 * \brief Read a line, without its end of line.
+	 * \param std::string &line - The line read.
+	 * \param size_t maxLength - The longest line accepted.
+	 * \return bool - False at the end of the stream, on error or if the line is too long.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	bool readLine(std::string &line, size_t maxLength = 4096);
+
+	/**
+	 * \brief Read exactly size bytes.
+	 * \param void *data - The bytes read.
+	 * \param size_t size - The number of bytes.
+	 * \return bool - False if the stream ends before.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	bool readExact(void *data, size_t size);
+
+	/**
+	 * \brief Write all the bytes, the peer closing the connection does not raise SIGPIPE.
+	 * \param const void *data - The bytes.
+	 * \param size_t size - The number of bytes.
+	 * \return bool - False if the connection is closed.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	bool writeAll(const void *data, size_t size);
+
+	/**
+	 * \brief Write a line, its end of line added.
+	 * \param const std::string &line - The line.
+	 * \return bool - False if the connection is closed.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	bool writeLine(const std::string &line);
+};
+
+#endif // NETWORK_UNIX_SOCKET
@@ -0,0 +1,104 @@
+/**
+ * \file BoundedQueue.hpp
+ * \brief Blocking queue of bounded capacity between the stages of a pipeline.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ * \details A producer blocks while the queue is full, so a fast stage cannot run more
+ * than the capacity ahead of the next one, which bounds the memory held between them.
+ */
+
+#ifndef PARALLEL_BOUNDED_QUEUE
+#define PARALLEL_BOUNDED_QUEUE
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <queue>
+
+/**
+ * \class BoundedQueue
+ * \brief Queue of at most capacity elements, closed by the producer once it is done.
+ * \tparam T The type of the elements.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ */
+template <typename T>
+class BoundedQueue
+{
+private:
+	std::queue<T> elements;            //!< Elements waiting for the consumer.
+	size_t capacity;                   //!< Maximum number of elements.
+	bool closed;                       //!< True once the producer pushed its last element.
+	std::mutex mutex;                  //!< Protects elements and closed.
+	std::condition_variable notFull;   //!< Signals a pop.
+	std::condition_variable notEmpty;  //!< Signals a push or the closing.
+
+public:
+	/**
+	 * \brief Construct an empty queue.
+	 * \param size_t capacity - The maximum number of elements, at least 1.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	explicit BoundedQueue(size_t capacity) : capacity(capacity < 1 ? 1 : capacity), closed(false) {};
+
+	BoundedQueue(const BoundedQueue &) = delete;
+	BoundedQueue &operator=(const BoundedQueue &) = delete;
+
+	/**
+	 * \brief Add an element, waiting while the queue is full.
+	 * \param T element - The element.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void push(T element)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			notFull.wait(lock, [this]
+						 { return elements.size() < capacity; });
+			elements.push(std::move(element));
+		}
+		notEmpty.notify_one();
+	};
+
+	/**
+	 * \brief Take the oldest element, waiting while the queue is empty and not closed.
+	 * \param T &element - The element taken.
+	 * \return bool - False if the queue is closed and empty, there is no more element.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	bool pop(T &element)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			notEmpty.wait(lock, [this]
+						  { return closed || !elements.empty(); });
+			if (elements.empty())
+			{
+				return false;
+			}
+			element = std::move(elements.front());
+			elements.pop();
+		}
+		notFull.notify_one();
+		return true;
+	};
+
+	/**
+	 * \brief Signal that no element will be pushed any more.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void close()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			closed = true;
+		}
+		notEmpty.notify_all();
+	};
+};
+
+#endif // PARALLEL_BOUNDED_QUEUE
@@ -0,0 +1,201 @@
+/**
+ * \file Pipeline.hpp
+ * \brief Three-stage pipeline reading, processing and writing the bands of an image.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ * \details A reader thread loads the bands of the input, the calling thread processes them
+ * (with the thread pool for the modular exponentiations) and a writer thread stores them,
+ * so while a band is encrypted or decrypted the next one is read and the previous one is
+ * written. The stages exchange bands through bounded queues, at most depth bands wait
+ * between two stages. Each stage counts its bands, its pixels and the time it spends
+ * working, to give its throughput.
+ *
+ * An exception thrown by a stage stops the reading of new bands, the bands already read
+ * go through the queues without being processed nor written, and the exception is thrown
+ * again by run once the threads are joined.
+ */
+
+#ifndef PARALLEL_PIPELINE
+#define PARALLEL_PIPELINE
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "BoundedQueue.hpp"
+
+/**
+ * \class Pipeline
+ * \brief Runs the read, process and write stages over the bands [first, last) of a range.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ */
+class Pipeline
+{
+public:
+	/**
+	 * \struct StageStats
+	 * \brief Counters of a stage.
+	 */
+	struct StageStats
+	{
+		uint64_t bands;  //!< Number of bands processed.
+		uint64_t pixels; //!< Number of pixels processed.
+		double seconds;  //!< Time spent working, waits on the queues excluded.
+
+		/** Pixels per second while working, 0 if the stage did not work. */
+		double throughput() const { return seconds > 0 ? pixels / seconds : 0; };
+	};
+
+	static const int READ = 0;    //!< Index of the reader stage.
+	static const int PROCESS = 1; //!< Index of the processing stage.
+	static const int WRITE = 2;   //!< Index of the writer stage.
+
+private:
+	typedef std::pair<size_t, size_t> Band;
+
+	size_t depth;          //!< Capacity of the queues between the stages.
+	StageStats stats[3];   //!< Counters of the reader, processing and writer stages.
+	std::exception_ptr failure; //!< First exception thrown by a stage, null if none.
+	std::mutex failureMutex;    //!< Protects failure.
+
+	/**
+	 * \brief True once a stage threw an exception.
+	 */
+	bool hasFailed()
+	{
+		std::lock_guard<std::mutex> lock(failureMutex);
+		return failure != nullptr;
+	};
+
+	/**
+	 * \brief Run a stage on a band unless a stage already failed, and keep its exception.
+	 * \return bool - False if a stage failed.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	template <typename F>
+	bool runGuarded(F &f, const Band &band, StageStats &stage)
+	{
+		if (hasFailed())
+		{
+			return false;
+		}
+		try
+		{
+			runStage(f, band, stage);
+			return true;
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(failureMutex);
+			if (!failure)
+			{
+				failure = std::current_exception();
+			}
+			return false;
+		}
+	};
+
+	/**
+	 * \brief Run a stage on a band and update its counters.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	template <typename F>
+	static void runStage(F &f, const Band &band, StageStats &stage)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		f(band.first, band.second);
+		stage.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		stage.bands++;
+		stage.pixels += band.second - band.first;
+	};
+
+public:
+	/**
+	 * \brief Construct a pipeline.
+	 * \param size_t depth - The number of bands that can wait between two stages.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	explicit Pipeline(size_t depth = 2) : depth(depth)
+	{
+		for (StageStats &stage : stats)
+		{
+			stage = StageStats{0, 0, 0};
+		}
+	};
+
+	/**
+	 * \brief Counters of a stage, after run.
+	 * \param int stage - READ, PROCESS or WRITE.
+	 * \return const StageStats& - The counters.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	const StageStats &getStats(int stage) const { return stats[stage]; };
+
+	/**
+	 * \brief Read, process and write the bands of [0, count), and wait for the end.
+	 * \details Every band goes through read, process and write in this order, the bands
+	 * go through each stage in order. read runs on a reader thread, process on the calling
+	 * thread and write on a writer thread. The first exception of a stage is thrown again
+	 * at the end.
+	 * \tparam R Callable as read(size_t first, size_t last).
+	 * \tparam P Callable as process(size_t first, size_t last).
+	 * \tparam W Callable as write(size_t first, size_t last).
+	 * \param size_t count - The number of pixels.
+	 * \param size_t band - The number of pixels of a band.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	template <typename R, typename P, typename W>
+	void run(size_t count, size_t band, R read, P process, W write)
+	{
+		BoundedQueue<Band> toProcess(depth);
+		BoundedQueue<Band> toWrite(depth);
+
+		std::thread reader([&]
+						   {
+			for (size_t first = 0; first < count; first += band)
+			{
+				Band current(first, first + band < count ? first + band : count);
+				if (!runGuarded(read, current, stats[READ]))
+				{
+					break;
+				}
+				toProcess.push(current);
+			}
+			toProcess.close(); });
+
+		std::thread writer([&]
+						   {
+			Band current;
+			while (toWrite.pop(current))
+			{
+				runGuarded(write, current, stats[WRITE]);
+			} });
+
+		Band current;
+		while (toProcess.pop(current))
+		{
+			runGuarded(process, current, stats[PROCESS]);
+			toWrite.push(current);
+		}
+		toWrite.close();
+
+		reader.join();
+		writer.join();
+		if (failure)
+		{
+			std::rethrow_exception(failure);
+		}
+	};
+};
+
+#endif // PARALLEL_PIPELINE
@@ -0,0 +1,219 @@
+/**
+ * \file ThreadPool.hpp
+ * \brief Pool of worker threads used to process the pixels of an image in parallel.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ * \details The pixels of an image are encrypted and decrypted independently, so a loop
+ * over the pixels is split in blocks handed out to the workers. The calling thread takes
+ * part in the loop, so a pool of one thread runs everything inline.
+ */
+
+#ifndef PARALLEL_THREAD_POOL
+#define PARALLEL_THREAD_POOL
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/**
+ * \class ThreadPool
+ * \brief Fixed set of worker threads executing tasks from a shared queue.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ */
+class ThreadPool
+{
+private:
+	std::vector<std::thread> workers;        //!< Worker threads, the calling thread is not one of them.
+	std::queue<std::function<void()>> tasks; //!< Tasks waiting for a worker.
+	std::mutex mutex;                        //!< Protects tasks and stop.
+	std::condition_variable cond;            //!< Signals a new task or the stop.
+	bool stop;                               //!< Asks the workers to terminate.
+
+	/**
+	 * \brief Main loop of a worker thread.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void work()
+	{
+		while (true)
+		{
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				cond.wait(lock, [this]
+						  { return stop || !tasks.empty(); });
+				if (stop && tasks.empty())
+				{
+					return;
+				}
+				task = std::move(tasks.front());
+				tasks.pop();
+			}
+			task();
+		}
+	};
+
+public:
+	/**
+	 * \brief Construct a pool.
+	 * \param unsigned threads - The number of threads taking part in a loop, calling thread
+	 * included, 0 for the number of cores.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	explicit ThreadPool(unsigned threads = 1) : stop(false)
+	{
+		if (threads == 0)
+		{
+			threads = std::thread::hardware_concurrency();
+		}
+		for (unsigned i = 1; i < threads; i++)
+		{
+			workers.emplace_back(&ThreadPool::work, this);
+		}
+	};
+
+	/**
+	 * \brief Destroy the pool, once the queued tasks are done.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stop = true;
+		}
+		cond.notify_all();
+		for (std::thread &worker : workers)
+		{
+			worker.join();
+		}
+	};
+
+	ThreadPool(const ThreadPool &) = delete;
+	ThreadPool &operator=(const ThreadPool &) = delete;
+
+	/**
+	 * \brief Number of threads taking part in a loop.
+	 * \return unsigned - The number of workers plus the calling thread.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	unsigned getThreadCount() const { return workers.size() + 1; };
+
+	/**
+	 * \brief Queue a task for the workers.
+	 * \param std::function<void()> task - The task.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	void submit(std::function<void()> task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			tasks.push(std::move(task));
+		}
+		cond.notify_one();
+	};
+
+	/**
+	 * \brief Run one queued task on the calling thread.
+	 * \return bool - False if there was no queued task.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	bool runPendingTask()
+	{
+		std::function<void()> task;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (tasks.empty())
+			{
+				return false;
+			}
+			task = std::move(tasks.front());
+			tasks.pop();
+		}
+		task();
+		return true;
+	};
+
+	/**
+	 * \brief Run a loop over [0, count) split in blocks, and wait for its end.
+	 * \details With one thread the whole range is a single block. Otherwise the range is
+	 * split in about 8 blocks per thread, taken in order by the workers and the calling
+	 * thread, so uneven blocks balance out. While it waits for the end of the blocks taken
+	 * by the workers, the calling thread runs the queued tasks, so a loop can be run from a
+	 * task of the pool, e.g. one task per image and a loop over the pixels of each image.
+	 * \tparam F Callable as f(size_t begin, size_t end).
+	 * \param size_t count - The number of iterations.
+	 * \param F f - The body of the loop, called on disjoint blocks [begin, end).
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	template <typename F>
+	void parallelFor(size_t count, F f)
+	{
+		unsigned threads = getThreadCount();
+		if (threads == 1 || count < 2)
+		{
+			f(0, count);
+			return;
+		}
+
+		size_t blocks = (size_t)threads * 8 < count ? (size_t)threads * 8 : count;
+		size_t blockSize = (count + blocks - 1) / blocks;
+		std::atomic<size_t> next(0);
+		size_t helpers = workers.size();
+		size_t finished = 0;
+		std::mutex doneMutex;
+		std::condition_variable done;
+
+		auto run = [&]()
+		{
+			for (size_t begin = next.fetch_add(blockSize); begin < count; begin = next.fetch_add(blockSize))
+			{
+				f(begin, begin + blockSize < count ? begin + blockSize : count);
+			}
+		};
+
+		for (size_t i = 0; i < helpers; i++)
+		{
+			submit([&]()
+				   {
+				run();
+				std::lock_guard<std::mutex> lock(doneMutex);
+				finished++;
+				done.notify_one(); });
+		}
+		run();
+
+		while (true)
+		{
+			{
+				std::lock_guard<std::mutex> lock(doneMutex);
+				if (finished == helpers)
+				{
+					return;
+				}
+			}
+			if (!runPendingTask())
+			{
+				// The remaining helpers are running on other threads.
+				std::unique_lock<std::mutex> lock(doneMutex);
+				done.wait(lock, [&]
+						  { return finished == helpers; });
+				return;
+			}
+		}
+	};
+};
+
+#endif // PARALLEL_THREAD_POOL
@@ -0,0 +1,174 @@
+/**
+ * \file Profiler.hpp
+ * \brief Time spent in each stage of the processing of an image, and event counters.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ * \details The stages are timed with scoped timers placed around whole blocks of pixels,
+ * never around a single pixel, and the counters are accumulated locally then added once
+ * per block, so the profiling does not slow down the loops it measures. The times are
+ * summed over the threads, a stage run by 4 threads for 1 s counts 4 s.
+ *
+ * The macros PROFILE_STAGE and PROFILE_COUNT record only when PAILLIER_PROFILING is
+ * defined (make PROFILING=1, the default), otherwise they compile to nothing.
+ */
+
+#ifndef PROFILING_PROFILER
+#define PROFILING_PROFILER
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * \class Profiler
+ * \brief Process-wide totals of the stages and of the counters.
+ * \author Katia Auxilien
+ * \date 17 October 2026
+ */
+class Profiler
+{
+public:
+	/**
+	 * \enum Stage
+	 * \brief Stages of the processing of an image.
+	 */
+	enum Stage
+	{
+		HEADER,     //!< Parsing of the PGM headers.
+		READ,       //!< Reading of the pixels from the disk.
+		HISTOGRAM,  //!< Histogram expansion of the pixels before encryption.
+		ENCRYPTION, //!< Encryption of the pixels, drawing of the noise included.
+		DECRYPTION, //!< Decryption of the pixels.
+		EVALUATION, //!< Homomorphic operations on the encrypted pixels (eval mode).
+		PACKING,    //!< Packing and unpacking of the bits of the compressed images.
+		PLANES,     //!< Splitting and merging of the R, G and B planes of the colour images.
+		WRITE,      //!< Writing of the pixels to the disk.
+		STAGE_COUNT
+	};
+
+	/**
+	 * \enum Counter
+	 * \brief Events counted during the processing.
+	 */
+	enum Counter
+	{
+		PIXELS_ENCRYPTED,    //!< Pixels encrypted.
+		PIXELS_DECRYPTED,    //!< Pixels decrypted.
+		REENCRYPTIONS,       //!< Encryptions done again because the LSB of the ciphertext were not 0.
+		GCD_REJECTIONS,      //!< Random r of randomZNStar rejected because gcd(r, n) != 1.
+		COUNTER_COUNT
+	};
+
+	/**
+	 * \class Timer
+	 * \brief Adds the time between its construction and its destruction to a stage.
+	 */
+	class Timer
+	{
+	private:
+		Stage stage;
+		std::chrono::steady_clock::time_point start;
+
+	public:
+		explicit Timer(Stage stage) : stage(stage), start(std::chrono::steady_clock::now()) {};
+		~Timer()
+		{
+			addTime(stage, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+		};
+		Timer(const Timer &) = delete;
+		Timer &operator=(const Timer &) = delete;
+	};
+
+private:
+	/**
+	 * \struct Totals
+	 * \brief Totals shared by the threads.
+	 */
+	struct Totals
+	{
+		std::atomic<uint64_t> nanoseconds[STAGE_COUNT];
+		std::atomic<uint64_t> calls[STAGE_COUNT];
+		std::atomic<uint64_t> counters[COUNTER_COUNT];
+	};
+
+	static Totals &totals()
+	{
+		static Totals instance = {};
+		return instance;
+	};
+
+public:
+	/**
+	 * \brief True if the program records the stages and the counters.
+	 * \return bool - False if it is compiled without PAILLIER_PROFILING.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	static bool isEnabled()
+	{
+#ifdef PAILLIER_PROFILING
+		return true;
+#else
+		return false;
+#endif
+	};
+
+	/**
+	 * \brief Add a run of a stage.
+	 * \param Stage stage - The stage.
+	 * \param uint64_t nanoseconds - The time of the run.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	static void addTime(Stage stage, uint64_t nanoseconds)
+	{
+		totals().nanoseconds[stage].fetch_add(nanoseconds, std::memory_order_relaxed);
+		totals().calls[stage].fetch_add(1, std::memory_order_relaxed);
+	};
+
+	/**
+	 * \brief Add events to a counter.
+	 * \param Counter counter - The counter.
+	 * \param uint64_t value - The number of events.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	static void count(Counter counter, uint64_t value)
+	{
+		if (value != 0)
+		{
+			totals().counters[counter].fetch_add(value, std::memory_order_relaxed);
+		}
+	};
+
+	static double getSeconds(Stage stage) { return totals().nanoseconds[stage].load() / 1e9; };
+	static uint64_t getCalls(Stage stage) { return totals().calls[stage].load(); };
+	static uint64_t getCount(Counter counter) { return totals().counters[counter].load(); };
+
+	/**
+	 * \brief Name of a stage, for the reports.
+	 * \param Stage stage - The stage.
+	 * \return const char* - The name.
+	 * \author Katia Auxilien
+	 * \date 17 October 2026
+	 */
+	static const char *getName(Stage stage)
+	{
+		static const char *const names[STAGE_COUNT] = {"Header", "Read", "Histogram", "Encryption", "Decryption", "Evaluation", "Packing", "Planes", "Write"};
+		return names[stage];
+	};
+};
+
+#ifdef PAILLIER_PROFILING
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+/** Time the rest of the enclosing scope as a run of Profiler::stage. */
+#define PROFILE_STAGE(stage) Profiler::Timer PROFILE_CONCAT(profileTimer, __LINE__)(Profiler::stage)
+/** Add value events to Profiler::counter. */
+#define PROFILE_COUNT(counter, value) Profiler::count(Profiler::counter, value)
+#else
+#define PROFILE_STAGE(stage) ((void)0)
+#define PROFILE_COUNT(counter, value) ((void)(value))
+#endif
+
+#endif // PROFILING_PROFILER
@@ -0,0 +1,388 @@
+/******************************************************************************
+ * ICAR_Interns_Library
+ *
+ * File : PaillierBench.cpp
+ *
+ * Description : Benchmark of the Paillier cryptosystem on 64-bit integers and
+ *   of the PGM pipeline : modular exponentiation, encryption, decryption,
+ *   generation of g, bit compression and full encryption and decryption of
+ *   synthetic images of several sizes, with their round-trip check, also with
+ *   -pack on a 32-bit key, whose decryption uses the CRT.
+ *
+ * Author : Katia Auxilien
+ *
+ * Mail : katia.auxilien@mail.fr
+ *
+ * Date : 17 Octobre 2026
+ *
+ *******************************************************************************/
+
+#include "../../../include/controller/PaillierControllerPGM.hpp"
+#include "../../../include/model/encryption/random/ChaCha20.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+
+/**
+ * \brief Measure of a benchmark.
+ */
+struct Result
+{
+	string name;        //!< Function or mode measured.
+	int size;           //!< Side of the square image, 0 for the functions on one value.
+	uint64_t ops;       //!< Number of operations.
+	uint64_t pixels;    //!< Number of pixels processed by the operations.
+	double seconds;     //!< Time of the operations.
+	bool check;         //!< Result of the round-trip check.
+	long peakRssKb;     //!< Peak resident memory of the process after the operations.
+};
+
+static vector<Result> results;
+
+/**
+ * \brief Peak resident memory of the process.
+ */
+static long peakRssKb()
+{
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+}
+
+/**
+ * \brief Time ops operations run by f, which returns the result of their check, and print the measure.
+ */
+template <typename F>
+static void measure(const string &name, int size, uint64_t ops, uint64_t pixelsPerOp, F f)
+{
+	auto start = chrono::steady_clock::now();
+	bool check = f();
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	Result result = {name, size, ops, ops * pixelsPerOp, seconds, check, peakRssKb()};
+	results.push_back(result);
+
+	string dimensions = size > 0 ? to_string(size) + "x" + to_string(size) : "-";
+	fprintf(stdout, "%-22s %11s %10" PRIu64 " %12.1f %14.0f %10.1f %6s\n", name.c_str(), dimensions.c_str(), ops,
+			seconds * 1e9 / ops, result.pixels / seconds, result.peakRssKb / 1024.0, check ? "ok" : "FAILED");
+	fflush(stdout);
+}
+
+/**
+ * \brief Write the measures in a JSON file, for regression tracking.
+ */
+static bool writeJson(const string &path, uint64_t n, unsigned threads)
+{
+	FILE *f = fopen(path.c_str(), "w");
+	if (f == NULL)
+	{
+		return false;
+	}
+	fprintf(f, "{\n  \"n\": %" PRIu64 ",\n  \"threads\": %u,\n  \"peak_rss_kb\": %ld,\n  \"results\": [\n", n, threads, peakRssKb());
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		const Result &r = results[i];
+		fprintf(f, "    {\"name\": \"%s\", \"size\": %d, \"ops\": %" PRIu64 ", \"seconds\": %.6f, \"ns_per_op\": %.1f, \"pixels_per_s\": %.0f, \"peak_rss_kb\": %ld, \"check\": %s}%s\n",
+				r.name.c_str(), r.size, r.ops, r.seconds, r.seconds * 1e9 / r.ops, r.pixels / r.seconds, r.peakRssKb, r.check ? "true" : "false", i + 1 < results.size() ? "," : "");
+	}
+	fprintf(f, "  ]\n}\n");
+	return fclose(f) == 0;
+}
+
+/**
+ * \brief Write a synthetic size x size image : a gradient with noise, every pixel below n.
+ */
+static bool writeSyntheticImage(const string &path, int size, uint64_t n)
+{
+	PgmView image;
+	if (!image.create(path.c_str(), size, size, 255, (size_t)size * size))
+	{
+		return false;
+	}
+	ChaCha20 &random = ChaCha20::threadInstance();
+	uint8_t *pixels = image.data();
+	for (int y = 0; y < size; y++)
+	{
+		for (int x = 0; x < size; x++)
+		{
+			pixels[(size_t)y * size + x] = ((uint64_t)(x + y) * 255 / (2 * size) + random() % 16) % n;
+		}
+	}
+	return image.flush(0, (size_t)size * size);
+}
+
+/**
+ * \brief True if two images have the same pixels.
+ */
+static bool samePixels(const string &path, const string &other)
+{
+	PgmView a, b;
+	return a.open(path.c_str(), 1) && b.open(other.c_str(), 1) && a.dataSize() == b.dataSize() && memcmp(a.data(), b.data(), a.dataSize()) == 0;
+}
+
+int main(int argc, char **argv)
+{
+	/*********************** Traitement d'arguments ***********************/
+
+	vector<int> sizes;
+	uint64_t operations = 200000;
+	unsigned threads = 1;
+	uint64_t p = 13, q = 17;
+	string jsonPath;
+	for (int i = 1; i < argc; i++)
+	{
+		string arg = argv[i];
+		if ((arg == "-ops" || arg == "-n") && i + 1 < argc)
+		{
+			operations = strtoull(argv[++i], NULL, 10);
+		}
+		else if ((arg == "-t" || arg == "-threads") && i + 1 < argc)
+		{
+			threads = atoi(argv[++i]);
+		}
+		else if (arg == "-pq" && i + 2 < argc)
+		{
+			p = strtoull(argv[++i], NULL, 10);
+			q = strtoull(argv[++i], NULL, 10);
+		}
+		else if (arg == "-json" && i + 1 < argc)
+		{
+			jsonPath = std::filesystem::absolute(argv[++i]).string();
+		}
+		else
+		{
+			sizes.push_back(atoi(argv[i]));
+		}
+	}
+	if (sizes.empty())
+	{
+		sizes = {256, 512, 1024, 2048};
+	}
+	bool validSizes = true;
+	for (int size : sizes)
+	{
+		validSizes &= size > 0;
+	}
+	if (operations < 100 || !validSizes || p * q > 256 || p == q)
+	{
+		fprintf(stderr, "Usage : %s [-ops N (at least 100)] [-t THREADS] [-pq P Q (n = pq at most 256)] [-json FILE] [IMAGE SIZE ...]\n", argv[0]);
+		return 1;
+	}
+
+	// The keys and the images are written in a temporary folder, removed at the end.
+	char folder[] = "/tmp/PaillierBenchXXXXXX";
+	if (mkdtemp(folder) == NULL || chdir(folder) != 0)
+	{
+		fprintf(stderr, "Error ! Creating a temporary folder.\n");
+		return 1;
+	}
+
+	/*********************** Génération de clé ***********************/
+
+	PaillierControllerPGM *controller = new PaillierControllerPGM();
+	controller->setThreads(threads);
+	PaillierModel *model = PaillierModel::getInstance();
+	Paillier<uint64_t, uint64_t> generation;
+	model->setP(p);
+	model->setQ(q);
+	model->setN(p * q);
+	model->setPaillierGenerationKey(generation);
+	model->setLambda(generation.lcm_64t(p - 1, q - 1));
+	controller->generateAndSaveKeyPair();
+
+	PaillierPrivateKey privateKey = model->getPrivateKey();
+	uint64_t n = model->getPublicKey().getN();
+	uint64_t g = model->getPublicKey().getG();
+	uint64_t lambda = privateKey.getLambda();
+	uint64_t mu = privateKey.getMu();
+
+	fprintf(stdout, "n = %" PRIu64 ", g = %" PRIu64 ", %u threads\n", n, g, controller->getThreads());
+	fprintf(stdout, "%-22s %11s %10s %12s %14s %10s %6s\n", "benchmark", "size", "ops", "ns/op", "pixels/s", "RSS (MB)", "check");
+
+	/*********************** Arithmétique ***********************/
+
+	Paillier<uint8_t, uint16_t> paillier;
+	volatile uint64_t sink = 0;
+
+	measure("fastMod_64t", 0, operations, 1, [&]
+			{
+		uint64_t sum = 0;
+		for (uint64_t i = 0; i < operations; i++)
+		{
+			sum += paillier.fastMod_64t(i % (n * n), lambda, n * n);
+		}
+		sink = sum;
+		return true; });
+
+	vector<uint16_t> ciphers(4096);
+	measure("paillierEncryption", 0, operations, 1, [&]
+			{
+		for (uint64_t i = 0; i < operations; i++)
+		{
+			ciphers[i % ciphers.size()] = paillier.paillierEncryption(n, g, (uint8_t)(i % ciphers.size() % n));
+		}
+		return true; });
+
+	measure("paillierDecryption", 0, operations, 1, [&]
+			{
+		bool ok = true;
+		for (uint64_t i = 0; i < operations; i++)
+		{
+			size_t j = i % ciphers.size();
+			ok &= paillier.paillierDecryption(n, lambda, mu, ciphers[j]) == j % n;
+		}
+		return ok; });
+
+	measure("paillierDecryptionCRT", 0, operations, 1, [&]
+			{
+		bool ok = true;
+		for (uint64_t i = 0; i < operations; i++)
+		{
+			size_t j = i % ciphers.size();
+			ok &= paillier.paillierDecryptionCRT(privateKey, ciphers[j]) == j % n;
+		}
+		return ok; });
+
+	measure("generate_g_64t", 0, operations / 100, 1, [&]
+			{
+		uint64_t sum = 0;
+		for (uint64_t i = 0; i < operations / 100; i++)
+		{
+			sum += generation.generate_g_64t(n, lambda);
+		}
+		sink = sum;
+		return true; });
+	(void)sink;
+
+	/*********************** Compression ***********************/
+
+	ChaCha20 &random = ChaCha20::threadInstance();
+	for (int size : sizes)
+	{
+		size_t nbPixels = (size_t)size * size;
+		int bits = 4;
+		vector<uint16_t> encrypted(nbPixels), unpacked(nbPixels);
+		for (size_t i = 0; i < nbPixels; i++)
+		{
+			encrypted[i] = (random() % (n * n)) & ~(uint16_t)15;
+		}
+
+		vector<uint8_t> packed16(2 * BitPacker::packedSize<uint16_t>(nbPixels, bits));
+		measure("compressBits_16bpp", size, 1, nbPixels, [&]
+				{
+			controller->compressBits_16bpp(encrypted.data(), nbPixels, bits, packed16.data(), packed16.size() / 2);
+			return true; });
+		measure("decompressBits_16bpp", size, 1, nbPixels, [&]
+				{
+			controller->decompressBits_16bpp(packed16.data(), packed16.size() / 2, bits, unpacked.data(), nbPixels);
+			return unpacked == encrypted; });
+
+		vector<uint8_t> packed8(BitPacker::packedSize<uint8_t>(nbPixels, bits));
+		measure("compressBits_8bpp", size, 1, nbPixels, [&]
+				{
+			controller->compressBits_8bpp(encrypted.data(), nbPixels, bits, packed8.data(), packed8.size());
+			return true; });
+		measure("decompressBits_8bpp", size, 1, nbPixels, [&]
+				{
+			controller->decompressBits_8bpp(packed8.data(), packed8.size(), bits, unpacked.data(), nbPixels);
+			return unpacked == encrypted; });
+	}
+
+	/*********************** Images ***********************/
+
+	struct Mode
+	{
+		const char *name;
+		bool distributeOnTwo;
+		bool optimisationLSB16;
+	};
+	const Mode modes[] = {{"", false, false}, {" -d", true, false}, {" -olsbr16", false, true}};
+
+	for (int size : sizes)
+	{
+		string image = "synthetic_" + to_string(size) + ".pgm";
+		string encryptedImage = "synthetic_" + to_string(size) + "_E.pgm";
+		string decryptedImage = "synthetic_" + to_string(size) + "_E_D.pgm";
+		if (!writeSyntheticImage(image, size, n))
+		{
+			fprintf(stderr, "Error ! Writing the image %s.\n", image.c_str());
+			return 1;
+		}
+		uint64_t nbPixels = (uint64_t)size * size;
+
+		for (const Mode &mode : modes)
+		{
+			measure(string("encrypt") + mode.name, size, 1, nbPixels, [&]
+					{
+				controller->processImage(image, true, mode.distributeOnTwo, false, false, mode.optimisationLSB16);
+				return true; });
+			measure(string("decrypt") + mode.name, size, 1, nbPixels, [&]
+					{
+				controller->processImage(encryptedImage, false, mode.distributeOnTwo, false, false, mode.optimisationLSB16);
+				return samePixels(image, decryptedImage); });
+		}
+	}
+
+	/*********************** Images de -pack, clé de 32 bits ***********************/
+
+	// The CRT decryption of the images only runs from a n of 32 bits (-pack), with p and q
+	// the two largest primes of 16 bits.
+	uint64_t packP = 65521, packQ = 65519;
+	model->setP(packP);
+	model->setQ(packQ);
+	model->setN(packP * packQ);
+	model->setLambda(generation.lcm_64t(packP - 1, packQ - 1));
+	controller->generateAndSaveKeyPair();
+	controller->setPackGuardBits(2);
+	uint64_t packN = model->getPublicKey().getN();
+	fprintf(stdout, "n = %" PRIu64 " (32 bits), -pack 2\n", packN);
+
+	for (int size : sizes)
+	{
+		string image = "packed_" + to_string(size) + ".pgm";
+		string encryptedImage = "packed_" + to_string(size) + "_E.pgm";
+		string decryptedImage = "packed_" + to_string(size) + "_E_D.pgm";
+		if (!writeSyntheticImage(image, size, packN))
+		{
+			fprintf(stderr, "Error ! Writing the image %s.\n", image.c_str());
+			return 1;
+		}
+		uint64_t nbPixels = (uint64_t)size * size;
+
+		measure("encrypt -pack", size, 1, nbPixels, [&]
+				{
+			controller->processImage(image, true, false, false, false, false);
+			return true; });
+		measure("decrypt -pack (CRT)", size, 1, nbPixels, [&]
+				{
+			controller->processImage(encryptedImage, false, false, false, false, false);
+			return samePixels(image, decryptedImage); });
+	}
+
+	if (chdir("/") != 0)
+	{
+		return 1;
+	}
+	std::filesystem::remove_all(folder);
+
+	bool ok = true;
+	for (const Result &result : results)
+	{
+		ok &= result.check;
+	}
+	fprintf(stdout, "Peak RSS : %.1f MB\n", peakRssKb() / 1024.0);
+	if (!jsonPath.empty() && !writeJson(jsonPath, n, controller->getThreads()))
+	{
+		fprintf(stderr, "Error ! Writing %s.\n", jsonPath.c_str());
+		return 1;
+	}
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+/******************************************************************************
+ * ICAR_Interns_Library
+ *
+ * File : PaillierBigIntBench.cpp
+ *
+ * Description : Benchmark of the Paillier cryptosystem on arbitrary-precision
+ *   integers : key generation, encryption, standard and CRT decryption for
+ *   real key sizes, with a round-trip check of every ciphertext.
+ *
+ * Author : Katia Auxilien
+ *
+ * Mail : katia.auxilien@mail.fr
+ *
+ * Date : 17 Octobre 2026
+ *
+ *******************************************************************************/
+
+#include "../../../include/model/encryption/Paillier/Paillier_big.hpp"
+
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace std;
+
+static const size_t MIN_KEY_BITS = 64; //!< Smallest key size, the primes of fewer bits are too few to be distinct.
+
+/**
+ * \brief Print the usage of the benchmark.
+ */
+static void printUsage(const char *program)
+{
+	fprintf(stderr, "Usage : %s [-ops N] [KEY BITS ...]\n\tKEY BITS : sizes of n, at least %zu bits (1024 2048 3072 by default).\n", program, MIN_KEY_BITS);
+}
+
+/**
+ * \brief Seconds elapsed since a time point.
+ */
+static double secondsSince(chrono::steady_clock::time_point start)
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char **argv)
+{
+	/*********************** Traitement d'arguments ***********************/
+
+	vector<size_t> keySizes;
+	int operations = 20;
+	for (int i = 1; i < argc; i++)
+	{
+		string arg = argv[i];
+		if ((arg == "-ops" || arg == "-n") && i + 1 < argc)
+		{
+			operations = atoi(argv[++i]);
+		}
+		else
+		{
+			char *end;
+			unsigned long bits = strtoul(argv[i], &end, 10);
+			if (!isdigit((unsigned char)argv[i][0]) || *end != '\0' || bits < MIN_KEY_BITS)
+			{
+				printUsage(argv[0]);
+				return 1;
+			}
+			keySizes.push_back(bits);
+		}
+	}
+	if (keySizes.empty())
+	{
+		keySizes = {1024, 2048, 3072};
+	}
+	if (operations <= 0)
+	{
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	Paillier<BigInteger, BigInteger> paillier;
+
+	fprintf(stdout, "%8s %12s %14s %14s %14s %8s\n", "bits", "keygen (s)", "enc (op/s)", "dec (op/s)", "dec CRT (op/s)", "check");
+
+	for (size_t bits : keySizes)
+	{
+		/*********************** Génération de clé ***********************/
+
+		auto start = chrono::steady_clock::now();
+		BigInteger p, q, lambda, mu, hp, hq, p_inv_q;
+		paillier.generatePrimes(bits / 2, p, q);
+		BigInteger n = p * q;
+		BigInteger g = paillier.generate_g(n);
+		paillier.generatePrivateKey(lambda, mu, p, q, n, g);
+		paillier.generateCRTParameters(hp, hq, p_inv_q, p, q, g);
+		double keygen = secondsSince(start);
+
+		/*********************** Chiffrement ***********************/
+
+		vector<BigInteger> messages(operations), ciphers(operations);
+		for (int i = 0; i < operations; i++)
+		{
+			messages[i] = BigInteger::randomBelow(n);
+		}
+
+		start = chrono::steady_clock::now();
+		for (int i = 0; i < operations; i++)
+		{
+			ciphers[i] = paillier.paillierEncryption(n, g, messages[i]);
+		}
+		double enc = operations / secondsSince(start);
+
+		/*********************** Déchiffrement ***********************/
+
+		bool ok = true;
+		start = chrono::steady_clock::now();
+		for (int i = 0; i < operations; i++)
+		{
+			ok &= paillier.paillierDecryption(n, lambda, mu, ciphers[i]) == messages[i];
+		}
+		double dec = operations / secondsSince(start);
+
+		start = chrono::steady_clock::now();
+		for (int i = 0; i < operations; i++)
+		{
+			ok &= paillier.paillierDecryptionCRT(p, q, hp, hq, p_inv_q, ciphers[i]) == messages[i];
+		}
+		double decCRT = operations / secondsSince(start);
+
+		fprintf(stdout, "%8zu %12.3f %14.1f %14.1f %14.1f %8s\n", n.bitLength(), keygen, enc, dec, decCRT, ok ? "ok" : "FAILED");
+		if (!ok)
+		{
+			return 1;
+		}
+	}
+
+	return 0;
+}
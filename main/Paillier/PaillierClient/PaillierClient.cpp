@@ -0,0 +1,253 @@
+/******************************************************************************
+ * ICAR_Interns_Library
+ *
+ * File : PaillierClient.cpp
+ *
+ * Description : Client of the encryption daemon of PaillierPgm.out : submits
+ *   images or pixel buffers on its Unix socket and streams the results back.
+ *
+ * Author : Katia Auxilien
+ *
+ * Mail : katia.auxilien@mail.fr
+ *
+ * Date : 17 Octobre 2026
+ *
+ *******************************************************************************/
+
+#include "../../../include/model/network/UnixSocket.hpp"
+#include "../../../include/model/network/DaemonProtocol.hpp"
+#include "../../../include/model/parallel/BoundedQueue.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/**
+ * \brief Print the usage of the client.
+ */
+static void printHelp()
+{
+	printf("./PaillierClient.out\nNAME\n\t./PaillierClient.out - Submit images or pixels to the daemon of ./PaillierPgm.out\n\n"
+		   "SYNOPSIS\n"
+		   "\t./PaillierClient.out [-socket PATH] encrypt [-d] [-hexp] [-olsbr32|-olsbr16] FILE.PGM...\n"
+		   "\t./PaillierClient.out [-socket PATH] decrypt [-d] [-olsbr32|-olsbr16] FILE_E.PGM...\n"
+		   "\t\tencrypt or decrypt the images, the daemon writes FILE_E.pgm or FILE_E_D.pgm.\n\n"
+		   "\t./PaillierClient.out [-socket PATH] encrypt-pixels [-chunk N] < PIXELS > ENCRYPTED\n"
+		   "\t./PaillierClient.out [-socket PATH] decrypt-pixels [-chunk N] < ENCRYPTED > PIXELS\n"
+		   "\t\tencrypt 8-bit pixels in 16-bit little-endian encrypted pixels, or decrypt them, by chunks of N pixels (65536 by default).\n\n"
+		   "\t./PaillierClient.out [-socket PATH] shutdown\n"
+		   "\t\tstop the daemon.\n\n"
+		   "\t-socket PATH\n\tthe socket of the daemon, %s by default.\n\n",
+		   DaemonProtocol::DEFAULT_SOCKET);
+}
+
+/**
+ * \brief Read the reply of a request, print it if it is an error.
+ * \return bool - True if the request is done.
+ */
+static bool readReply(UnixSocket &daemon, string &reply)
+{
+	if (!daemon.readLine(reply))
+	{
+		fprintf(stderr, "Error ! The daemon closed the connection.\n");
+		return false;
+	}
+	if (reply.compare(0, strlen(DaemonProtocol::OK), DaemonProtocol::OK) != 0)
+	{
+		fprintf(stderr, "%s\n", reply.c_str());
+		return false;
+	}
+	return true;
+}
+
+/**
+ * \brief Send an image request per file, and print the images written as they are done.
+ * \details The requests are sent by another thread, so the daemon always has the next
+ * image to process when it replies. The daemon only accepts absolute paths, the files are
+ * resolved against the working directory of the client.
+ */
+static int submitFiles(UnixSocket &daemon, const char *request, const vector<string> &options, const vector<string> &files)
+{
+	std::thread sender([&]
+					   {
+		for (const string &file : files)
+		{
+			string line = request;
+			for (const string &option : options)
+			{
+				line += " " + option;
+			}
+			if (!daemon.writeLine(line + " " + std::filesystem::absolute(file).string()))
+			{
+				return;
+			} } });
+
+	int status = EXIT_SUCCESS;
+	string reply;
+	for (size_t i = 0; i < files.size(); i++)
+	{
+		if (!daemon.readLine(reply))
+		{
+			fprintf(stderr, "Error ! The daemon closed the connection.\n");
+			status = EXIT_FAILURE;
+			break;
+		}
+		if (reply.compare(0, strlen(DaemonProtocol::OK), DaemonProtocol::OK) == 0)
+		{
+			printf("%s -> %s\n", files[i].c_str(), reply.c_str() + strlen(DaemonProtocol::OK) + 1);
+		}
+		else
+		{
+			fprintf(stderr, "%s : %s\n", files[i].c_str(), reply.c_str());
+			status = EXIT_FAILURE;
+		}
+	}
+	daemon.shutdown();
+	sender.join();
+	return status;
+}
+
+/**
+ * \brief Stream the standard input to the daemon by chunks, and the results to the standard output.
+ * \details A thread reads the chunks and sends the requests while the calling thread
+ * receives the results, at most a few chunks ahead, so reading, processing and writing overlap.
+ */
+static int submitPixels(UnixSocket &daemon, bool isEncryption, size_t chunk)
+{
+	size_t inputPixelSize = isEncryption ? 1 : 2;
+	BoundedQueue<size_t> sent(4);
+	bool inputError = false;
+
+	std::thread sender([&]
+					   {
+		vector<uint8_t> buffer(chunk * inputPixelSize);
+		size_t size;
+		while ((size = fread(buffer.data(), 1, buffer.size(), stdin)) > 0)
+		{
+			if (size % inputPixelSize != 0)
+			{
+				inputError = true;
+				break;
+			}
+			size_t count = size / inputPixelSize;
+			string line = string(isEncryption ? DaemonProtocol::ENCRYPT_PIXELS : DaemonProtocol::DECRYPT_PIXELS) + " " + to_string(count);
+			if (!daemon.writeLine(line) || !daemon.writeAll(buffer.data(), size))
+			{
+				break;
+			}
+			sent.push(count);
+		}
+		sent.close(); });
+
+	int status = EXIT_SUCCESS;
+	vector<uint8_t> result;
+	string reply;
+	size_t count;
+	while (sent.pop(count))
+	{
+		size_t size = isEncryption ? 2 * count : count;
+		result.resize(size);
+		if (!readReply(daemon, reply) || strtoull(reply.c_str() + strlen(DaemonProtocol::OK), NULL, 10) != size || !daemon.readExact(result.data(), size))
+		{
+			status = EXIT_FAILURE;
+			break;
+		}
+		fwrite(result.data(), 1, size, stdout);
+	}
+	daemon.shutdown();
+	// Unblocks the sender if the receiver stopped first.
+	while (sent.pop(count))
+	{
+	}
+	sender.join();
+
+	if (inputError)
+	{
+		fprintf(stderr, "Error ! The encrypted pixels are 2 bytes, the input has an odd size.\n");
+		status = EXIT_FAILURE;
+	}
+	return status;
+}
+
+int main(int argc, char **argv)
+{
+	/*********************** Traitement d'arguments ***********************/
+
+	string socketPath = DaemonProtocol::DEFAULT_SOCKET;
+	string mode;
+	vector<string> options, files;
+	size_t chunk = 65536;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "-h") || !strcmp(argv[i], "-help"))
+		{
+			printHelp();
+			return EXIT_SUCCESS;
+		}
+		else if (!strcmp(argv[i], "-socket") && i + 1 < argc)
+		{
+			socketPath = argv[++i];
+		}
+		else if (!strcmp(argv[i], "-chunk") && i + 1 < argc)
+		{
+			chunk = strtoull(argv[++i], NULL, 10);
+		}
+		else if (mode.empty())
+		{
+			mode = argv[i];
+		}
+		else if (argv[i][0] == '-')
+		{
+			options.push_back(argv[i]);
+		}
+		else
+		{
+			files.push_back(argv[i]);
+		}
+	}
+
+	bool isFiles = mode == "encrypt" || mode == "decrypt";
+	bool isPixels = mode == "encrypt-pixels" || mode == "decrypt-pixels";
+	if ((!isFiles && !isPixels && mode != "shutdown") || (isFiles && files.empty()) || (!isFiles && !files.empty()) || (!isFiles && !options.empty()))
+	{
+		printHelp();
+		return EXIT_FAILURE;
+	}
+	if (chunk == 0 || chunk > DaemonProtocol::MAX_PIXELS)
+	{
+		fprintf(stderr, "The argument after -chunk must be a number of pixels, from 1 to %zu.\n", DaemonProtocol::MAX_PIXELS);
+		return EXIT_FAILURE;
+	}
+
+	/*********************** Connexion au démon ***********************/
+
+	UnixSocket daemon;
+	if (!daemon.connect(socketPath.c_str()))
+	{
+		fprintf(stderr, "Error ! No daemon listens on %s, start it with ./PaillierPgm.out daemon.\n", socketPath.c_str());
+		return EXIT_FAILURE;
+	}
+
+	if (isFiles)
+	{
+		return submitFiles(daemon, mode == "encrypt" ? DaemonProtocol::ENCRYPT : DaemonProtocol::DECRYPT, options, files);
+	}
+	if (isPixels)
+	{
+		return submitPixels(daemon, mode == "encrypt-pixels", chunk);
+	}
+
+	string reply;
+	if (!daemon.writeLine(DaemonProtocol::SHUTDOWN) || !readReply(daemon, reply))
+	{
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
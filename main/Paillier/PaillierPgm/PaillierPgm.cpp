@@ -24,6 +24,7 @@
 #include <stdio.h>
 #include <ctype.h>
 #include <errno.h>
+#include <strings.h>
 
 using namespace std;
 
@@ -39,7 +40,25 @@ int main(int argc, char **argv)
 		return 1;
 	}
 
-	bool parameters[7];
+	if (!strcasecmp(argv[1], "daemon") || !strcasecmp(argv[1], "serve"))
+	{
+		controller->checkDaemonParameters(argv, argc);
+		controller->serve();
+		exit(EXIT_SUCCESS);
+	}
+
+	if (!strcasecmp(argv[1], "eval"))
+	{
+		bool printStats = controller->checkEvalParameters(argv, argc);
+		controller->evaluate();
+		if (printStats)
+		{
+			controller->printProfile();
+		}
+		exit(EXIT_SUCCESS);
+	}
+
+	bool parameters[10];
 	controller->checkParameters(argv, argc, parameters);
 
 	bool isEncryption = parameters[0];
@@ -49,6 +68,9 @@ int main(int argc, char **argv)
 	bool optimisationLSB32 = parameters[4];
 	bool optimisationLSB16 = parameters[5];
 	bool needHelp = parameters[6];
+	bool useDecryptionTable = parameters[7];
+	bool isKeyGeneration = parameters[8];
+	bool printStats = parameters[9];
 
 	if(needHelp)
 	{
@@ -67,94 +89,30 @@ int main(int argc, char **argv)
 		controller->readKeyFile(isEncryption);
 	}
 
-	/*********************** Instanciations de Paillier en fonction de n ***********************/
+	if (isKeyGeneration)
+	{
+		exit(EXIT_SUCCESS);
+	}
 
-	uint64_t n = controller->getModel()->getN();
-	/*********************** Chiffrement ***********************/
+	if (useDecryptionTable && !isEncryption)
+	{
+		controller->loadDecryptionTable();
+	}
+
+	/*********************** Chiffrement / Déchiffrement ***********************/
 
-	if (isEncryption)
+	if (controller->getFolder().empty())
 	{
-		if (n <= 256)
-		{
-			if (!optimisationLSB32 && !optimisationLSB16)
-			{
-				Paillier<uint8_t, uint16_t> paillier;
-				controller->encrypt(distributeOnTwo, recropPixels, paillier);
-			}
-			if (optimisationLSB32 && !distributeOnTwo)
-			{
-				Paillier<uint8_t, uint16_t> paillier;
-				controller->encryptCompression_16bpp(recropPixels, paillier, 5);
-			}
-			if (optimisationLSB16 && !distributeOnTwo)
-			{
-				Paillier<uint8_t, uint16_t> paillier;
-				controller->encryptCompression_16bpp(recropPixels, paillier, 4);
-			}
-			if (optimisationLSB32 && distributeOnTwo)
-			{
-				Paillier<uint8_t, uint16_t> paillier;
-				controller->encryptCompression_8bpp(recropPixels, paillier, 5);
-			}
-			if (optimisationLSB16 && distributeOnTwo)
-			{
-				Paillier<uint8_t, uint16_t> paillier;
-				controller->encryptCompression_8bpp(recropPixels, paillier, 4);
-
-			}
-		}
-		// else if (n > 256 && n <= 65535)
-		// {
-		// 	Paillier<uint16_t, uint32_t> paillier;
-		// 	controller->encrypt2(distributeOnTwo, recropPixels,paillier);
-		// }
-		else
-		{
-			controller->getView()->error_failure("n value not supported.");
-			exit(EXIT_FAILURE);
-		}
+		controller->processImage(controller->getCFile(), isEncryption, distributeOnTwo, recropPixels, optimisationLSB32, optimisationLSB16);
 	}
-	/*********************** Déchiffrement ***********************/
 	else
 	{
-		if (n <= 256)
-		{
-			if (!optimisationLSB32 && !optimisationLSB16)
-			{
-				Paillier<uint8_t, uint16_t> paillier;
-				controller->decrypt(distributeOnTwo, paillier);
-			}
-			if (optimisationLSB32 && !distributeOnTwo)
-			{
-				Paillier<uint8_t, uint16_t> paillier;
-				controller->decryptCompression_16bpp(paillier, 5);
-			}
-			if (optimisationLSB16 && !distributeOnTwo)
-			{
-				Paillier<uint8_t, uint16_t> paillier;
-				controller->decryptCompression_16bpp(paillier, 4);
-			}
-			if (optimisationLSB32 && distributeOnTwo)
-			{
-				Paillier<uint8_t, uint16_t> paillier;
-				controller->decryptCompression_8bpp(paillier, 5);
-			}
-			if (optimisationLSB16 && distributeOnTwo)
-			{
-				Paillier<uint8_t, uint16_t> paillier;
-				controller->decryptCompression_8bpp(paillier, 4);
-			}
-		}
-		// else if (n > 256 && n <= 65535)
-		// {
-		// 	Paillier<uint16_t, uint32_t> paillier;
-		// 	controller->decrypt2(distributeOnTwo,paillier);
-		// }
-		else
-		{
-			controller->getView()->error_failure("n value not supported.");
-			exit(EXIT_FAILURE);
-		}
+		controller->processFolder(isEncryption, distributeOnTwo, recropPixels, optimisationLSB32, optimisationLSB16);
+	}
+
+	if (printStats)
+	{
+		controller->printProfile();
 	}
 
 	exit(EXIT_SUCCESS);
@@ -0,0 +1,96 @@
+/******************************************************************************
+ * ICAR_Interns_Library
+ *
+ * File : PaillierPpm.cpp
+ *
+ * Description :
+ *   Chiffrement et déchiffrement d'images couleur PPM, plan par plan.
+ *
+ * Author : Katia Auxilien
+ *
+ * Mail : katia.auxilien@mail.fr
+ *
+ * Date : 17 Octobre 2026
+ *
+ *******************************************************************************/
+
+
+#include "../../../include/controller/PaillierControllerPPM.hpp"
+
+#include <string>
+#include <stdio.h>
+#include <strings.h>
+
+using namespace std;
+
+int main(int argc, char **argv)
+{
+	PaillierControllerPPM *controller = new PaillierControllerPPM();
+
+	/*********************** Traitement d'arguments ***********************/
+
+	if (argc == 1|| (argc < 3 && argv[1][1] != 'h'))
+	{
+		controller->printHelp();
+		return 1;
+	}
+
+	bool parameters[10];
+	controller->checkParameters(argv, argc, parameters);
+
+	bool isEncryption = parameters[0];
+	bool useKeys = parameters[1];
+	bool distributeOnTwo = parameters[2];
+	bool recropPixels = parameters[3];
+	bool optimisationLSB32 = parameters[4];
+	bool optimisationLSB16 = parameters[5];
+	bool needHelp = parameters[6];
+	bool useDecryptionTable = parameters[7];
+	bool isKeyGeneration = parameters[8];
+	bool printStats = parameters[9];
+
+	if(needHelp)
+	{
+		controller->printHelp();
+		exit(EXIT_SUCCESS);
+	}
+
+	// The compressed and packed layouts, the batch mode and the bands of the PGM images have no colour version.
+	if (optimisationLSB32 || optimisationLSB16 || controller->getPackGuardBits() >= 0 || !controller->getFolder().empty() || controller->getBandRows() != 0)
+	{
+		controller->getView()->getInstance()->error_failure("Error ! The options -olsbr32, -olsbr16, -pack, -dir and -band are not available for colour images.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	/*********************** Traitement de clé ***********************/
+
+	if (!useKeys && isEncryption)
+	{
+		controller->generateAndSaveKeyPair();
+	}
+	else
+	{
+		controller->readKeyFile(isEncryption);
+	}
+
+	if (isKeyGeneration)
+	{
+		exit(EXIT_SUCCESS);
+	}
+
+	if (useDecryptionTable && !isEncryption)
+	{
+		controller->loadDecryptionTable();
+	}
+
+	/*********************** Chiffrement / Déchiffrement ***********************/
+
+	controller->processImage(controller->getCFile(), isEncryption, distributeOnTwo, recropPixels);
+
+	if (printStats)
+	{
+		controller->printProfile();
+	}
+
+	exit(EXIT_SUCCESS);
+}
\ No newline at end of file
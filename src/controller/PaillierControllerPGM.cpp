@@ -1,461 +1,1516 @@
-/******************************************************************************
- * ICAR_Interns_Library
- *
- * File : PaillierControllerPGM.cpp
- *
- * Description : Implementation of the PaillierControllerPGM class, which is a
- * controller for the Paillier cryptosystem applied to PGM (Portable Gray Map)
- * images.
- *
- *
- * Author : Katia Auxilien
- *
- * Mail : katia.auxilien@mail.fr
- *
- * Date : 29 Mai 2024, 13:57:00
- *
- *******************************************************************************/
-#include "../../include/controller/PaillierControllerPGM.hpp"
-
-PaillierControllerPGM::PaillierControllerPGM()
-{
-	init();
-};
-
-PaillierControllerPGM::~PaillierControllerPGM(){};
-
-void PaillierControllerPGM::init()
-{
-	this->c_file = NULL;
-	this->c_key_file = NULL;
-	this->model = PaillierModel::getInstance();
-	this->view = commandLineInterface::getInstance();
-}
-
-const char *PaillierControllerPGM::getCFile() const
-{
-	return c_file;
-}
-
-void PaillierControllerPGM::setCFile(char *newCFile)
-{
-	delete[] c_file;
-	c_file = new char[strlen(newCFile) + 1];
-	strcpy(c_file, newCFile);
-}
-
-void PaillierControllerPGM::checkParameters(char *arg_in[], int size_arg, bool param[])
-{
-	// if (arg_in == NULL || param == NULL) // Sécurité pointeurs.
-	// {
-	// this->view->getInstance()->error_failure("checkParameters : arguments null.");
-	// exit(EXIT_FAILURE);
-	// }
-
-	this->convertToLower(arg_in, size_arg);
-
-	/********** Initialisation de param[] à false. *************/
-	for (int i = 0; i < 6; i++)
-	{
-		param[i] = false;
-	}
-
-	/********** Initialisation de param[] à false. *************/
-	for (int i = 0; i < size_arg; i++)
-	{
-		if (strcmp(arg_in[i], "-h") == 0 || strcmp(arg_in[i], "-help") == 0)
-		{
-			param[6] = true;
-		}
-	}
-	if (!param[6])
-	{
-		/**************** First param ******************/
-		if (!strcmp(arg_in[1], "e") || !strcmp(arg_in[1], "enc") || !strcmp(arg_in[1], "encrypt") || !strcmp(arg_in[1], "encryption"))
-		{
-			param[0] = true;
-		}
-		else if (!strcmp(arg_in[1], "d") || !strcmp(arg_in[1], "dec") || !strcmp(arg_in[1], "decrypt") || !strcmp(arg_in[1], "decryption"))
-		{
-			param[0] = false;
-			param[1] = true;
-		}
-		else
-		{
-			this->view->getInstance()->error_failure("The first argument must be e, enc, encrypt, encryption or d, dec, decrypt, decryption (the case don't matter)\n");
-			exit(EXIT_FAILURE);
-		}
-		/**************** ... param ******************/
-
-		bool isFilePGM = false;
-		bool isFileBIN = false;
-
-		int i = 2;
-		if (param[0] == true && (strcmp(arg_in[i], "-k") && strcmp(arg_in[i], "-key")))
-		{
-			uint64_t p = this->check_p_q_arg(arg_in[2]);
-			if (p == 1)
-			{
-				exit(EXIT_FAILURE);
-			}
-			this->model->getInstance()->setP(p);
-
-			uint64_t q = this->check_p_q_arg(arg_in[3]);
-			if (q == 1)
-			{
-				exit(EXIT_FAILURE);
-			}
-			this->model->getInstance()->setQ(q);
-
-			uint64_t n = p * q;
-			this->model->getInstance()->setN(n);
-			Paillier<uint64_t, uint64_t> tempPaillier;
-			this->model->getInstance()->setPaillierGenerationKey(tempPaillier);
-
-			uint64_t pgc_pq = this->model->getInstance()->getPaillierGenerationKey().gcd_64t(p * q, (p - 1) * (q - 1));
-
-			if (pgc_pq != 1)
-			{
-				string msg = "pgcd(p * q, (p - 1) * (q - 1))= " + to_string(pgc_pq) + "\np & q arguments must have a gcd = 1. Please retry with others p and q.\n";
-				this->getView()->error_failure(msg);
-				exit(EXIT_FAILURE);
-			}
-			uint64_t lambda = this->model->getInstance()->getPaillierGenerationKey().lcm_64t(p - 1, q - 1);
-
-			this->model->getInstance()->setLambda(lambda);
-
-			i = 4;
-			isFileBIN = true;
-		}
-
-		for (i = i; i < size_arg; i++)
-		{
-			// TODO : Gérer les cas où il y a deux fois -k ou -? ... dans la ligne de commande. pour éviter les erreurs.
-
-			if ((!isFileBIN && !strcmp(arg_in[i], "-k")) || !strcmp(arg_in[i], "-key") || (param[1] == true && endsWith(arg_in[i], ".bin")))
-			{ // TODO : 2 cas où on veut check si il y a un argument .bin après le -k OU après le premier argument d
-
-				if (!strcmp(arg_in[i], "-k") || !strcmp(arg_in[i], "-key"))
-				{
-					this->setCKeyFile(arg_in[i + 1]);
-					param[1] = true;
-					i++;
-				}
-				if (param[1] == true)
-				{
-					this->setCKeyFile(arg_in[i]);
-				}
-				/****************** Check .bin file **************************/
-				string s_key_file = this->getCKeyFile();
-				ifstream file(this->getCKeyFile());
-				if (!file || !this->endsWith(s_key_file, ".bin"))
-				{
-					this->view->getInstance()->error_failure("The argument after -k or dec must be an existing .bin file.\n");
-					exit(EXIT_FAILURE);
-				}
-				isFileBIN = true;
-			}
-			else if (!strcmp(arg_in[i], "-d") || !strcmp(arg_in[i], "-distr") || !strcmp(arg_in[i], "-distribution"))
-			{
-				param[2] = true;
-			}
-			else if (!strcmp(arg_in[i], "-hexp") || !strcmp(arg_in[i], "-histogramexpansion"))
-			{
-				param[3] = true;
-			}
-			else if (!strcmp(arg_in[i], "-olsbr32") || !strcmp(arg_in[i], "-optlsbr32"))
-			{
-				param[4] = true;
-			}
-			else if (!strcmp(arg_in[i], "-olsbr16") || !strcmp(arg_in[i], "-optlsbr16"))
-			{
-				param[5] = true;
-			}
-			else if (this->endsWith(arg_in[i], ".pgm") && !isFilePGM)
-			{
-				this->setCFile(arg_in[i]);
-				string s_file = this->getCFile();
-				ifstream file(this->getCFile());
-				if (!file)
-				{
-					this->view->getInstance()->error_failure("The arguments must have an existing .pgm file.\n");
-					exit(EXIT_FAILURE);
-				}
-				isFilePGM = true;
-			
-			}else{
-				this->view->getInstance()->error_failure("The argument "+ std::string(arg_in[i]) +" is not available.\n");
-				exit(EXIT_FAILURE);
-			}
-		}
-
-		if (!isFilePGM)
-		{
-			this->view->getInstance()->error_failure("The arguments must have a .pgm file.\n");
-			exit(EXIT_FAILURE);
-		}
-		if (param[1] == true && !isFileBIN)
-		{
-			this->view->getInstance()->error_failure("The argument after -k or dec must be a .bin file.\n");
-			exit(EXIT_FAILURE);
-		}
-	}
-}
-
-void PaillierControllerPGM::printHelp()
-{
-	this->view->getInstance()->help("./PaillierPgm.out\nNAME\n \t./PaillierPgm.out - Encrypt or decrypt .pgm file\n\nSYNOPSIS\n\t./PaillierPgm.out [MODE]... [OPTIONS]... [FILE]...	\n\nDESCRIPTION\n	Program to encrypt or decrypt portable graymap file format.	\n\nOPTIONS	\n\t./Paillier_pgm_main.out encryption [ARGUMENTS] [FILE.PGM]	\n\t./Paillier_pgm_main.out encrypt [ARGUMENTS] [FILE.PGM]	\n\t./Paillier_pgm_main.out enc [ARGUMENTS] [FILE.PGM]	\n\t./Paillier_pgm_main.out e [ARGUMENTS] [FILE.PGM]\n\t\t encrypt file.\n	\n\t./Paillier_pgm_main.out decryption [PRIVATE KEY FILE .BIN] [FILE.PGM] [ARGUMENTS]	\n\t./Paillier_pgm_main.out decrypt [PRIVATE KEY FILE .BIN] [FILE.PGM] [ARGUMENTS]	\n\t./Paillier_pgm_main.out dec [PRIVATE KEY FILE .BIN] [FILE.PGM] [ARGUMENTS]	\n\t./Paillier_pgm_main.out d [PRIVATE KEY FILE .BIN] [FILE.PGM] [ARGUMENTS]*\n\t\tdecrypt file.	\n\t\tThe image to encrypt or to decrypt can be specify after the key or the options, or at the end.	\n	\n\t./Paillier_pgm_main.out encryption [p] [q] [FILE.PGM]	\n\t\t Encryption mode where you specify p and q arguments. p and q are prime number where pgcd(p * q,p-1 * q-1) = 1.	\n\n\t-k, -key	\n\t\t specify usage of private or public key, followed by file.bin, your key file. Encryption mode where you specify your public key file with format .bin.	\n\n\t./Paillier_pgm_main.out encryption -k [PUBLIC KEY FILE .BIN] [FILE.PGM]	\n\t./Paillier_pgm_main.out encryption -key [PUBLIC KEY FILE .BIN] [FILE.PGM]	\n\t./Paillier_pgm_main.out decryption -k [PRIVATE KEY FILE .BIN] [FILE.PGM]	\n\t\tdecryption mode where you specify your private key with format .bin. The option -k is optional, because it\'s obligatory to specify private key at decryption.\n\n\t-distribution, -distr, -d	\n\t\tto split encrypted pixel on two pixel.\n	\n\t-histogramexpansion,-hexp	\n\t\tto specify during **encryption** that we want to transform the histogram befor image encryption.\n\n\t-optlsbr32, -olsbr32\n\tto specify that we want to use bit compression with encrypted through optimized r generation mod(32), so free 5 LSB.\n\n\t-optlsbr16, -olsbr16\n\tto specify that we want to use bit compression with encrypted through optimized r generation mod(16), so free 4 LSB.\n\n");
-}
-
-uint8_t PaillierControllerPGM::histogramExpansion(OCTET ImgPixel, bool recropPixels)
-{
-	uint8_t pixel;
-	if (recropPixels)
-	{
-		uint64_t n = model->getInstance()->getPublicKey().getN();
-		pixel = (ImgPixel * n) / 256;
-	}
-	else
-	{
-		pixel = ImgPixel;
-	}
-	return pixel;
-}
-
-/*********************** Chiffrement/Déchiffrement ***********************/
-
-uint16_t *PaillierControllerPGM::compressBits_16bpp(uint16_t *ImgInEnc, int nb_lignes, int nb_colonnes, int bitsCompressed)
-{
-	int nbPixel = nb_colonnes * nb_lignes;
-	if (nbPixel > 132710400)
-	{
-		this->view->getInstance()->error_failure("Maximum image size is 132 710 400 pixels.\n");
-		exit(EXIT_FAILURE);
-	}
-
-	// Taille max image 15360*8640l
-	// std::bitset<2 123 366 400> finalSet;
-	std::bitset<2123366400> *finalSet = new std::bitset<2123366400>;
-
-	if(bitsCompressed > 16 || bitsCompressed < 0)
-	{
-		this->view->getInstance()->error_failure("Bits compressed must be between 0 and 16.\n");
-		exit(EXIT_FAILURE);
-	}
-
-	int j = 0;
-	std::bitset<16> tempSet;
-
-	for (int i = 0; i < nbPixel; i++)
-	{
-		tempSet = ImgInEnc[i];
-		for (int k = 15; k >= bitsCompressed; k--)
-		{
-			finalSet->set(j, tempSet[k]);
-			j++;
-		}
-	}
-
-	int size_ImgIn11bits = nbPixel * (16 - bitsCompressed);
-	int size_ImgOutEnc16bits = ceil((double)size_ImgIn11bits/16);
-
-	uint16_t * ImgOutEnc16bits = new uint16_t[size_ImgOutEnc16bits];
-
-	int k = 0;
-	for (int i = 0; i < size_ImgOutEnc16bits; i++)
-	{
-		std::bitset<16> SetImgOutEnc16bits;
-		for (int l = 0; l < 16; l++)
-		{
-			SetImgOutEnc16bits.set(l, (*finalSet)[k]);
-			k++;
-		}
-
-		ImgOutEnc16bits[i] = (uint16_t)SetImgOutEnc16bits.to_ulong();
-	}
-
-	return ImgOutEnc16bits;
-}
-
-uint16_t *PaillierControllerPGM::decompressBits_16bpp(uint16_t *ImgInEnc, int nb_lignes, int nb_colonnes, int nTailleOriginale, int bitsCompressed)
-{
-	if(bitsCompressed > 16 || bitsCompressed < 0)
-	{
-		this->view->getInstance()->error_failure("Bits compressed must be between 0 and 16.\n");
-		exit(EXIT_FAILURE);
-	}
-
-	int sizeComp = nb_lignes * nb_colonnes;
-	std::bitset<2123366400> *setTemp = new std::bitset<2123366400>;
-
-	int j = 0;
-	for (int i = 0; i < sizeComp; i++)
-	{
-		std::bitset<16> setImg = ImgInEnc[i];
-		for (int k = 0; k < 16; k++)
-		{
-			setTemp->set(j, setImg[k]);
-			j++;
-		}
-	}
-
-	// std::cout << setTemp << std::endl;
-
-	// step 2 : On écrit ce bitset dans le tableau originalImg
-	// int sizeOriginal = nb_lignes * nb_colonnes * 16;
-	int sizeOriginal = nTailleOriginale * 16;
-
-
-	uint16_t *originalImg = new uint16_t[sizeOriginal];
-
-	j = 0;
-	for (int i = 0; i < sizeOriginal; i++)
-	{
-		std::bitset<16> setImg;
-		for (int k = 15; k >= bitsCompressed; k--)
-		{
-			setImg.set(k, (*setTemp)[j]);
-			j++;
-		}
-		originalImg[i] = (uint16_t)setImg.to_ulong();
-		// std::cout << setImg << std::endl;
-	}
-
-	return originalImg;
-}
-
-pair<int, int> PaillierControllerPGM::decomposeDimension(int n){
-    int facteur1 = 1, facteur2 = n;
-    for (int i = 2; i <= n / 2; i++) {
-        if (n % i == 0) {
-            int diff = abs(i - n / i);
-            int diff_actuelle = abs(facteur1 - facteur2);
-            if (diff < diff_actuelle) {
-                facteur1 = i;
-                facteur2 = n / i;
-            }
-        }
-    }
-    return make_pair(facteur1, facteur2);
-}
-
-
-
-uint8_t *PaillierControllerPGM::compressBits_8bpp(uint16_t *ImgInEnc, int nb_lignes, int nb_colonnes, int bitsCompressed)
-{
-	int nbPixel = nb_colonnes * nb_lignes;
-	if (nbPixel > 132710400)
-	{
-		this->view->getInstance()->error_failure("Maximum image size is 132 710 400 pixels.\n");
-		exit(EXIT_FAILURE);
-	}
-
-	// Taille max image 15360*8640l
-	// std::bitset<2 123 366 400> finalSet;
-	std::bitset<2123366400> *finalSet = new std::bitset<2123366400>;
-
-	if(bitsCompressed > 16 || bitsCompressed < 0)
-	{
-		this->view->getInstance()->error_failure("Bits compressed must be between 0 and 16.\n");
-		exit(EXIT_FAILURE);
-	}
-
-	int j = 0;
-	std::bitset<16> tempSet;
-
-	for (int i = 0; i < nbPixel; i++)
-	{
-		tempSet = ImgInEnc[i];
-		for (int k = 15; k >= bitsCompressed; k--)
-		{
-			finalSet->set(j, tempSet[k]);
-			j++;
-		}
-	}
-
-	int size_ImgIn11bits = nbPixel * (16 - bitsCompressed);
-	int size_ImgOutEnc16bits = ceil((double)size_ImgIn11bits/16);
-
-
-	uint8_t * ImgOutEnc8bits = new uint8_t[size_ImgOutEnc16bits *2];
-
-	int k = 0;
-	j = 0;
-	for (int i = 0; i < size_ImgOutEnc16bits * 2; i++)
-	{
-		std::bitset<8> SetImgOutEnc8bits;
-		for (int l = 0; l < 8; l++)
-		{
-			SetImgOutEnc8bits.set(l, (*finalSet)[k]);
-			k++;
-		}
-		std::bitset<8> SetImgOutEnc8bits2;
-		for (int l = 0; l < 8; l++)
-		{
-			SetImgOutEnc8bits2.set(l, (*finalSet)[k]);
-			k++;
-		}
-
-		ImgOutEnc8bits[j] = (uint8_t)SetImgOutEnc8bits.to_ulong();
-		j++;
-		ImgOutEnc8bits[j] = (uint8_t)SetImgOutEnc8bits2.to_ulong();
-		j++;
-	}
-
-	return ImgOutEnc8bits;
-}
-
-uint16_t *PaillierControllerPGM::decompressBits_8bpp(uint8_t *ImgInEnc, int nb_lignes, int nb_colonnes, int nTailleOriginale, int bitsCompressed)
-{
-	if(bitsCompressed > 16 || bitsCompressed < 0)
-	{
-		this->view->getInstance()->error_failure("Bits compressed must be between 0 and 16.\n");
-		exit(EXIT_FAILURE);
-	}
-
-	int sizeComp = nb_lignes * nb_colonnes;
-	std::bitset<2123366400> *setTemp = new std::bitset<2123366400>;
-
-	int l = 0;
-	int j = 0;
-	for (int i = 0; i < sizeComp; i++)
-	{
-		std::bitset<8> setImg = ImgInEnc[l];
-		for (int k = 0; k < 8; k++)
-		{
-			setTemp->set(j, setImg[k]);
-			j++;
-		}
-		l++;
-		std::bitset<8> setImg2 = ImgInEnc[l];
-		for (int k = 0; k < 8 ; k++){
-			setTemp->set(j, setImg2[k]);
-			j++;
-		}
-		l++;
-	}
-
-	// std::cout << setTemp << std::endl;
-
-	// step 2 : On écrit ce bitset dans le tableau originalImg
-	// int sizeOriginal = nb_lignes * nb_colonnes * 16;
-	int sizeOriginal = nTailleOriginale * 16;
-
-
-	uint16_t *originalImg = new uint16_t[sizeOriginal];
-
-	j = 0;
-	for (int i = 0; i < sizeOriginal; i++)
-	{
-		std::bitset<16> setImg;
-		for (int k = 15; k >= bitsCompressed; k--)
-		{
-			setImg.set(k, (*setTemp)[j]);
-			j++;
-		}
-		originalImg[i] = (uint16_t)setImg.to_ulong();
-		// std::cout << setImg << std::endl;
-	}
-
-	return originalImg;
-}
+/******************************************************************************
+ * ICAR_Interns_Library
+ *
+ * File : PaillierControllerPGM.cpp
+ *
+ * Description : Implementation of the PaillierControllerPGM class, which is a
+ * controller for the Paillier cryptosystem applied to PGM (Portable Gray Map)
+ * images.
+ *
+ *
+ * Author : Katia Auxilien
+ *
+ * Mail : katia.auxilien@mail.fr
+ *
+ * Date : 29 Mai 2024, 13:57:00
+ *
+ *******************************************************************************/
+#include "../../include/controller/PaillierControllerPGM.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <thread>
+#include <unistd.h>
+
+PaillierControllerPGM::PaillierControllerPGM()
+{
+	init();
+};
+
+PaillierControllerPGM::~PaillierControllerPGM(){};
+
+void PaillierControllerPGM::init()
+{
+	this->c_file = NULL;
+	this->c_key_file = NULL;
+	this->threadPool.reset(new ThreadPool(1));
+	this->bandRows = 0;
+	this->packGuardBits = -1;
+	this->evalFactor = 0;
+	this->evalSum = false;
+	this->evalRegion[0] = this->evalRegion[1] = this->evalRegion[2] = this->evalRegion[3] = 0;
+	this->socketPath = DaemonProtocol::DEFAULT_SOCKET;
+	this->hasPublicKey = false;
+	this->hasPrivateKey = false;
+	this->stopping = false;
+	this->resident = false;
+	this->clients = 0;
+	this->model = PaillierModel::getInstance();
+	this->view = commandLineInterface::getInstance();
+}
+
+void PaillierControllerPGM::failImage(const string &message)
+{
+	if (this->resident)
+	{
+		throw std::runtime_error(message);
+	}
+	this->view->getInstance()->error_failure(message);
+	exit(EXIT_FAILURE);
+}
+
+void PaillierControllerPGM::checkMapping(bool mapped, const char *path)
+{
+	if (!mapped)
+	{
+		failImage("Error ! Mapping the image " + string(path) + " in memory, the file cannot be opened or is not a valid image of this format.\n");
+	}
+}
+
+string PaillierControllerPGM::imageExtension(bool isEncryption) const
+{
+	(void)isEncryption;
+	return ".pgm";
+}
+
+void PaillierControllerPGM::checkWriting(bool written, const char *path)
+{
+	if (!written)
+	{
+		failImage("Error ! Writing the image " + string(path) + ".\n");
+	}
+}
+
+void PaillierControllerPGM::printPipelineStats(const Pipeline &pipeline) const
+{
+	const char *names[3] = {"Read", "Process", "Write"};
+	for (int stage = Pipeline::READ; stage <= Pipeline::WRITE; stage++)
+	{
+		const Pipeline::StageStats &stats = pipeline.getStats(stage);
+		printf("%-7s : %" PRIu64 " bands, %" PRIu64 " pixels in %.3f s, %.2f Mpixels/s\n", names[stage], stats.bands, stats.pixels, stats.seconds, stats.throughput() / 1e6);
+	}
+}
+
+const char *PaillierControllerPGM::getCFile() const
+{
+	return c_file;
+}
+
+void PaillierControllerPGM::setCFile(char *newCFile)
+{
+	delete[] c_file;
+	c_file = new char[strlen(newCFile) + 1];
+	strcpy(c_file, newCFile);
+}
+
+unsigned PaillierControllerPGM::getThreads() const
+{
+	return threadPool->getThreadCount();
+}
+
+void PaillierControllerPGM::setThreads(unsigned threads)
+{
+	threadPool.reset(new ThreadPool(threads));
+}
+
+unsigned PaillierControllerPGM::getBandRows() const
+{
+	return bandRows;
+}
+
+void PaillierControllerPGM::setBandRows(unsigned rows)
+{
+	bandRows = rows;
+}
+
+int PaillierControllerPGM::getPackGuardBits() const
+{
+	return packGuardBits;
+}
+
+void PaillierControllerPGM::setPackGuardBits(int guardBits)
+{
+	packGuardBits = guardBits;
+}
+
+string PaillierControllerPGM::getFolder() const
+{
+	return folder;
+}
+
+void PaillierControllerPGM::setFolder(string newFolder)
+{
+	folder = newFolder;
+}
+
+const ZeroLsbTable *PaillierControllerPGM::getZeroLsbTable(int bitsCompressed)
+{
+	std::lock_guard<std::mutex> lock(zeroLsbMutex);
+	auto table = zeroLsbTables.find(bitsCompressed);
+	if (table == zeroLsbTables.end())
+	{
+		uint64_t n = model->getInstance()->getPublicKey().getN();
+		uint64_t g = model->getInstance()->getPublicKey().getG();
+		std::unique_ptr<ZeroLsbTable> built(new ZeroLsbTable());
+		if (!built->build(n, g, bitsCompressed))
+		{
+			// n is too large, NULL is kept so that the build is not tried again.
+			built.reset();
+		}
+		table = zeroLsbTables.emplace(bitsCompressed, std::move(built)).first;
+	}
+	return table->second.get();
+}
+
+size_t PaillierControllerPGM::bandPixels(size_t nbPixels, int nW, size_t align) const
+{
+	if (bandRows == 0 || (size_t)bandRows * nW >= nbPixels)
+	{
+		return nbPixels;
+	}
+	size_t band = (size_t)bandRows * nW;
+	return (band + align - 1) / align * align;
+}
+
+void PaillierControllerPGM::checkParameters(char *arg_in[], int size_arg, bool param[])
+{
+	// if (arg_in == NULL || param == NULL) // Sécurité pointeurs.
+	// {
+	// this->view->getInstance()->error_failure("checkParameters : arguments null.");
+	// exit(EXIT_FAILURE);
+	// }
+
+	this->convertToLower(arg_in, size_arg);
+
+	/********** Initialisation de param[] à false. *************/
+	for (int i = 0; i < 10; i++)
+	{
+		param[i] = false;
+	}
+
+	/********** Initialisation de param[] à false. *************/
+	for (int i = 0; i < size_arg; i++)
+	{
+		if (strcmp(arg_in[i], "-h") == 0 || strcmp(arg_in[i], "-help") == 0)
+		{
+			param[6] = true;
+		}
+	}
+	if (!param[6])
+	{
+		/**************** First param ******************/
+		if (!strcmp(arg_in[1], "e") || !strcmp(arg_in[1], "enc") || !strcmp(arg_in[1], "encrypt") || !strcmp(arg_in[1], "encryption"))
+		{
+			param[0] = true;
+		}
+		else if (!strcmp(arg_in[1], "d") || !strcmp(arg_in[1], "dec") || !strcmp(arg_in[1], "decrypt") || !strcmp(arg_in[1], "decryption"))
+		{
+			param[0] = false;
+			param[1] = true;
+		}
+		else if (!strcmp(arg_in[1], "kg") || !strcmp(arg_in[1], "keygen"))
+		{
+			param[0] = true;
+			param[8] = true;
+		}
+		else
+		{
+			this->view->getInstance()->error_failure("The first argument must be e, enc, encrypt, encryption, d, dec, decrypt, decryption, kg, keygen or daemon, serve (the case don't matter)\n");
+			exit(EXIT_FAILURE);
+		}
+		/**************** ... param ******************/
+
+		bool isFilePGM = false;
+		bool isFileBIN = false;
+		bool isPQ = false;
+		unsigned keyBits = 0;
+		bool safePrimes = false;
+
+		int i = 2;
+		if (param[0] == true && !param[8] && (strcmp(arg_in[i], "-k") && strcmp(arg_in[i], "-key") && strcmp(arg_in[i], "-bits")))
+		{
+			uint64_t p = this->check_p_q_arg(arg_in[2]);
+			if (p == 1)
+			{
+				exit(EXIT_FAILURE);
+			}
+			this->model->getInstance()->setP(p);
+
+			uint64_t q = this->check_p_q_arg(arg_in[3]);
+			if (q == 1)
+			{
+				exit(EXIT_FAILURE);
+			}
+			this->model->getInstance()->setQ(q);
+
+			uint64_t n = p * q;
+			this->model->getInstance()->setN(n);
+			Paillier<uint64_t, uint64_t> tempPaillier;
+			this->model->getInstance()->setPaillierGenerationKey(tempPaillier);
+
+			uint64_t pgc_pq = this->model->getInstance()->getPaillierGenerationKey().gcd_64t(p * q, (p - 1) * (q - 1));
+
+			if (pgc_pq != 1)
+			{
+				string msg = "pgcd(p * q, (p - 1) * (q - 1))= " + to_string(pgc_pq) + "\np & q arguments must have a gcd = 1. Please retry with others p and q.\n";
+				this->getView()->error_failure(msg);
+				exit(EXIT_FAILURE);
+			}
+			uint64_t lambda = this->model->getInstance()->getPaillierGenerationKey().lcm_64t(p - 1, q - 1);
+
+			this->model->getInstance()->setLambda(lambda);
+
+			i = 4;
+			isFileBIN = true;
+			isPQ = true;
+		}
+
+		for (i = i; i < size_arg; i++)
+		{
+			// TODO : Gérer les cas où il y a deux fois -k ou -? ... dans la ligne de commande. pour éviter les erreurs.
+
+			if ((!isFileBIN && !strcmp(arg_in[i], "-k")) || !strcmp(arg_in[i], "-key") || (param[1] == true && endsWith(arg_in[i], ".bin")))
+			{ // TODO : 2 cas où on veut check si il y a un argument .bin après le -k OU après le premier argument d
+
+				if (!strcmp(arg_in[i], "-k") || !strcmp(arg_in[i], "-key"))
+				{
+					this->setCKeyFile(arg_in[i + 1]);
+					param[1] = true;
+					i++;
+				}
+				if (param[1] == true)
+				{
+					this->setCKeyFile(arg_in[i]);
+				}
+				/****************** Check .bin file **************************/
+				string s_key_file = this->getCKeyFile();
+				ifstream file(this->getCKeyFile());
+				if (!file || !this->endsWith(s_key_file, ".bin"))
+				{
+					this->view->getInstance()->error_failure("The argument after -k or dec must be an existing .bin file.\n");
+					exit(EXIT_FAILURE);
+				}
+				isFileBIN = true;
+			}
+			else if (!strcmp(arg_in[i], "-d") || !strcmp(arg_in[i], "-distr") || !strcmp(arg_in[i], "-distribution"))
+			{
+				param[2] = true;
+			}
+			else if (!strcmp(arg_in[i], "-hexp") || !strcmp(arg_in[i], "-histogramexpansion"))
+			{
+				param[3] = true;
+			}
+			else if (!strcmp(arg_in[i], "-olsbr32") || !strcmp(arg_in[i], "-optlsbr32"))
+			{
+				param[4] = true;
+			}
+			else if (!strcmp(arg_in[i], "-olsbr16") || !strcmp(arg_in[i], "-optlsbr16"))
+			{
+				param[5] = true;
+			}
+			else if (!strcmp(arg_in[i], "-t") || !strcmp(arg_in[i], "-threads"))
+			{
+				if (i + 1 >= size_arg || !isdigit(arg_in[i + 1][0]))
+				{
+					this->view->getInstance()->error_failure("The argument after -threads must be a number of threads (0 for the number of cores).\n");
+					exit(EXIT_FAILURE);
+				}
+				this->setThreads(atoi(arg_in[i + 1]));
+				i++;
+			}
+			else if (!strcmp(arg_in[i], "-band"))
+			{
+				if (i + 1 >= size_arg || !isdigit(arg_in[i + 1][0]))
+				{
+					this->view->getInstance()->error_failure("The argument after -band must be a number of rows (0 for the whole image).\n");
+					exit(EXIT_FAILURE);
+				}
+				this->setBandRows(atoi(arg_in[i + 1]));
+				i++;
+			}
+			else if (!strcmp(arg_in[i], "-pack"))
+			{
+				// The number of guard bits is optional, 2 leaves room for the sum of 4 images.
+				if (i + 1 < size_arg && isdigit(arg_in[i + 1][0]))
+				{
+					this->setPackGuardBits(atoi(arg_in[i + 1]));
+					i++;
+				}
+				else
+				{
+					this->setPackGuardBits(2);
+				}
+			}
+			else if (!strcmp(arg_in[i], "-dir") || !strcmp(arg_in[i], "-directory"))
+			{
+				if (i + 1 >= size_arg || !std::filesystem::is_directory(arg_in[i + 1]))
+				{
+					this->view->getInstance()->error_failure("The argument after -dir must be an existing folder.\n");
+					exit(EXIT_FAILURE);
+				}
+				this->setFolder(arg_in[i + 1]);
+				i++;
+			}
+			else if (!strcmp(arg_in[i], "-bits"))
+			{
+				if (i + 1 >= size_arg || !isdigit(arg_in[i + 1][0]))
+				{
+					this->view->getInstance()->error_failure("The argument after -bits must be the number of bits of n.\n");
+					exit(EXIT_FAILURE);
+				}
+				keyBits = atoi(arg_in[i + 1]);
+				i++;
+			}
+			else if (!strcmp(arg_in[i], "-safe"))
+			{
+				safePrimes = true;
+			}
+			else if (!strcmp(arg_in[i], "-lut") || !strcmp(arg_in[i], "-lookuptable"))
+			{
+				param[7] = true;
+			}
+			else if (!strcmp(arg_in[i], "-stats"))
+			{
+				param[9] = true;
+			}
+			else if (this->endsWith(arg_in[i], this->imageExtension(param[0])) && !isFilePGM)
+			{
+				this->setCFile(arg_in[i]);
+				string s_file = this->getCFile();
+				ifstream file(this->getCFile());
+				if (!file)
+				{
+					this->view->getInstance()->error_failure("The arguments must have an existing " + this->imageExtension(param[0]) + " file.\n");
+					exit(EXIT_FAILURE);
+				}
+				isFilePGM = true;
+			
+			}else{
+				this->view->getInstance()->error_failure("The argument "+ std::string(arg_in[i]) +" is not available.\n");
+				exit(EXIT_FAILURE);
+			}
+		}
+
+		if (!isFilePGM && !param[8] && this->folder.empty())
+		{
+			this->view->getInstance()->error_failure("The arguments must have a " + this->imageExtension(param[0]) + " file.\n");
+			exit(EXIT_FAILURE);
+		}
+		if (isFilePGM && !this->folder.empty())
+		{
+			this->view->getInstance()->error_failure("-dir processes every image of a folder, it cannot be used with a " + this->imageExtension(param[0]) + " file.\n");
+			exit(EXIT_FAILURE);
+		}
+		if (this->packGuardBits >= 0 && (param[2] || param[4] || param[5] || this->bandRows != 0))
+		{
+			this->view->getInstance()->error_failure("-pack stores the ciphertexts on bytes, it cannot be used with -d, -olsbr32, -olsbr16 or -band.\n");
+			exit(EXIT_FAILURE);
+		}
+		if (keyBits != 0 || safePrimes || param[8])
+		{
+			if (!param[0] || param[1] || isPQ)
+			{
+				this->view->getInstance()->error_failure("-bits and -safe generate p and q, they are only available at encryption without p, q or key file, or at keygen.\n");
+				exit(EXIT_FAILURE);
+			}
+			if (keyBits == 0)
+			{
+				this->view->getInstance()->error_failure("The number of bits of n must be specified with -bits.\n");
+				exit(EXIT_FAILURE);
+			}
+			// An image is refused before its key overwrites the key files, a key without image
+			// may be meant for -pack.
+			unsigned maxBits = this->maxImageKeyBits(this->packGuardBits >= 0);
+			if (!param[8] && keyBits > maxBits)
+			{
+				this->view->getInstance()->error_failure("The images of these options need a n of at most " + to_string(maxBits) + " bits" + (this->packGuardBits >= 0 ? "" : ", the larger keys are only for -pack of ./PaillierPgm.out") + ".\n");
+				exit(EXIT_FAILURE);
+			}
+			if (param[8] && keyBits > this->maxImageKeyBits(false))
+			{
+				this->view->getInstance()->error_warning("A n of more than " + to_string(this->maxImageKeyBits(false)) + " bits only encrypts images with -pack.\n");
+			}
+			this->generateKeyPrimes(keyBits, safePrimes, this->getThreads());
+		}
+		if (param[1] == true && !isFileBIN)
+		{
+			this->view->getInstance()->error_failure("The argument after -k or dec must be a .bin file.\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+}
+
+void PaillierControllerPGM::printHelp()
+{
+	this->view->getInstance()->help("./PaillierPgm.out\nNAME\n \t./PaillierPgm.out - Encrypt or decrypt .pgm file\n\nSYNOPSIS\n\t./PaillierPgm.out [MODE]... [OPTIONS]... [FILE]...	\n\nDESCRIPTION\n	Program to encrypt or decrypt portable graymap file format.	\n\nOPTIONS	\n\t./Paillier_pgm_main.out encryption [ARGUMENTS] [FILE.PGM]	\n\t./Paillier_pgm_main.out encrypt [ARGUMENTS] [FILE.PGM]	\n\t./Paillier_pgm_main.out enc [ARGUMENTS] [FILE.PGM]	\n\t./Paillier_pgm_main.out e [ARGUMENTS] [FILE.PGM]\n\t\t encrypt file.\n	\n\t./Paillier_pgm_main.out decryption [PRIVATE KEY FILE .BIN] [FILE.PGM] [ARGUMENTS]	\n\t./Paillier_pgm_main.out decrypt [PRIVATE KEY FILE .BIN] [FILE.PGM] [ARGUMENTS]	\n\t./Paillier_pgm_main.out dec [PRIVATE KEY FILE .BIN] [FILE.PGM] [ARGUMENTS]	\n\t./Paillier_pgm_main.out d [PRIVATE KEY FILE .BIN] [FILE.PGM] [ARGUMENTS]*\n\t\tdecrypt file.	\n\t\tThe image to encrypt or to decrypt can be specify after the key or the options, or at the end.	\n	\n\t./Paillier_pgm_main.out encryption [p] [q] [FILE.PGM]	\n\t\t Encryption mode where you specify p and q arguments. p and q are prime number where pgcd(p * q,p-1 * q-1) = 1.	\n\n\t-k, -key	\n\t\t specify usage of private or public key, followed by file.bin, your key file. Encryption mode where you specify your public key file with format .bin.	\n\n\t./Paillier_pgm_main.out encryption -k [PUBLIC KEY FILE .BIN] [FILE.PGM]	\n\t./Paillier_pgm_main.out encryption -key [PUBLIC KEY FILE .BIN] [FILE.PGM]	\n\t./Paillier_pgm_main.out decryption -k [PRIVATE KEY FILE .BIN] [FILE.PGM]	\n\t\tdecryption mode where you specify your private key with format .bin. The option -k is optional, because it\'s obligatory to specify private key at decryption. The private key also stores p and q, but the decryption only uses them (CRT) from a n of 32 bits, with -pack : below, the standard decryption is faster.\n\n\t-distribution, -distr, -d	\n\t\tto split encrypted pixel on two pixel.\n	\n\t-histogramexpansion,-hexp	\n\t\tto specify during **encryption** that we want to transform the histogram befor image encryption.\n\n\t-optlsbr32, -olsbr32\n\tto specify that we want to use bit compression with encrypted through optimized r generation mod(32), so free 5 LSB.\n\n\t-optlsbr16, -olsbr16\n\tto specify that we want to use bit compression with encrypted through optimized r generation mod(16), so free 4 LSB.\n\n\t-lookuptable, -lut\n\tto specify during **decryption** that we want to decrypt through a table of every ciphertext, built once and saved next to the private key (key_lut.bin).\n\n\t-threads, -t [N]\n\tto encrypt or decrypt the pixels with N threads, 0 for the number of cores (1 by default).\n\n\t-directory, -dir [FOLDER]\n\tinstead of a .pgm file, to encrypt every image of the folder, or to decrypt every encrypted image (_E.pgm) of the folder, with the key loaded once.\n\n\t-band [N]\n\tto stream the image by bands of N rows, only one band is in memory at a time, 0 for the whole image (by default).\n\n\t-pack [G]\n\tto pack several pixels in each ciphertext when n has more than 8 bits : k = (bits of n - 1) / (8 + G) pixels per ciphertext, with G guard bits above each pixel (2 by default) so that up to 2^G encrypted images can be added later, their sums decrypting to a 16-bit image. The encrypted image stores each ciphertext on bytes and records the layout in its header, -pack must also be given at decryption. Not available with -d, -olsbr32, -olsbr16 and -band.\n\n\t-stats\n\tto print at the end the time spent in each stage (header, reading, histogram expansion, encryption, decryption, bit packing, writing) and the counters of re-encryptions and of random r rejected.\n\n\t./Paillier_pgm_main.out keygen -bits [N] [-safe] [-t N]\n\t./Paillier_pgm_main.out kg -bits [N] [-safe] [-t N]\n\t\tgenerate a key pair with a n of N bits and save it to Paillier_private_key.bin and Paillier_public_key.bin, without image.\n\n\t-bits [N]\n\tat **encryption** or keygen, instead of p and q, to generate random balanced primes p and q with a n of N bits (8 to 32). Without -pack the images need a n of 8 bits, the larger keys are only for -pack. An 8-bit n is always 11 x 13 = 143.\n\n\t-safe\n\twith -bits, to generate safe primes (p = 2p\' + 1 with p\' prime), n of 12 to 32 bits.\n\n\t./Paillier_pgm_main.out daemon [-public PUBLIC KEY FILE .BIN] [-private PRIVATE KEY FILE .BIN] [-socket PATH] [-t N] [-band N] [-lut]\n\t./Paillier_pgm_main.out serve [ARGUMENTS]\n\t\tkeep the keys and their tables in memory and encrypt or decrypt the images or pixel buffers sent by ./PaillierClient.out on the Unix socket PATH (/tmp/PaillierPgm.sock by default), until a client asks it to stop.\n\n\t./Paillier_pgm_main.out eval -k [PUBLIC KEY FILE .BIN] [FILE_E.PGM] [-add OTHER_E.PGM] [-addconst K] [-mulconst S] [-t N] [-stats]\n\t\tapply operations to an encrypted image without decrypting it, in the order of the command line, and write the result to FILE_E_H.pgm, which is decrypted with the options of FILE_E.pgm. -add adds the pixels of another image encrypted with the same key and options, -addconst adds K to every pixel, -mulconst multiplies every pixel by S. The results are modulo n. For an image encrypted with -pack, the operations whose pixels could reach 2^(8 + G) are refused, and the pixels above 255 decrypt to a 16-bit image.\n\t\t-downscale F writes instead an image F times smaller, each of its pixels being the sum of a block of F x F pixels, and -sum writes the sum of all the pixels, or -region X Y W H of the pixels of the region of W x H pixels from column X and row Y, to the 1-pixel image FILE_E_S.pgm. The sums must stay below n, so they need an image of one pixel per ciphertext encrypted with -pack on a larger key (e.g. -bits 32 -pack 16), whose sums are decrypted with -pack to a 16-bit image, or printed when they do not fit in 16 bits.\n\n");
+}
+
+void PaillierControllerPGM::loadDecryptionTable()
+{
+	PaillierPrivateKey privateKey = this->model->getInstance()->getPrivateKey();
+	if (!DecryptionTable::isSupported(privateKey))
+	{
+		this->view->getInstance()->error_warning("n is too large for a decryption table, decryption without table.\n");
+		return;
+	}
+
+	string s_table_file = DecryptionTable::pathForKey(this->getCKeyFile());
+	if (this->decryptionTable.load(s_table_file, privateKey))
+	{
+		return;
+	}
+
+	this->decryptionTable.build(privateKey, *this->threadPool);
+	if (!this->decryptionTable.save(s_table_file))
+	{
+		this->view->getInstance()->error_warning("Error ! Writing " + s_table_file + ", the decryption table is not saved.\n");
+	}
+}
+
+// The encrypted images store a ciphertext per 16-bit pixel, wider classes have no PGM layout.
+const PaillierControllerPGM::ImageKernelEntry PaillierControllerPGM::IMAGE_KERNELS[] = {
+	{&Paillier<uint8_t, uint16_t>::supportsKey, &PaillierControllerPGM::processImageWith<uint8_t, uint16_t>},
+};
+
+// The packed plaintexts are below n < 2³², the ciphertexts are stored on as many bytes as n² needs.
+const PaillierControllerPGM::ImageKernelEntry PaillierControllerPGM::PACKED_KERNELS[] = {
+	{&Paillier<uint32_t, uint32_t>::supportsKey, &PaillierControllerPGM::processPackedImageWith<uint32_t, uint32_t>},
+	{&Paillier<uint32_t, uint64_t>::supportsKey, &PaillierControllerPGM::processPackedImageWith<uint32_t, uint64_t>},
+};
+
+unsigned PaillierControllerPGM::maxImageKeyBits(bool packed) const
+{
+	unsigned bits = PrimeGenerator::MAX_BITS;
+	while (bits > 0 && imageKernelFor((1ULL << bits) - 1, packed) == NULL)
+	{
+		bits--;
+	}
+	return bits;
+}
+
+PaillierControllerPGM::ImageKernel PaillierControllerPGM::imageKernelFor(uint64_t n, bool packed)
+{
+	auto find = [n](const auto &kernels) -> ImageKernel
+	{
+		for (const ImageKernelEntry &entry : kernels)
+		{
+			if (entry.supportsKey(n))
+			{
+				return entry.kernel;
+			}
+		}
+		return NULL;
+	};
+	return packed ? find(PACKED_KERNELS) : find(IMAGE_KERNELS);
+}
+
+void PaillierControllerPGM::processImage(string s_file, bool isEncryption, bool distributeOnTwo, bool recropPixels, bool optimisationLSB32, bool optimisationLSB16)
+{
+	ImageKernel kernel = imageKernelFor(this->model->getInstance()->getN(), this->packGuardBits >= 0);
+	if (kernel == NULL)
+	{
+		failImage("n value not supported.");
+	}
+	(this->*kernel)(s_file, isEncryption, distributeOnTwo, recropPixels, optimisationLSB32, optimisationLSB16);
+}
+
+bool PaillierControllerPGM::isPlainImage(const string &path)
+{
+	// The outputs of eval (_E_H.pgm, _E_S.pgm, ...) have no fixed suffix, they are recognised by
+	// their header: a maximum value of n or n^2, or the comment of a packed layout.
+	PgmView image;
+	if (!image.open(path.c_str(), 1))
+	{
+		// Kept to report the error when the image is processed.
+		return true;
+	}
+	bool plain = image.getMaxValue() == 255 && image.getComment().find("paillier-slots") == string::npos;
+	image.close();
+	return plain;
+}
+
+void PaillierControllerPGM::processFolder(bool isEncryption, bool distributeOnTwo, bool recropPixels, bool optimisationLSB32, bool optimisationLSB16)
+{
+	vector<string> paths, images;
+	filesystemPGM::getFilePathsOfPGMFilesFromFolder(paths, this->folder);
+	sort(paths.begin(), paths.end());
+	for (const string &path : paths)
+	{
+		bool isEncrypted = this->endsWith(path, "_E.pgm");
+		bool isDecrypted = this->endsWith(path, "_D.pgm");
+		if (isEncryption ? !isEncrypted && !isDecrypted && this->isPlainImage(path) : isEncrypted)
+		{
+			images.push_back(path);
+		}
+	}
+	if (images.empty())
+	{
+		this->view->getInstance()->error_failure("No image to " + string(isEncryption ? "encrypt" : "decrypt") + " in the folder " + this->folder + ".\n");
+		exit(EXIT_FAILURE);
+	}
+
+	uint64_t bytes = 0;
+	for (const string &image : images)
+	{
+		bytes += std::filesystem::file_size(image);
+	}
+
+	// The tables derived from the key are built before the images share them, the table of
+	// g^m by the first image that needs it (see GmTable::forKey).
+	if (isEncryption && (optimisationLSB32 || optimisationLSB16))
+	{
+		this->getZeroLsbTable(optimisationLSB32 ? 5 : 4);
+	}
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	threadPool->parallelFor(images.size(), [&](size_t begin, size_t end)
+							{
+		for (size_t i = begin; i < end; i++)
+		{
+			this->processImage(images[i], isEncryption, distributeOnTwo, recropPixels, optimisationLSB32, optimisationLSB16);
+		} });
+	double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	double megabytes = bytes / 1e6;
+	printf("%zu images %s, %.2f MB in %.3f s : %.2f images/s, %.2f MB/s\n", images.size(), isEncryption ? "encrypted" : "decrypted", megabytes, elapsed, images.size() / elapsed, megabytes / elapsed);
+}
+
+void PaillierControllerPGM::checkDaemonParameters(char *arg_in[], int size_arg)
+{
+	string publicKeyFile, privateKeyFile;
+	bool useDecryptionTable = false;
+
+	// The paths are kept as given, only the options are case-insensitive.
+	for (int i = 2; i < size_arg; i++)
+	{
+		string option = arg_in[i];
+		std::transform(option.begin(), option.end(), option.begin(), ::tolower);
+
+		if (option == "-public" || option == "-private")
+		{
+			if (i + 1 >= size_arg || !this->endsWith(arg_in[i + 1], ".bin") || !std::filesystem::is_regular_file(arg_in[i + 1]))
+			{
+				this->view->getInstance()->error_failure("The argument after " + option + " must be an existing .bin file.\n");
+				exit(EXIT_FAILURE);
+			}
+			(option == "-public" ? publicKeyFile : privateKeyFile) = arg_in[i + 1];
+			i++;
+		}
+		else if (option == "-socket")
+		{
+			if (i + 1 >= size_arg)
+			{
+				this->view->getInstance()->error_failure("The argument after -socket must be the path of the socket.\n");
+				exit(EXIT_FAILURE);
+			}
+			this->socketPath = arg_in[i + 1];
+			i++;
+		}
+		else if (option == "-t" || option == "-threads")
+		{
+			if (i + 1 >= size_arg || !isdigit(arg_in[i + 1][0]))
+			{
+				this->view->getInstance()->error_failure("The argument after -threads must be a number of threads (0 for the number of cores).\n");
+				exit(EXIT_FAILURE);
+			}
+			this->setThreads(atoi(arg_in[i + 1]));
+			i++;
+		}
+		else if (option == "-band")
+		{
+			if (i + 1 >= size_arg || !isdigit(arg_in[i + 1][0]))
+			{
+				this->view->getInstance()->error_failure("The argument after -band must be a number of rows (0 for the whole image).\n");
+				exit(EXIT_FAILURE);
+			}
+			this->setBandRows(atoi(arg_in[i + 1]));
+			i++;
+		}
+		else if (option == "-lut" || option == "-lookuptable")
+		{
+			useDecryptionTable = true;
+		}
+		else
+		{
+			this->view->getInstance()->error_failure("The argument " + std::string(arg_in[i]) + " is not available.\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	if (publicKeyFile.empty() && privateKeyFile.empty())
+	{
+		this->view->getInstance()->error_failure("The daemon needs a key, -public to encrypt and -private to decrypt.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	// The private key is read last, c_key_file then names it for the decryption table.
+	if (!publicKeyFile.empty())
+	{
+		this->setCKeyFile(&publicKeyFile[0]);
+		this->readKeyFile(true);
+		this->hasPublicKey = true;
+	}
+	if (!privateKeyFile.empty())
+	{
+		this->setCKeyFile(&privateKeyFile[0]);
+		this->readKeyFile(false);
+		this->hasPrivateKey = true;
+	}
+	if (this->hasPublicKey && this->hasPrivateKey && this->model->getInstance()->getPublicKey().getN() != this->model->getInstance()->getPrivateKey().getN())
+	{
+		this->view->getInstance()->error_failure("The public key and the private key do not have the same n.\n");
+		exit(EXIT_FAILURE);
+	}
+	if (imageKernelFor(this->model->getInstance()->getN()) == NULL)
+	{
+		this->view->getInstance()->error_failure("n value not supported.");
+		exit(EXIT_FAILURE);
+	}
+	if (useDecryptionTable && this->hasPrivateKey)
+	{
+		this->loadDecryptionTable();
+	}
+}
+
+void PaillierControllerPGM::serve()
+{
+	if (!this->listener.listen(this->socketPath.c_str()))
+	{
+		this->view->getInstance()->error_failure("Error ! Listening on the socket " + this->socketPath + ".\n");
+		exit(EXIT_FAILURE);
+	}
+
+	// The tables of the compressed encryptions are built before the first request, the table
+	// of g^m by the first encryption, and all of them stay for the next requests.
+	if (this->hasPublicKey)
+	{
+		this->getZeroLsbTable(5);
+		this->getZeroLsbTable(4);
+	}
+	this->resident = true;
+	printf("Listening on %s with %u threads\n", this->socketPath.c_str(), this->getThreads());
+	fflush(stdout);
+
+	while (true)
+	{
+		UnixSocket client = this->listener.accept();
+		std::lock_guard<std::mutex> lock(clientsMutex);
+		if (!client.isOpen() || stopping)
+		{
+			break;
+		}
+		clients++;
+		std::thread([this](UnixSocket connection)
+					{
+			this->serveClient(connection);
+			connection.close();
+			std::lock_guard<std::mutex> lock(clientsMutex);
+			clients--;
+			clientsDone.notify_all(); },
+					std::move(client))
+			.detach();
+	}
+
+	std::unique_lock<std::mutex> lock(clientsMutex);
+	clientsDone.wait(lock, [this]
+					 { return clients == 0; });
+	this->listener.close();
+	unlink(this->socketPath.c_str());
+	printf("Daemon stopped\n");
+}
+
+void PaillierControllerPGM::serveClient(UnixSocket &client)
+{
+	string line;
+	while (client.readLine(line))
+	{
+		size_t space = line.find(' ');
+		string request = line.substr(0, space);
+		string arguments = space == string::npos ? "" : line.substr(space + 1);
+
+		if (request == DaemonProtocol::ENCRYPT || request == DaemonProtocol::DECRYPT)
+		{
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			string reply = this->runFileRequest(arguments, request == DaemonProtocol::ENCRYPT);
+			double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			printf("%s %s : %s in %.3f s\n", request.c_str(), arguments.c_str(), reply.c_str(), elapsed);
+			fflush(stdout);
+			if (!client.writeLine(reply))
+			{
+				return;
+			}
+		}
+		else if (request == DaemonProtocol::ENCRYPT_PIXELS || request == DaemonProtocol::DECRYPT_PIXELS)
+		{
+			if (!this->runPixelsRequest(client, arguments, request == DaemonProtocol::ENCRYPT_PIXELS))
+			{
+				return;
+			}
+		}
+		else if (request == DaemonProtocol::SHUTDOWN)
+		{
+			{
+				std::lock_guard<std::mutex> lock(clientsMutex);
+				stopping = true;
+			}
+			client.writeLine(DaemonProtocol::OK);
+			// Wakes up the accept of serve, which then waits for the other clients.
+			this->listener.shutdown();
+			return;
+		}
+		else
+		{
+			client.writeLine(string(DaemonProtocol::ERROR) + " Unknown request " + request + ".");
+		}
+	}
+}
+
+string PaillierControllerPGM::runFileRequest(const string &arguments, bool isEncryption)
+{
+	bool distributeOnTwo = false, recropPixels = false, optimisationLSB32 = false, optimisationLSB16 = false;
+	string error = string(DaemonProtocol::ERROR) + " ";
+
+	// The options come first, the image is the rest of the line, spaces included.
+	size_t position = 0;
+	while ((position = arguments.find_first_not_of(' ', position)) != string::npos && arguments[position] == '-')
+	{
+		size_t next = arguments.find(' ', position);
+		string option = arguments.substr(position, next - position);
+		position = next;
+		if (option == "-d" || option == "-distr" || option == "-distribution")
+		{
+			distributeOnTwo = true;
+		}
+		else if (isEncryption && (option == "-hexp" || option == "-histogramexpansion"))
+		{
+			recropPixels = true;
+		}
+		else if (option == "-olsbr32" || option == "-optlsbr32")
+		{
+			optimisationLSB32 = true;
+		}
+		else if (option == "-olsbr16" || option == "-optlsbr16")
+		{
+			optimisationLSB16 = true;
+		}
+		else
+		{
+			return error + "The option " + option + " is not available.";
+		}
+	}
+	string s_file = position == string::npos ? "" : arguments.substr(position);
+
+	if (optimisationLSB32 && optimisationLSB16)
+	{
+		return error + "-olsbr32 and -olsbr16 cannot be used together.";
+	}
+	if (isEncryption ? !this->hasPublicKey : !this->hasPrivateKey)
+	{
+		return error + "The daemon has no " + (isEncryption ? "public" : "private") + " key.";
+	}
+	// The daemon does not run in the directory of its clients, a relative path would name
+	// another file.
+	if (s_file.empty() || s_file[0] != '/')
+	{
+		return error + "The image " + s_file + " must be given by an absolute path.";
+	}
+	// The image names are copied in buffers of 250 characters, suffix _E or _D included.
+	if (!this->endsWith(s_file, ".pgm") || s_file.size() > 245)
+	{
+		return error + "The image must be a .pgm file of less than 246 characters.";
+	}
+
+	// The image is checked here to answer before any output is created, the other errors of
+	// processImage are thrown by failImage.
+	bool compressed = optimisationLSB32 || optimisationLSB16;
+	size_t bytesPerPixel = isEncryption || distributeOnTwo || compressed ? 1 : 2;
+	PgmView image;
+	if (!image.open(s_file.c_str(), bytesPerPixel, !isEncryption && compressed))
+	{
+		return error + "The image " + s_file + " cannot be opened or is not a valid PGM image.";
+	}
+	image.close();
+
+	try
+	{
+		this->processImage(s_file, isEncryption, distributeOnTwo, recropPixels, optimisationLSB32, optimisationLSB16);
+	}
+	catch (const std::runtime_error &failure)
+	{
+		// The messages of failImage end with a new line, the reply is a single line.
+		string message = failure.what();
+		message.erase(message.find_last_not_of('\n') + 1);
+		return error + message;
+	}
+	return string(DaemonProtocol::OK) + " " + s_file.substr(0, s_file.size() - 4) + (isEncryption ? "_E.pgm" : "_D.pgm");
+}
+
+bool PaillierControllerPGM::runPixelsRequest(UnixSocket &client, const string &arguments, bool isEncryption)
+{
+	string error = string(DaemonProtocol::ERROR) + " ";
+	char *end = NULL;
+	unsigned long long count = strtoull(arguments.c_str(), &end, 10);
+	if (arguments.empty() || !isdigit(arguments[0]) || *end != '\0' || count > DaemonProtocol::MAX_PIXELS)
+	{
+		// The size of the pixels that follow is unknown, the connection is closed.
+		client.writeLine(error + "The number of pixels must be at most " + to_string(DaemonProtocol::MAX_PIXELS) + ".");
+		return false;
+	}
+
+	std::vector<uint8_t> input(isEncryption ? count : 2 * count);
+	if (!client.readExact(input.data(), input.size()))
+	{
+		return false;
+	}
+	if (isEncryption ? !this->hasPublicKey : !this->hasPrivateKey)
+	{
+		return client.writeLine(error + "The daemon has no " + (isEncryption ? "public" : "private") + " key.");
+	}
+
+	std::vector<uint8_t> output(isEncryption ? 2 * count : count);
+	if (isEncryption)
+	{
+		this->encryptPixels(input.data(), count, output.data());
+	}
+	else
+	{
+		this->decryptPixels(input.data(), count, output.data());
+	}
+	return client.writeLine(string(DaemonProtocol::OK) + " " + to_string(output.size())) && client.writeAll(output.data(), output.size());
+}
+
+void PaillierControllerPGM::encryptPixels(const uint8_t *pixels, size_t count, uint8_t *encrypted)
+{
+	uint64_t n = model->getInstance()->getPublicKey().getN();
+	uint64_t g = model->getInstance()->getPublicKey().getG();
+	Paillier<uint8_t, uint16_t> paillier;
+	paillier.buildGmTable(n, g);
+
+	parallelPixels(count, [&](size_t begin, size_t end)
+				   {
+		PROFILE_STAGE(ENCRYPTION);
+		PROFILE_COUNT(PIXELS_ENCRYPTED, end - begin);
+		Paillier<uint8_t, uint16_t> paillierThread = paillier;
+		NoisePool &noise = NoisePool::threadInstance(n);
+		noise.expect(end - begin);
+		for (size_t i = begin; i < end; i++)
+		{
+			splitPixel(paillierThread.paillierEncryptionWithNoise(n, g, pixels[i], noise.next()), encrypted + 2 * i);
+		} });
+}
+
+void PaillierControllerPGM::decryptPixels(const uint8_t *encrypted, size_t count, uint8_t *pixels)
+{
+	PaillierPrivateKey privateKey = model->getInstance()->getPrivateKey();
+	Paillier<uint8_t, uint16_t> paillier;
+
+	parallelPixels(count, [&](size_t begin, size_t end)
+				   {
+		PROFILE_STAGE(DECRYPTION);
+		PROFILE_COUNT(PIXELS_DECRYPTED, end - begin);
+		Paillier<uint8_t, uint16_t> paillierThread = paillier;
+		for (size_t i = begin; i < end; i++)
+		{
+			pixels[i] = decryptPixel(paillierThread, privateKey, mergePixel(encrypted + 2 * i));
+		} });
+}
+
+bool PaillierControllerPGM::checkEvalParameters(char *arg_in[], int size_arg)
+{
+	string publicKeyFile;
+	bool printStats = false;
+
+	// The paths are kept as given, only the options are case-insensitive.
+	for (int i = 2; i < size_arg; i++)
+	{
+		string option = arg_in[i];
+		std::transform(option.begin(), option.end(), option.begin(), ::tolower);
+
+		if (option == "-k" || option == "-key")
+		{
+			if (i + 1 >= size_arg || !this->endsWith(arg_in[i + 1], ".bin") || !std::filesystem::is_regular_file(arg_in[i + 1]))
+			{
+				this->view->getInstance()->error_failure("The argument after -k must be an existing .bin file.\n");
+				exit(EXIT_FAILURE);
+			}
+			publicKeyFile = arg_in[i + 1];
+			i++;
+		}
+		else if (option == "-add")
+		{
+			if (i + 1 >= size_arg || !this->endsWith(arg_in[i + 1], ".pgm") || !std::filesystem::is_regular_file(arg_in[i + 1]))
+			{
+				this->view->getInstance()->error_failure("The argument after -add must be an existing encrypted .pgm file.\n");
+				exit(EXIT_FAILURE);
+			}
+			this->evalOperations.push_back({EvalOperation::ADD_IMAGE, arg_in[i + 1], 0});
+			i++;
+		}
+		else if (option == "-addconst" || option == "-mulconst")
+		{
+			char *end = NULL;
+			long long value = i + 1 < size_arg ? strtoll(arg_in[i + 1], &end, 10) : 0;
+			if (i + 1 >= size_arg || end == arg_in[i + 1] || *end != '\0' || (option == "-mulconst" && value < 0))
+			{
+				this->view->getInstance()->error_failure("The argument after " + option + (option == "-addconst" ? " must be an integer.\n" : " must be a positive integer.\n"));
+				exit(EXIT_FAILURE);
+			}
+			this->evalOperations.push_back({option == "-addconst" ? EvalOperation::ADD_CONSTANT : EvalOperation::MUL_SCALAR, "", (int64_t)value});
+			i++;
+		}
+		else if (option == "-t" || option == "-threads")
+		{
+			if (i + 1 >= size_arg || !isdigit(arg_in[i + 1][0]))
+			{
+				this->view->getInstance()->error_failure("The argument after -threads must be a number of threads (0 for the number of cores).\n");
+				exit(EXIT_FAILURE);
+			}
+			this->setThreads(atoi(arg_in[i + 1]));
+			i++;
+		}
+		else if (option == "-downscale" || option == "-ds")
+		{
+			if (i + 1 >= size_arg || !isdigit(arg_in[i + 1][0]) || atoi(arg_in[i + 1]) < 1)
+			{
+				this->view->getInstance()->error_failure("The argument after -downscale must be the side of the blocks summed, at least 1.\n");
+				exit(EXIT_FAILURE);
+			}
+			this->evalFactor = atoi(arg_in[i + 1]);
+			i++;
+		}
+		else if (option == "-sum")
+		{
+			this->evalSum = true;
+		}
+		else if (option == "-region")
+		{
+			for (int j = 1; j <= 4; j++)
+			{
+				if (i + j >= size_arg || !isdigit(arg_in[i + j][0]))
+				{
+					this->view->getInstance()->error_failure("-region must be followed by the column, the row, the width and the height of the region.\n");
+					exit(EXIT_FAILURE);
+				}
+				this->evalRegion[j - 1] = strtoull(arg_in[i + j], NULL, 10);
+			}
+			if (this->evalRegion[2] == 0 || this->evalRegion[3] == 0)
+			{
+				this->view->getInstance()->error_failure("The region of -region must not be empty.\n");
+				exit(EXIT_FAILURE);
+			}
+			this->evalSum = true;
+			i += 4;
+		}
+		else if (option == "-stats")
+		{
+			printStats = true;
+		}
+		else if (this->endsWith(arg_in[i], ".pgm") && this->evalImage.empty() && std::filesystem::is_regular_file(arg_in[i]))
+		{
+			this->evalImage = arg_in[i];
+		}
+		else
+		{
+			this->view->getInstance()->error_failure("The argument " + std::string(arg_in[i]) + " is not available.\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	if (publicKeyFile.empty())
+	{
+		this->view->getInstance()->error_failure("eval needs the public key of the encrypted image, -k PUBLIC_KEY.bin.\n");
+		exit(EXIT_FAILURE);
+	}
+	if (this->evalImage.empty())
+	{
+		this->view->getInstance()->error_failure("The arguments must have an existing .pgm file.\n");
+		exit(EXIT_FAILURE);
+	}
+	if (this->evalOperations.empty() && this->evalFactor == 0 && !this->evalSum)
+	{
+		this->view->getInstance()->error_failure("eval needs at least one operation, -add, -addconst, -mulconst, -downscale, -sum or -region.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	this->setCKeyFile(&publicKeyFile[0]);
+	this->readKeyFile(true);
+
+	// The sums of 16-bit ciphertexts would wrap modulo n < 256 past a single pixel, and the
+	// slots of a ciphertext are neighbouring pixels of a row, so the blocks and the regions
+	// are only summed on the images of one slot per ciphertext.
+	if (this->evalFactor > 0 || this->evalSum)
+	{
+		PgmView image;
+		SlotPacking layout;
+		checkMapping(image.open(this->evalImage.c_str(), 1), this->evalImage.c_str());
+		if (!SlotPacking::fromComment(image.getComment(), this->model->getInstance()->getPublicKey().getN(), layout) || layout.getSlots() != 1)
+		{
+			this->view->getInstance()->error_failure("Error ! -downscale, -sum and -region need an image of one pixel per ciphertext, encrypted with -pack and enough guard bits, e.g. -bits 32 -pack 16.\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+	return printStats;
+}
+
+void PaillierControllerPGM::evaluate()
+{
+	char cNomImgLue[250];
+	strcpy(cNomImgLue, this->evalImage.c_str());
+
+	string s_file = this->evalImage;
+	string toErase = ".pgm";
+	size_t pos = s_file.find(".pgm");
+	s_file.erase(pos, toErase.length());
+	string s_fileNew = s_file + "_H.pgm";
+	char cNomImgEcrite[250];
+	strcpy(cNomImgEcrite, s_fileNew.c_str());
+
+	uint64_t n = this->model->getInstance()->getPublicKey().getN();
+	uint64_t g = this->model->getInstance()->getPublicKey().getG();
+	uint64_t n2 = n * n;
+
+	// A packed image records its layout in its header, the others store a ciphertext per
+	// 16-bit pixel, or per two 8-bit pixels with -d (the same bytes, little-endian).
+	PgmView imageIn;
+	checkMapping(imageIn.open(cNomImgLue, 1), cNomImgLue);
+	int nH = imageIn.getHeight(), nW = imageIn.getWidth();
+	uint64_t maxValue = imageIn.getMaxValue();
+	SlotPacking layout;
+	bool packed = SlotPacking::fromComment(imageIn.getComment(), n, layout);
+	size_t cipherBytes = packed ? layout.getCipherBytes() : 2;
+	size_t payloadSize = (size_t)nW * nH * (maxValue > 255 ? 2 : 1);
+	bool validLayout = packed ? maxValue == 255 : HomomorphicKernel::supports(n2) && (maxValue == static_cast<uint16_t>(n2) || maxValue == static_cast<uint8_t>(n));
+	if (!validLayout || imageIn.dataSize() < payloadSize || payloadSize % cipherBytes != 0)
+	{
+		this->view->getInstance()->error_failure("Error ! " + this->evalImage + " is not an image encrypted with this key, without -olsbr32 or -olsbr16.\n");
+		exit(EXIT_FAILURE);
+	}
+	size_t nbCiphers = payloadSize / cipherBytes;
+	size_t cols = nbCiphers / nH;
+	if (this->evalSum && this->evalRegion[2] == 0)
+	{
+		this->evalRegion[2] = cols;
+		this->evalRegion[3] = nH;
+	}
+	else if (this->evalSum && (this->evalRegion[0] >= cols || this->evalRegion[1] >= (size_t)nH || this->evalRegion[2] > cols - this->evalRegion[0] || this->evalRegion[3] > nH - this->evalRegion[1]))
+	{
+		this->view->getInstance()->error_failure("Error ! The region of -region is not inside the image of " + std::to_string(cols) + " x " + std::to_string(nH) + " pixels.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	// Largest plaintext of a ciphertext, saturated : the value of a slot for a packed image,
+	// any residue for the others, whose pixels may already be sums modulo n.
+	uint64_t maxPlaintext = packed ? layout.getMaxValue() : n - 1;
+	auto addBound = [](uint64_t a, uint64_t b) { uint64_t r; return __builtin_add_overflow(a, b, &r) ? UINT64_MAX : r; };
+	auto mulBound = [](uint64_t a, uint64_t b) { uint64_t r; return __builtin_mul_overflow(a, b, &r) ? UINT64_MAX : r; };
+
+	// The images added are mapped once, the constants become factors g^k mod n².
+	MontgomeryContext context(n2);
+	std::vector<std::unique_ptr<PgmView>> operands(this->evalOperations.size());
+	std::vector<uint64_t> values(this->evalOperations.size());
+	for (size_t j = 0; j < this->evalOperations.size(); j++)
+	{
+		const EvalOperation &operation = this->evalOperations[j];
+		if (operation.kind == EvalOperation::ADD_IMAGE)
+		{
+			operands[j].reset(new PgmView());
+			checkMapping(operands[j]->open(operation.image.c_str(), 1), operation.image.c_str());
+			SlotPacking operandLayout;
+			bool sameLayout = packed ? SlotPacking::fromComment(operands[j]->getComment(), n, operandLayout) && operandLayout.matches(layout) : operands[j]->getComment() == imageIn.getComment();
+			if (operands[j]->getWidth() != nW || operands[j]->getHeight() != nH || operands[j]->getMaxValue() != maxValue || !sameLayout || operands[j]->dataSize() < payloadSize)
+			{
+				this->view->getInstance()->error_failure("Error ! " + operation.image + " is not encrypted like " + this->evalImage + ", the images must have the same size and options.\n");
+				exit(EXIT_FAILURE);
+			}
+			maxPlaintext = packed ? addBound(maxPlaintext, operandLayout.getMaxValue()) : n - 1;
+		}
+		else if (operation.kind == EvalOperation::ADD_CONSTANT)
+		{
+			uint64_t k;
+			if (packed)
+			{
+				// The constant is added to every slot, it must fit in a slot.
+				if (operation.value < 0 || operation.value >= ((int64_t)1 << layout.getSlotBits()))
+				{
+					this->view->getInstance()->error_failure("Error ! The constant of -addconst must be in [0, " + std::to_string(1 << layout.getSlotBits()) + ") for a packed image.\n");
+					exit(EXIT_FAILURE);
+				}
+				k = 0;
+				for (int slot = 0; slot < layout.getSlots(); slot++)
+				{
+					k = (k << layout.getSlotBits()) | (uint64_t)operation.value;
+				}
+			}
+			else
+			{
+				k = (uint64_t)((operation.value % (int64_t)n + (int64_t)n) % (int64_t)n);
+			}
+			values[j] = context.pow(g, k);
+			maxPlaintext = packed ? addBound(maxPlaintext, (uint64_t)operation.value) : n - 1;
+		}
+		else
+		{
+			values[j] = (uint64_t)operation.value;
+			maxPlaintext = packed ? mulBound(maxPlaintext, (uint64_t)operation.value) : n - 1;
+		}
+	}
+
+	// A slot beyond its capacity would carry into the next slot, or wrap modulo n.
+	if (packed && maxPlaintext > layout.getSlotMax())
+	{
+		this->view->getInstance()->error_failure("Error ! The pixels of these operations may reach " + (maxPlaintext == UINT64_MAX ? string("2^64") : std::to_string(maxPlaintext)) + ", which does not fit in the slots of " + this->evalImage + " (at most " + std::to_string(layout.getSlotMax()) + ") : add fewer images or smaller constants, or encrypt the images with more guard bits, -pack G.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	// The sums are exact only if the largest of them is lower than n, otherwise they would
+	// be written wrapped modulo n.
+	uint64_t maxBlockSum = mulBound(maxPlaintext, mulBound(this->evalFactor, this->evalFactor));
+	uint64_t maxRegionSum = mulBound(maxPlaintext, mulBound(this->evalRegion[2], this->evalRegion[3]));
+	bool blockWraps = this->evalFactor > 1 && maxBlockSum >= n, regionWraps = this->evalSum && this->evalRegion[2] * this->evalRegion[3] > 1 && maxRegionSum >= n;
+	if (blockWraps || regionWraps)
+	{
+		uint64_t maxSum = blockWraps ? maxBlockSum : maxRegionSum;
+		this->view->getInstance()->error_failure("Error ! The sums of " + string(blockWraps ? "-downscale" : "-sum or -region") + " may reach " + (maxSum == UINT64_MAX ? string("2^64") : std::to_string(maxSum)) + ", which does not fit in n = " + std::to_string(n) + " : sum smaller blocks or regions, or encrypt the image with -pack on a larger key, e.g. -bits 32 -pack 16.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	// The packed images record the largest value of their slots, so that the sums larger
+	// than 255 are decrypted without clamping.
+	auto recordedMax = [&](uint64_t value) { return std::min(std::max(value, SlotPacking::PIXEL_MAX), n - 1); };
+	string comment = imageIn.getComment();
+	if (packed)
+	{
+		comment = layout.forSums(layout.getWidth(), recordedMax(maxPlaintext)).toComment();
+	}
+
+	// With -downscale the image written is the downscaled one, the operations stay in memory.
+	const uint8_t *ImgIn = imageIn.data();
+	PgmView imageOut;
+	std::vector<uint8_t> evaluated;
+	uint8_t *ImgOut = NULL;
+	if (!this->evalOperations.empty() && this->evalFactor > 0)
+	{
+		evaluated.resize(payloadSize);
+		ImgOut = evaluated.data();
+	}
+	else if (!this->evalOperations.empty())
+	{
+		checkMapping(imageOut.create(cNomImgEcrite, nH, nW, maxValue, payloadSize, 0, 0, 1, comment), cNomImgEcrite);
+		ImgOut = imageOut.data();
+	}
+
+	if (!this->evalOperations.empty())
+	{
+		// Chunks of ciphertexts small enough to stay in the cache through all the operations.
+		const size_t EVAL_CHUNK = 2048;
+		parallelPixels(nbCiphers, [&](size_t begin, size_t end)
+		{
+			PROFILE_STAGE(EVALUATION);
+			if (!packed)
+			{
+				HomomorphicKernel kernel(static_cast<uint32_t>(n2));
+				for (size_t first = begin; first < end; first += EVAL_CHUNK)
+				{
+					size_t count = std::min(end - first, EVAL_CHUNK);
+					const uint8_t *source = ImgIn + 2 * first;
+					uint8_t *target = ImgOut + 2 * first;
+					for (size_t j = 0; j < this->evalOperations.size(); j++)
+					{
+						switch (this->evalOperations[j].kind)
+						{
+						case EvalOperation::ADD_IMAGE:
+							kernel.multiply(source, operands[j]->data() + 2 * first, target, count);
+							break;
+						case EvalOperation::ADD_CONSTANT:
+							kernel.multiplyBy(source, static_cast<uint32_t>(values[j]), target, count);
+							break;
+						case EvalOperation::MUL_SCALAR:
+							kernel.power(source, values[j], target, count);
+							break;
+						}
+						source = target;
+					}
+				}
+				return;
+			}
+			for (size_t i = begin; i < end; i++)
+			{
+				uint64_t c = layout.load(ImgIn + i * cipherBytes);
+				for (size_t j = 0; j < this->evalOperations.size(); j++)
+				{
+					switch (this->evalOperations[j].kind)
+					{
+					case EvalOperation::ADD_IMAGE:
+						c = context.mulMod(c, layout.load(operands[j]->data() + i * cipherBytes));
+						break;
+					case EvalOperation::ADD_CONSTANT:
+						c = context.mulMod(c, values[j]);
+						break;
+					case EvalOperation::MUL_SCALAR:
+						c = context.pow(c, values[j]);
+						break;
+					}
+				}
+				layout.store(c, ImgOut + i * cipherBytes);
+			}
+		});
+	}
+
+	// checkEvalParameters only lets the sums through for the packed images of one slot.
+	const uint8_t *ciphers = this->evalOperations.empty() ? ImgIn : ImgOut;
+	if (this->evalFactor > 0)
+	{
+		this->downscaleCiphers(ciphers, nH, cols, maxValue, layout, recordedMax(maxBlockSum), cNomImgEcrite);
+	}
+	if (this->evalSum)
+	{
+		this->sumCiphers(ciphers, cols, maxValue, layout, recordedMax(maxRegionSum), s_file + "_S.pgm");
+	}
+}
+
+void PaillierControllerPGM::downscaleCiphers(const uint8_t *ciphers, size_t rows, size_t cols, uint64_t maxValue, const SlotPacking &layout, uint64_t maxSum, const char *file)
+{
+	uint64_t n = this->model->getInstance()->getPublicKey().getN();
+	size_t factor = this->evalFactor;
+	size_t outRows = (rows + factor - 1) / factor, outCols = (cols + factor - 1) / factor;
+	size_t bytes = layout.getCipherBytes();
+
+	PgmView imageOut;
+	checkMapping(imageOut.create(file, outRows, outCols * bytes, maxValue, outRows * outCols * bytes, 0, 0, 1, layout.forSums(outCols, maxSum).toComment()), file);
+	uint8_t *ImgOut = imageOut.data();
+
+	// Each output row multiplies its factor input rows tile by tile, a tile of the partial
+	// products staying in the cache while the input rows stream through it.
+	const size_t tile = std::max((size_t)2048 / factor, (size_t)1) * factor;
+	MontgomeryContext context(n * n);
+	parallelPixels(outRows, [&](size_t begin, size_t end)
+	{
+		PROFILE_STAGE(EVALUATION);
+		std::vector<uint64_t> partial(tile);
+		for (size_t r = begin; r < end; r++)
+		{
+			size_t first = r * factor, last = std::min(rows, first + factor);
+			for (size_t x = 0; x < cols; x += tile)
+			{
+				size_t count = std::min(tile, cols - x);
+				for (size_t k = 0; k < count; k++)
+				{
+					partial[k] = layout.load(ciphers + bytes * (first * cols + x + k));
+				}
+				for (size_t y = first + 1; y < last; y++)
+				{
+					for (size_t k = 0; k < count; k++)
+					{
+						partial[k] = context.mulMod(partial[k], layout.load(ciphers + bytes * (y * cols + x + k)));
+					}
+				}
+				for (size_t k = 0; k < count; k += factor)
+				{
+					uint64_t product = partial[k];
+					for (size_t t = k + 1; t < std::min(count, k + factor); t++)
+					{
+						product = context.mulMod(product, partial[t]);
+					}
+					layout.store(product, ImgOut + bytes * (r * outCols + (x + k) / factor));
+				}
+			}
+		}
+	});
+}
+
+void PaillierControllerPGM::sumCiphers(const uint8_t *ciphers, size_t cols, uint64_t maxValue, const SlotPacking &layout, uint64_t maxSum, string file)
+{
+	uint64_t n = this->model->getInstance()->getPublicKey().getN();
+	size_t x0 = this->evalRegion[0], y0 = this->evalRegion[1], width = this->evalRegion[2], height = this->evalRegion[3];
+	size_t bytes = layout.getCipherBytes();
+
+	// Each row of the region is reduced to one ciphertext, then the products of the rows are
+	// multiplied pairwise, the threads sharing every level of the tree.
+	MontgomeryContext context(n * n);
+	std::vector<uint64_t> partial(height);
+	parallelPixels(height, [&](size_t begin, size_t end)
+	{
+		PROFILE_STAGE(EVALUATION);
+		for (size_t r = begin; r < end; r++)
+		{
+			const uint8_t *row = ciphers + bytes * ((y0 + r) * cols + x0);
+			uint64_t product = layout.load(row);
+			for (size_t k = 1; k < width; k++)
+			{
+				product = context.mulMod(product, layout.load(row + bytes * k));
+			}
+			partial[r] = product;
+		}
+	});
+	for (size_t count = height; count > 1;)
+	{
+		size_t half = count / 2;
+		parallelPixels(half, [&](size_t begin, size_t end)
+		{
+			PROFILE_STAGE(EVALUATION);
+			for (size_t i = begin; i < end; i++)
+			{
+				partial[i] = context.mulMod(partial[i], partial[count - half + i]);
+			}
+		});
+		count -= half;
+	}
+
+	PgmView imageOut;
+	checkMapping(imageOut.create(file.c_str(), 1, bytes, maxValue, bytes, 0, 0, 1, layout.forSums(1, maxSum).toComment()), file.c_str());
+	layout.store(partial[0], imageOut.data());
+}
+
+uint8_t PaillierControllerPGM::histogramExpansion(OCTET ImgPixel, bool recropPixels)
+{
+	uint8_t pixel;
+	if (recropPixels)
+	{
+		uint64_t n = model->getInstance()->getPublicKey().getN();
+		pixel = (ImgPixel * n) / 256;
+	}
+	else
+	{
+		pixel = ImgPixel;
+	}
+	return pixel;
+}
+
+std::vector<uint8_t> PaillierControllerPGM::histogramExpansion(const OCTET *ImgIn, size_t begin, size_t end, bool recropPixels)
+{
+	PROFILE_STAGE(HISTOGRAM);
+	std::vector<uint8_t> pixels(end - begin);
+	for (size_t i = begin; i < end; i++)
+	{
+		pixels[i - begin] = histogramExpansion(ImgIn[i], recropPixels);
+	}
+	return pixels;
+}
+
+void PaillierControllerPGM::printProfile()
+{
+	if (!Profiler::isEnabled())
+	{
+		this->view->getInstance()->error_warning("-stats : the program is compiled without PAILLIER_PROFILING (make PROFILING=1), nothing was recorded.\n");
+		return;
+	}
+
+	double total = 0;
+	for (int stage = 0; stage < Profiler::STAGE_COUNT; stage++)
+	{
+		total += Profiler::getSeconds(static_cast<Profiler::Stage>(stage));
+	}
+	printf("%-10s %10s %12s %7s\n", "Stage", "runs", "time (ms)", "share");
+	for (int stage = 0; stage < Profiler::STAGE_COUNT; stage++)
+	{
+		Profiler::Stage s = static_cast<Profiler::Stage>(stage);
+		double seconds = Profiler::getSeconds(s);
+		printf("%-10s %10" PRIu64 " %12.3f %6.1f%%\n", Profiler::getName(s), Profiler::getCalls(s), seconds * 1e3, total > 0 ? 100 * seconds / total : 0);
+	}
+	printf("The times are summed over the threads. Without -band, the pixels are read and written by the page faults of the encryption and decryption.\n");
+
+	uint64_t encrypted = Profiler::getCount(Profiler::PIXELS_ENCRYPTED);
+	uint64_t reencryptions = Profiler::getCount(Profiler::REENCRYPTIONS);
+	printf("Pixels encrypted : %" PRIu64 ", decrypted : %" PRIu64 "\n", encrypted, Profiler::getCount(Profiler::PIXELS_DECRYPTED));
+	printf("Re-encryptions : %" PRIu64 " (%.3f encryptions per pixel)\n", reencryptions, encrypted > 0 ? (double)(encrypted + reencryptions) / encrypted : 0);
+	printf("Random r rejected by gcd(r, n) != 1 : %" PRIu64 "\n", Profiler::getCount(Profiler::GCD_REJECTIONS));
+}
+
+/*********************** Chiffrement/Déchiffrement ***********************/
+
+void PaillierControllerPGM::compressBits_16bpp(uint16_t *ImgInEnc, size_t nbPixel, int bitsCompressed, uint8_t *ImgOutEnc, size_t nbPixelsComp)
+{
+	if(bitsCompressed > 16 || bitsCompressed < 0)
+	{
+		this->view->getInstance()->error_failure("Bits compressed must be between 0 and 16.\n");
+		exit(EXIT_FAILURE);
+	}
+	PROFILE_STAGE(PACKING);
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	// The 16 bpp packed image in little-endian is the 8 bpp packed image.
+	BitPacker::pack(ImgInEnc, nbPixel, bitsCompressed, ImgOutEnc, 2 * nbPixelsComp);
+#else
+	uint16_t *ImgOutEnc16bits = new uint16_t[nbPixelsComp];
+	BitPacker::pack(ImgInEnc, nbPixel, bitsCompressed, ImgOutEnc16bits, nbPixelsComp);
+	memcpy(ImgOutEnc, ImgOutEnc16bits, 2 * nbPixelsComp);
+	delete[] ImgOutEnc16bits;
+#endif
+}
+
+void PaillierControllerPGM::decompressBits_16bpp(const uint8_t *ImgInEnc, size_t sizeComp, int bitsCompressed, uint16_t *ImgOutEnc, size_t nbPixel)
+{
+	if(bitsCompressed > 16 || bitsCompressed < 0)
+	{
+		this->view->getInstance()->error_failure("Bits compressed must be between 0 and 16.\n");
+		exit(EXIT_FAILURE);
+	}
+	PROFILE_STAGE(PACKING);
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	BitPacker::unpack(ImgInEnc, 2 * sizeComp, bitsCompressed, ImgOutEnc, nbPixel);
+#else
+	uint16_t *ImgInEnc16bits = new uint16_t[sizeComp];
+	memcpy(ImgInEnc16bits, ImgInEnc, 2 * sizeComp);
+	BitPacker::unpack(ImgInEnc16bits, sizeComp, bitsCompressed, ImgOutEnc, nbPixel);
+	delete[] ImgInEnc16bits;
+#endif
+}
+
+pair<size_t, size_t> PaillierControllerPGM::decomposeDimension(size_t n){
+    // The closest factors are the largest divisor not above sqrt(n) and its cofactor, so the
+    // scan goes down from sqrt(n) and stops at the first divisor, sqrt(n) steps at most.
+    size_t facteur1 = (size_t)sqrtl((long double)n);
+    while (facteur1 > 1 && facteur1 * facteur1 > n) {
+        facteur1--;
+    }
+    while ((facteur1 + 1) * (facteur1 + 1) <= n) {
+        facteur1++;
+    }
+    if (facteur1 == 0) {
+        facteur1 = 1;
+    }
+    while (n % facteur1 != 0) {
+        facteur1--;
+    }
+    return make_pair(facteur1, n / facteur1);
+}
+
+pair<int, int> PaillierControllerPGM::compressedDimension(size_t nbPixelsComp, const char *path)
+{
+	pair<size_t, size_t> dimension = decomposeDimension(nbPixelsComp);
+	if (dimension.first > INT_MAX || dimension.second > INT_MAX)
+	{
+		failImage("Error ! The compressed image " + string(path) + " of " + to_string(nbPixelsComp) + " pixels has no height and width below 2^31 for its PGM header.\n");
+	}
+	return make_pair((int)dimension.first, (int)dimension.second);
+}
+
+
+
+void PaillierControllerPGM::compressBits_8bpp(uint16_t *ImgInEnc, size_t nbPixel, int bitsCompressed, uint8_t *ImgOutEnc, size_t nbPixelsComp)
+{
+	if(bitsCompressed > 16 || bitsCompressed < 0)
+	{
+		this->view->getInstance()->error_failure("Bits compressed must be between 0 and 16.\n");
+		exit(EXIT_FAILURE);
+	}
+	PROFILE_STAGE(PACKING);
+
+	// The 8 bpp image is the 16 bpp packed image split in little-endian bytes.
+	BitPacker::pack(ImgInEnc, nbPixel, bitsCompressed, ImgOutEnc, nbPixelsComp);
+}
+
+void PaillierControllerPGM::decompressBits_8bpp(const uint8_t *ImgInEnc, size_t sizeComp, int bitsCompressed, uint16_t *ImgOutEnc, size_t nbPixel)
+{
+	if(bitsCompressed > 16 || bitsCompressed < 0)
+	{
+		this->view->getInstance()->error_failure("Bits compressed must be between 0 and 16.\n");
+		exit(EXIT_FAILURE);
+	}
+	PROFILE_STAGE(PACKING);
+
+	BitPacker::unpack(ImgInEnc, sizeComp, bitsCompressed, ImgOutEnc, nbPixel);
+}
@@ -0,0 +1,62 @@
+/******************************************************************************
+ * ICAR_Interns_Library
+ *
+ * File : PaillierControllerPPM.cpp
+ *
+ * Description : Implementation of the PaillierControllerPPM class, which is a
+ * controller for the Paillier cryptosystem applied to PPM (Portable Pixmap)
+ * colour images.
+ *
+ *
+ * Author : Katia Auxilien
+ *
+ * Mail : katia.auxilien@mail.fr
+ *
+ * Date : 17 Octobre 2026
+ *
+ *******************************************************************************/
+#include "../../include/controller/PaillierControllerPPM.hpp"
+
+PaillierControllerPPM::PaillierControllerPPM(){};
+
+PaillierControllerPPM::~PaillierControllerPPM(){};
+
+string PaillierControllerPPM::imageExtension(bool isEncryption) const
+{
+	return isEncryption ? ".ppm" : ".pgm";
+}
+
+void PaillierControllerPPM::printHelp()
+{
+	this->view->getInstance()->help("./PaillierPpm.out\nNAME\n \t./PaillierPpm.out - Encrypt or decrypt .ppm file\n\nSYNOPSIS\n\t./PaillierPpm.out [MODE]... [OPTIONS]... [FILE]...	\n\nDESCRIPTION\n	Program to encrypt or decrypt portable pixmap file format. The R, G and B planes of FILE.ppm are encrypted into FILE_E.pgm, a greyscale image of three times the height (the R plane, then the G plane, then the B plane), which decrypts to FILE_E_D.ppm.	\n\nOPTIONS	\n\t./PaillierPpm.out encryption [ARGUMENTS] [FILE.PPM]	\n\t./PaillierPpm.out encrypt [ARGUMENTS] [FILE.PPM]	\n\t./PaillierPpm.out enc [ARGUMENTS] [FILE.PPM]	\n\t./PaillierPpm.out e [ARGUMENTS] [FILE.PPM]\n\t\t encrypt file.\n	\n\t./PaillierPpm.out decryption [PRIVATE KEY FILE .BIN] [FILE_E.PGM] [ARGUMENTS]	\n\t./PaillierPpm.out decrypt [PRIVATE KEY FILE .BIN] [FILE_E.PGM] [ARGUMENTS]	\n\t./PaillierPpm.out dec [PRIVATE KEY FILE .BIN] [FILE_E.PGM] [ARGUMENTS]	\n\t./PaillierPpm.out d [PRIVATE KEY FILE .BIN] [FILE_E.PGM] [ARGUMENTS]\n\t\tdecrypt file.	\n\n\t./PaillierPpm.out encryption [p] [q] [FILE.PPM]	\n\t\t Encryption mode where you specify p and q arguments. p and q are prime number where pgcd(p * q,p-1 * q-1) = 1.	\n\n\t-k, -key	\n\t\t specify usage of private or public key, followed by file.bin, your key file.	\n\n\t-distribution, -distr, -d	\n\t\tto split encrypted pixel on two pixel.\n	\n\t-histogramexpansion,-hexp	\n\t\tto specify during **encryption** that we want to transform the histogram of each plane befor image encryption.\n\n\t-lookuptable, -lut\n\tto specify during **decryption** that we want to decrypt through a table of every ciphertext, built once and saved next to the private key (key_lut.bin).\n\n\t-threads, -t [N]\n\tto encrypt or decrypt the three planes with N threads, 0 for the number of cores (1 by default).\n\n\t-stats\n\tto print at the end the time spent in each stage (header, reading, planes splitting and merging, histogram expansion, encryption, decryption, writing).\n\n\t./PaillierPpm.out keygen -bits [N] [-safe] [-t N]\n\t\tgenerate a key pair with a n of N bits and save it to Paillier_private_key.bin and Paillier_public_key.bin, without image.\n\n\t-bits [N]\n\tat **encryption** or keygen, instead of p and q, to generate random balanced primes p and q with a n of N bits (8 to 32). The colour images need a n of 8 bits, the larger keys are only for -pack of ./PaillierPgm.out. An 8-bit n is always 11 x 13 = 143.\n\n\tThe options -olsbr32, -olsbr16, -pack, -directory and -band of ./PaillierPgm.out are not available for colour images.\n\n");
+}
+
+// Same width constraint as PaillierControllerPGM::IMAGE_KERNELS, a container stores a ciphertext per 16-bit pixel.
+const PaillierControllerPPM::ColourKernelEntry PaillierControllerPPM::COLOUR_KERNELS[] = {
+	{&Paillier<uint8_t, uint16_t>::supportsKey, &PaillierControllerPPM::processImageWith<uint8_t, uint16_t>},
+};
+
+unsigned PaillierControllerPPM::maxImageKeyBits(bool packed) const
+{
+	(void)packed;
+	unsigned bits = PrimeGenerator::MAX_BITS;
+	while (bits > 0 && !COLOUR_KERNELS[0].supportsKey((1ULL << bits) - 1))
+	{
+		bits--;
+	}
+	return bits;
+}
+
+void PaillierControllerPPM::processImage(string s_file, bool isEncryption, bool distributeOnTwo, bool recropPixels)
+{
+	uint64_t n = this->model->getInstance()->getN();
+	for (const ColourKernelEntry &entry : COLOUR_KERNELS)
+	{
+		if (entry.supportsKey(n))
+		{
+			(this->*entry.kernel)(s_file, isEncryption, distributeOnTwo, recropPixels);
+			return;
+		}
+	}
+	failImage("n value not supported.");
+}
@@ -50,6 +50,11 @@ void PaillierModel::setPrivateKey(PaillierPrivateKey value)
     this->setLambda(value.getLambda());
     this->setN(value.getN());
     this->setMu(value.getMu());
+    if (value.hasCRT())
+    {
+        this->setP(value.getP());
+        this->setQ(value.getQ());
+    }
 }
 void PaillierModel::setPublicKey(PaillierPublicKey value)
 {
@@ -0,0 +1,833 @@
+/******************************************************************************
+ * ICAR_Interns_Library
+ *
+ * File : BigInteger.cpp
+ *
+ * Description : Implementation of the arbitrary-precision unsigned integers
+ * and of the Montgomery context used by the Paillier cryptosystem with real
+ * key sizes.
+ *
+ *
+ * Author : Katia Auxilien
+ *
+ * Mail : katia.auxilien@mail.fr
+ *
+ * Date : 17 Octobre 2026
+ *
+ *******************************************************************************/
+#include "../../../../include/model/encryption/Paillier/BigInteger.hpp"
+#include "../../../../include/model/encryption/random/ChaCha20.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+typedef unsigned __int128 uint128_t;
+
+/*********************** Limb arrays ***********************/
+
+/**
+ * \brief Schoolbook product of limb arrays, result has na + nb limbs.
+ */
+static void mulSchoolbook(const uint64_t *a, size_t na, const uint64_t *b, size_t nb, uint64_t *result)
+{
+	std::fill(result, result + na + nb, 0);
+	for (size_t i = 0; i < na; i++)
+	{
+		uint64_t carry = 0;
+		for (size_t j = 0; j < nb; j++)
+		{
+			uint128_t t = (uint128_t)a[i] * b[j] + result[i + j] + carry;
+			result[i + j] = (uint64_t)t;
+			carry = (uint64_t)(t >> 64);
+		}
+		result[i + nb] = carry;
+	}
+}
+
+/**
+ * \brief a[0..na) += b[0..nb) with na >= nb, returns the carry out of a.
+ */
+static uint64_t addLimbs(uint64_t *a, size_t na, const uint64_t *b, size_t nb)
+{
+	uint64_t carry = 0;
+	size_t i = 0;
+	for (; i < nb; i++)
+	{
+		uint128_t t = (uint128_t)a[i] + b[i] + carry;
+		a[i] = (uint64_t)t;
+		carry = (uint64_t)(t >> 64);
+	}
+	for (; carry && i < na; i++)
+	{
+		a[i] += 1;
+		carry = (a[i] == 0);
+	}
+	return carry;
+}
+
+/**
+ * \brief a[0..na) -= b[0..nb) with na >= nb and a >= b.
+ */
+static void subLimbs(uint64_t *a, size_t na, const uint64_t *b, size_t nb)
+{
+	uint64_t borrow = 0;
+	size_t i = 0;
+	for (; i < nb; i++)
+	{
+		uint128_t t = (uint128_t)a[i] - b[i] - borrow;
+		a[i] = (uint64_t)t;
+		borrow = (uint64_t)(t >> 64) ? 1 : 0;
+	}
+	for (; borrow && i < na; i++)
+	{
+		borrow = (a[i] == 0);
+		a[i] -= 1;
+	}
+}
+
+/**
+ * \brief Karatsuba product of two n-limb arrays, result has 2n limbs.
+ * \details a·b = z2·B^(2h) + (z1 - z2 - z0)·B^h + z0 with z0 = a0·b0, z2 = a1·b1
+ * and z1 = (a0 + a1)(b0 + b1), B = 2⁶⁴ and h = n/2.
+ */
+static void mulKaratsuba(const uint64_t *a, const uint64_t *b, size_t n, uint64_t *result)
+{
+	if (n < BigInteger::KARATSUBA_THRESHOLD)
+	{
+		mulSchoolbook(a, n, b, n, result);
+		return;
+	}
+
+	size_t h = n / 2;
+	size_t hi = n - h;
+
+	mulKaratsuba(a, b, h, result);                   // z0 in result[0..2h)
+	mulKaratsuba(a + h, b + h, hi, result + 2 * h); // z2 in result[2h..2n)
+
+	std::vector<uint64_t> sa(hi + 1, 0), sb(hi + 1, 0), z1(2 * (hi + 1));
+	std::copy(a + h, a + n, sa.begin());
+	std::copy(b + h, b + n, sb.begin());
+	sa[hi] = addLimbs(sa.data(), hi, a, h);
+	sb[hi] = addLimbs(sb.data(), hi, b, h);
+
+	mulKaratsuba(sa.data(), sb.data(), hi + 1, z1.data());
+	subLimbs(z1.data(), z1.size(), result, 2 * h);
+	subLimbs(z1.data(), z1.size(), result + 2 * h, 2 * hi);
+
+	// z1 < B^(2hi + 1), only the limbs that fit in the product are added.
+	size_t len = std::min(z1.size(), 2 * n - h);
+	addLimbs(result + h, 2 * n - h, z1.data(), len);
+}
+
+void BigInteger::mulLimbs(const uint64_t *a, size_t na, const uint64_t *b, size_t nb, uint64_t *result)
+{
+	if (na < nb)
+	{
+		std::swap(a, b);
+		std::swap(na, nb);
+	}
+	if (nb < KARATSUBA_THRESHOLD)
+	{
+		mulSchoolbook(a, na, b, nb, result);
+		return;
+	}
+	if (na == nb)
+	{
+		mulKaratsuba(a, b, na, result);
+		return;
+	}
+
+	// Unbalanced operands: the larger one is cut in blocks of nb limbs.
+	std::fill(result, result + na + nb, 0);
+	std::vector<uint64_t> block(2 * nb);
+	for (size_t offset = 0; offset < na; offset += nb)
+	{
+		size_t len = std::min(nb, na - offset);
+		mulLimbs(a + offset, len, b, nb, block.data());
+		addLimbs(result + offset, na + nb - offset, block.data(), len + nb);
+	}
+}
+
+/*********************** Small arithmetic helpers ***********************/
+
+/**
+ * \brief x = x·m + a for 64-bit m and a.
+ */
+static void mulAddSmall(std::vector<uint64_t> &x, uint64_t m, uint64_t a)
+{
+	uint64_t carry = a;
+	for (size_t i = 0; i < x.size(); i++)
+	{
+		uint128_t t = (uint128_t)x[i] * m + carry;
+		x[i] = (uint64_t)t;
+		carry = (uint64_t)(t >> 64);
+	}
+	if (carry)
+	{
+		x.push_back(carry);
+	}
+}
+
+/**
+ * \brief x = x / d for a 64-bit d, returns x mod d.
+ */
+static uint64_t divSmall(std::vector<uint64_t> &x, uint64_t d)
+{
+	uint128_t rem = 0;
+	for (size_t i = x.size(); i-- > 0;)
+	{
+		uint128_t cur = (rem << 64) | x[i];
+		x[i] = (uint64_t)(cur / d);
+		rem = cur % d;
+	}
+	while (!x.empty() && x.back() == 0)
+	{
+		x.pop_back();
+	}
+	return (uint64_t)rem;
+}
+
+/*********************** BigInteger ***********************/
+
+BigInteger::BigInteger() {}
+
+BigInteger::BigInteger(uint64_t value)
+{
+	if (value != 0)
+	{
+		limbs.push_back(value);
+	}
+}
+
+BigInteger::BigInteger(const std::vector<uint64_t> &l) : limbs(l)
+{
+	normalize();
+}
+
+void BigInteger::normalize()
+{
+	while (!limbs.empty() && limbs.back() == 0)
+	{
+		limbs.pop_back();
+	}
+}
+
+BigInteger BigInteger::fromHex(const std::string &hex)
+{
+	size_t start = (hex.size() > 1 && hex[0] == '0' && (hex[1] == 'x' || hex[1] == 'X')) ? 2 : 0;
+	BigInteger result;
+	size_t digits = hex.size() - start;
+	result.limbs.assign((digits + 15) / 16, 0);
+	for (size_t i = 0; i < digits; i++)
+	{
+		char c = hex[hex.size() - 1 - i];
+		uint64_t v;
+		if (c >= '0' && c <= '9')
+			v = c - '0';
+		else if (c >= 'a' && c <= 'f')
+			v = c - 'a' + 10;
+		else if (c >= 'A' && c <= 'F')
+			v = c - 'A' + 10;
+		else
+			throw std::runtime_error("Erreur caractère hexadécimal invalide.");
+		result.limbs[i / 16] |= v << (4 * (i % 16));
+	}
+	result.normalize();
+	return result;
+}
+
+BigInteger BigInteger::fromDecimal(const std::string &dec)
+{
+	BigInteger result;
+	for (char c : dec)
+	{
+		if (c < '0' || c > '9')
+		{
+			throw std::runtime_error("Erreur caractère décimal invalide.");
+		}
+		mulAddSmall(result.limbs, 10, c - '0');
+	}
+	result.normalize();
+	return result;
+}
+
+std::string BigInteger::toHex() const
+{
+	if (limbs.empty())
+	{
+		return "0";
+	}
+	static const char digits[] = "0123456789abcdef";
+	std::string s;
+	for (size_t i = limbs.size(); i-- > 0;)
+	{
+		for (int shift = 60; shift >= 0; shift -= 4)
+		{
+			s.push_back(digits[(limbs[i] >> shift) & 0xF]);
+		}
+	}
+	size_t first = s.find_first_not_of('0');
+	return s.substr(first);
+}
+
+std::string BigInteger::toDecimal() const
+{
+	if (limbs.empty())
+	{
+		return "0";
+	}
+	const uint64_t chunk = 10000000000000000000ULL; // 10^19
+	std::vector<uint64_t> x = limbs;
+	std::string s;
+	while (!x.empty())
+	{
+		uint64_t rem = divSmall(x, chunk);
+		for (int i = 0; i < 19; i++)
+		{
+			s.push_back('0' + rem % 10);
+			rem /= 10;
+			if (x.empty() && rem == 0)
+				break;
+		}
+	}
+	std::reverse(s.begin(), s.end());
+	return s;
+}
+
+size_t BigInteger::bitLength() const
+{
+	if (limbs.empty())
+	{
+		return 0;
+	}
+	return 64 * limbs.size() - __builtin_clzll(limbs.back());
+}
+
+bool BigInteger::testBit(size_t i) const
+{
+	return (limb(i / 64) >> (i % 64)) & 1;
+}
+
+int BigInteger::compare(const BigInteger &other) const
+{
+	if (limbs.size() != other.limbs.size())
+	{
+		return limbs.size() < other.limbs.size() ? -1 : 1;
+	}
+	for (size_t i = limbs.size(); i-- > 0;)
+	{
+		if (limbs[i] != other.limbs[i])
+		{
+			return limbs[i] < other.limbs[i] ? -1 : 1;
+		}
+	}
+	return 0;
+}
+
+BigInteger BigInteger::operator+(const BigInteger &other) const
+{
+	const BigInteger &big = limbs.size() >= other.limbs.size() ? *this : other;
+	const BigInteger &small = limbs.size() >= other.limbs.size() ? other : *this;
+	BigInteger result = big;
+	result.limbs.push_back(0);
+	addLimbs(result.limbs.data(), result.limbs.size(), small.limbs.data(), small.limbs.size());
+	result.normalize();
+	return result;
+}
+
+BigInteger BigInteger::operator-(const BigInteger &other) const
+{
+	if (*this < other)
+	{
+		throw std::runtime_error("Erreur soustraction négative de BigInteger.");
+	}
+	BigInteger result = *this;
+	subLimbs(result.limbs.data(), result.limbs.size(), other.limbs.data(), other.limbs.size());
+	result.normalize();
+	return result;
+}
+
+BigInteger BigInteger::operator*(const BigInteger &other) const
+{
+	if (limbs.empty() || other.limbs.empty())
+	{
+		return BigInteger();
+	}
+	BigInteger result;
+	result.limbs.resize(limbs.size() + other.limbs.size());
+	mulLimbs(limbs.data(), limbs.size(), other.limbs.data(), other.limbs.size(), result.limbs.data());
+	result.normalize();
+	return result;
+}
+
+BigInteger BigInteger::operator/(const BigInteger &other) const
+{
+	BigInteger q, r;
+	divMod(*this, other, q, r);
+	return q;
+}
+
+BigInteger BigInteger::operator%(const BigInteger &other) const
+{
+	BigInteger q, r;
+	divMod(*this, other, q, r);
+	return r;
+}
+
+BigInteger BigInteger::operator<<(size_t bits) const
+{
+	if (limbs.empty())
+	{
+		return BigInteger();
+	}
+	size_t limbShift = bits / 64;
+	unsigned bitShift = bits % 64;
+	BigInteger result;
+	result.limbs.assign(limbs.size() + limbShift + 1, 0);
+	for (size_t i = 0; i < limbs.size(); i++)
+	{
+		result.limbs[i + limbShift] |= limbs[i] << bitShift;
+		if (bitShift)
+		{
+			result.limbs[i + limbShift + 1] |= limbs[i] >> (64 - bitShift);
+		}
+	}
+	result.normalize();
+	return result;
+}
+
+BigInteger BigInteger::operator>>(size_t bits) const
+{
+	size_t limbShift = bits / 64;
+	unsigned bitShift = bits % 64;
+	if (limbShift >= limbs.size())
+	{
+		return BigInteger();
+	}
+	BigInteger result;
+	result.limbs.assign(limbs.size() - limbShift, 0);
+	for (size_t i = 0; i < result.limbs.size(); i++)
+	{
+		result.limbs[i] = limbs[i + limbShift] >> bitShift;
+		if (bitShift && i + limbShift + 1 < limbs.size())
+		{
+			result.limbs[i] |= limbs[i + limbShift + 1] << (64 - bitShift);
+		}
+	}
+	result.normalize();
+	return result;
+}
+
+void BigInteger::divMod(const BigInteger &a, const BigInteger &b, BigInteger &quotient, BigInteger &remainder)
+{
+	if (b.isZero())
+	{
+		throw std::runtime_error("Erreur division de BigInteger par 0.");
+	}
+	if (a < b)
+	{
+		quotient = BigInteger();
+		remainder = a;
+		return;
+	}
+	if (b.limbs.size() == 1)
+	{
+		std::vector<uint64_t> q = a.limbs;
+		uint64_t r = divSmall(q, b.limbs[0]);
+		quotient = BigInteger(q);
+		remainder = BigInteger(r);
+		return;
+	}
+
+	// Knuth, The Art of Computer Programming vol. 2, algorithm D.
+	size_t n = b.limbs.size();
+	size_t m = a.limbs.size() - n;
+	unsigned s = __builtin_clzll(b.limbs.back());
+
+	std::vector<uint64_t> v(n), u(a.limbs.size() + 1);
+	for (size_t i = n; i-- > 0;)
+	{
+		v[i] = (b.limbs[i] << s) | (s && i > 0 ? b.limbs[i - 1] >> (64 - s) : 0);
+	}
+	u[a.limbs.size()] = s ? a.limbs.back() >> (64 - s) : 0;
+	for (size_t i = a.limbs.size(); i-- > 0;)
+	{
+		u[i] = (a.limbs[i] << s) | (s && i > 0 ? a.limbs[i - 1] >> (64 - s) : 0);
+	}
+
+	std::vector<uint64_t> q(m + 1, 0);
+	for (size_t j = m + 1; j-- > 0;)
+	{
+		uint128_t num = ((uint128_t)u[j + n] << 64) | u[j + n - 1];
+		uint128_t qhat = num / v[n - 1];
+		uint128_t rhat = num % v[n - 1];
+		while (qhat >> 64 || qhat * v[n - 2] > ((rhat << 64) | u[j + n - 2]))
+		{
+			qhat--;
+			rhat += v[n - 1];
+			if (rhat >> 64)
+				break;
+		}
+
+		// u[j..j+n] -= qhat · v
+		uint64_t carry = 0, borrow = 0;
+		for (size_t i = 0; i < n; i++)
+		{
+			uint128_t p = qhat * v[i] + carry;
+			carry = (uint64_t)(p >> 64);
+			uint128_t t = (uint128_t)u[i + j] - (uint64_t)p - borrow;
+			u[i + j] = (uint64_t)t;
+			borrow = (uint64_t)(t >> 64) ? 1 : 0;
+		}
+		uint128_t t = (uint128_t)u[j + n] - carry - borrow;
+		u[j + n] = (uint64_t)t;
+
+		if ((uint64_t)(t >> 64))
+		{
+			// qhat was one too large, add v back.
+			qhat--;
+			uint64_t c = addLimbs(u.data() + j, n, v.data(), n);
+			u[j + n] += c;
+		}
+		q[j] = (uint64_t)qhat;
+	}
+
+	std::vector<uint64_t> r(n);
+	for (size_t i = 0; i < n; i++)
+	{
+		r[i] = (u[i] >> s) | (s && i + 1 < u.size() ? u[i + 1] << (64 - s) : 0);
+	}
+	quotient = BigInteger(q);
+	remainder = BigInteger(r);
+}
+
+uint64_t BigInteger::modSmall(uint64_t m) const
+{
+	uint128_t rem = 0;
+	for (size_t i = limbs.size(); i-- > 0;)
+	{
+		rem = ((rem << 64) | limbs[i]) % m;
+	}
+	return (uint64_t)rem;
+}
+
+BigInteger BigInteger::gcd(BigInteger a, BigInteger b)
+{
+	while (!b.isZero())
+	{
+		BigInteger r = a % b;
+		a = b;
+		b = r;
+	}
+	return a;
+}
+
+BigInteger BigInteger::lcm(const BigInteger &a, const BigInteger &b)
+{
+	return a / gcd(a, b) * b;
+}
+
+BigInteger BigInteger::modInverse(const BigInteger &a, const BigInteger &m)
+{
+	// Invariant : r_i = t_i · a mod m, with t_i kept in [0, m).
+	BigInteger r0 = m, r1 = a % m;
+	BigInteger t0 = 0, t1 = 1;
+	while (!r1.isZero())
+	{
+		BigInteger q, r;
+		divMod(r0, r1, q, r);
+		BigInteger qt = (q * t1) % m;
+		BigInteger t2 = t0 >= qt ? t0 - qt : t0 + m - qt;
+		r0 = r1;
+		r1 = r;
+		t0 = t1;
+		t1 = t2;
+	}
+	if (r0 != BigInteger(1))
+	{
+		return BigInteger();
+	}
+	return t0;
+}
+
+BigInteger BigInteger::modPow(const BigInteger &base, const BigInteger &e, const BigInteger &m)
+{
+	if (m == BigInteger(1))
+	{
+		return BigInteger();
+	}
+	if (m.isOdd())
+	{
+		return BigMontgomeryContext(m).pow(base, e);
+	}
+	BigInteger result = 1, b = base % m;
+	for (size_t i = e.bitLength(); i-- > 0;)
+	{
+		result = (result * result) % m;
+		if (e.testBit(i))
+		{
+			result = (result * b) % m;
+		}
+	}
+	return result;
+}
+
+BigInteger BigInteger::randomBits(size_t bits)
+{
+	BigInteger result;
+	result.limbs.resize((bits + 63) / 64);
+	ChaCha20::threadInstance().fill(result.limbs.data(), result.limbs.size());
+	if (bits % 64)
+	{
+		result.limbs.back() &= (1ULL << (bits % 64)) - 1;
+	}
+	result.normalize();
+	return result;
+}
+
+BigInteger BigInteger::randomBelow(const BigInteger &bound)
+{
+	size_t bits = bound.bitLength();
+	BigInteger r;
+	do
+	{
+		r = randomBits(bits);
+	} while (r >= bound);
+	return r;
+}
+
+static const uint64_t SMALL_PRIMES[] = {
+	3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, 97,
+	101, 103, 107, 109, 113, 127, 131, 137, 139, 149, 151, 157, 163, 167, 173, 179, 181, 191, 193,
+	197, 199, 211, 223, 227, 229, 233, 239, 241, 251};
+
+bool BigInteger::isProbablePrime(const BigInteger &n, int rounds)
+{
+	if (n < BigInteger(2))
+	{
+		return false;
+	}
+	if (!n.isOdd())
+	{
+		return n == BigInteger(2);
+	}
+	for (uint64_t p : SMALL_PRIMES)
+	{
+		if (n == BigInteger(p))
+		{
+			return true;
+		}
+		if (n.modSmall(p) == 0)
+		{
+			return false;
+		}
+	}
+	if (n < BigInteger(257 * 257))
+	{
+		return true;
+	}
+
+	BigInteger n_minus_1 = n - 1;
+	size_t s = 0;
+	while (!n_minus_1.testBit(s))
+	{
+		s++;
+	}
+	BigInteger d = n_minus_1 >> s;
+
+	BigMontgomeryContext context(n);
+	for (int i = 0; i < rounds; i++)
+	{
+		BigInteger a = randomBelow(n - 3) + 2;
+		BigInteger x = context.pow(a, d);
+		if (x == BigInteger(1) || x == n_minus_1)
+		{
+			continue;
+		}
+		bool composite = true;
+		for (size_t r = 1; r < s; r++)
+		{
+			x = context.mulMod(x, x);
+			if (x == n_minus_1)
+			{
+				composite = false;
+				break;
+			}
+		}
+		if (composite)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+BigInteger BigInteger::randomPrime(size_t bits)
+{
+	if (bits < 3)
+	{
+		bits = 3;
+	}
+	BigInteger top = BigInteger(3) << (bits - 2);
+	while (true)
+	{
+		BigInteger candidate = randomBits(bits - 2) + top;
+		if (!candidate.isOdd())
+		{
+			candidate = candidate + 1;
+		}
+		for (int i = 0; i < 4096 && candidate.bitLength() == bits; i++)
+		{
+			if (isProbablePrime(candidate))
+			{
+				return candidate;
+			}
+			candidate = candidate + 2;
+		}
+	}
+}
+
+/*********************** BigMontgomeryContext ***********************/
+
+BigMontgomeryContext::BigMontgomeryContext() : k(0), m_inv(0) {}
+
+BigMontgomeryContext::BigMontgomeryContext(const BigInteger &m) : modulus(m), k(m.limbCount())
+{
+	if (!m.isOdd() || m == BigInteger(1))
+	{
+		throw std::runtime_error("Erreur le modulo de Montgomery doit être impair et supérieur à 1.");
+	}
+	uint64_t m0 = m.limb(0);
+	uint64_t inv = m0;
+	for (int i = 0; i < 5; i++)
+	{
+		inv *= 2 - m0 * inv;
+	}
+	m_inv = 0 - inv;
+
+	r_mod = toLimbs((BigInteger(1) << (64 * k)) % m);
+	r2_mod = toLimbs((BigInteger(1) << (128 * k)) % m);
+	buffer.resize(2 * k + 1);
+}
+
+std::vector<uint64_t> BigMontgomeryContext::toLimbs(const BigInteger &x) const
+{
+	std::vector<uint64_t> result(k, 0);
+	for (size_t i = 0; i < k; i++)
+	{
+		result[i] = x.limb(i);
+	}
+	return result;
+}
+
+void BigMontgomeryContext::mul(const uint64_t *a, const uint64_t *b, uint64_t *result) const
+{
+	const std::vector<uint64_t> &m = modulus.getLimbs();
+	uint64_t *t = buffer.data();
+
+	BigInteger::mulLimbs(a, k, b, k, t);
+	t[2 * k] = 0;
+
+	for (size_t i = 0; i < k; i++)
+	{
+		uint64_t u = t[i] * m_inv;
+		uint64_t carry = 0;
+		for (size_t j = 0; j < k; j++)
+		{
+			uint128_t p = (uint128_t)u * m[j] + t[i + j] + carry;
+			t[i + j] = (uint64_t)p;
+			carry = (uint64_t)(p >> 64);
+		}
+		for (size_t j = i + k; carry; j++)
+		{
+			uint128_t p = (uint128_t)t[j] + carry;
+			t[j] = (uint64_t)p;
+			carry = (uint64_t)(p >> 64);
+		}
+	}
+
+	// t[k..2k] < 2m, one subtraction at most.
+	bool greater = t[2 * k] != 0;
+	if (!greater)
+	{
+		greater = true;
+		for (size_t i = k; i-- > 0;)
+		{
+			if (t[k + i] != m[i])
+			{
+				greater = t[k + i] > m[i];
+				break;
+			}
+		}
+	}
+	if (greater)
+	{
+		subLimbs(t + k, k + 1, m.data(), k);
+	}
+	std::memcpy(result, t + k, k * sizeof(uint64_t));
+}
+
+BigInteger BigMontgomeryContext::fromMontgomery(const std::vector<uint64_t> &x) const
+{
+	std::vector<uint64_t> one(k, 0), result(k);
+	one[0] = 1;
+	mul(x.data(), one.data(), result.data());
+	return BigInteger(result);
+}
+
+std::vector<uint64_t> BigMontgomeryContext::powMontgomery(const BigInteger &base, const BigInteger &e) const
+{
+	std::vector<uint64_t> table[16];
+	table[0] = r_mod;
+	table[1].resize(k);
+	std::vector<uint64_t> b = toLimbs(base % modulus);
+	mul(b.data(), r2_mod.data(), table[1].data());
+	for (int i = 2; i < 16; i++)
+	{
+		table[i].resize(k);
+		mul(table[i - 1].data(), table[1].data(), table[i].data());
+	}
+
+	std::vector<uint64_t> result = r_mod;
+	size_t windows = (e.bitLength() + 3) / 4;
+	for (size_t w = windows; w-- > 0;)
+	{
+		if (w + 1 != windows)
+		{
+			for (int i = 0; i < 4; i++)
+			{
+				mul(result.data(), result.data(), result.data());
+			}
+		}
+		unsigned nibble = (e.limb(4 * w / 64) >> (4 * w % 64)) & 0xF;
+		if (nibble)
+		{
+			mul(result.data(), table[nibble].data(), result.data());
+		}
+	}
+	return result;
+}
+
+BigInteger BigMontgomeryContext::mulMod(const BigInteger &a, const BigInteger &b) const
+{
+	std::vector<uint64_t> am(k), result(k);
+	std::vector<uint64_t> al = toLimbs(a % modulus), bl = toLimbs(b % modulus);
+	mul(al.data(), r2_mod.data(), am.data());
+	mul(am.data(), bl.data(), result.data());
+	return BigInteger(result);
+}
+
+BigInteger BigMontgomeryContext::pow(const BigInteger &base, const BigInteger &e) const
+{
+	return fromMontgomery(powMontgomery(base, e));
+}
+
+BigInteger BigMontgomeryContext::powProduct(const BigInteger &x, const BigInteger &a, const BigInteger &y, const BigInteger &b) const
+{
+	std::vector<uint64_t> xa = powMontgomery(x, a);
+	std::vector<uint64_t> yb = powMontgomery(y, b);
+	std::vector<uint64_t> result(k);
+	mul(xa.data(), yb.data(), result.data());
+	return fromMontgomery(result);
+}
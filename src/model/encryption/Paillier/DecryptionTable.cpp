@@ -0,0 +1,109 @@
+/******************************************************************************
+ * ICAR_Interns_Library
+ *
+ * File : DecryptionTable.cpp
+ *
+ * Description : Implementation of the decryption lookup table for small
+ *   Paillier moduli.
+ *
+ *
+ * Author : Katia Auxilien
+ *
+ * Mail : katia.auxilien@mail.fr
+ *
+ * Date : 17 Octobre 2026
+ *
+ *******************************************************************************/
+#include "../../../../include/model/encryption/Paillier/DecryptionTable.hpp"
+#include "../../../../include/model/encryption/Paillier/Paillier.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+static const char LUT_MAGIC[4] = {'P', 'L', 'U', 'T'};
+
+DecryptionTable::DecryptionTable() : lambda(0), mu(0), n(0) {}
+
+bool DecryptionTable::isSupported(const PaillierPrivateKey &key)
+{
+	uint64_t n = key.getN();
+	return n > 1 && n < (1ULL << 32) && n * n <= MAX_SIZE;
+}
+
+bool DecryptionTable::build(const PaillierPrivateKey &key, ThreadPool &threadPool)
+{
+	if (!isSupported(key))
+	{
+		return false;
+	}
+	lambda = key.getLambda();
+	mu = key.getMu();
+	n = key.getN();
+
+	uint64_t size = n * n;
+	table.assign(size, 0);
+
+	threadPool.parallelFor(size, [this, &key](size_t begin, size_t end)
+						   {
+		Paillier<uint64_t, uint64_t> paillier;
+		for (uint64_t c = begin; c < end; c++)
+		{
+			// Only the elements of Z/n²Z* are ciphertexts, the others stay at 0.
+			if (paillier.gcd_64t(c, n) == 1)
+			{
+				table[c] = static_cast<uint16_t>(paillier.paillierDecryption(key, c));
+			}
+		} });
+	return true;
+}
+
+bool DecryptionTable::load(const std::string &path, const PaillierPrivateKey &key)
+{
+	FILE *f = fopen(path.c_str(), "rb");
+	if (f == NULL)
+	{
+		return false;
+	}
+
+	char magic[4];
+	uint64_t header[3];
+	bool ok = fread(magic, 1, 4, f) == 4 && memcmp(magic, LUT_MAGIC, 4) == 0 && fread(header, sizeof(uint64_t), 3, f) == 3 && header[0] == key.getLambda() && header[1] == key.getMu() && header[2] == key.getN() && isSupported(key);
+	if (ok)
+	{
+		std::vector<uint16_t> values(header[2] * header[2]);
+		ok = fread(values.data(), sizeof(uint16_t), values.size(), f) == values.size();
+		if (ok)
+		{
+			table.swap(values);
+			lambda = header[0];
+			mu = header[1];
+			n = header[2];
+		}
+	}
+	fclose(f);
+	return ok;
+}
+
+bool DecryptionTable::save(const std::string &path) const
+{
+	FILE *f = fopen(path.c_str(), "wb");
+	if (f == NULL)
+	{
+		return false;
+	}
+	uint64_t header[3] = {lambda, mu, n};
+	bool ok = fwrite(LUT_MAGIC, 1, 4, f) == 4 && fwrite(header, sizeof(uint64_t), 3, f) == 3 && fwrite(table.data(), sizeof(uint16_t), table.size(), f) == table.size();
+	fclose(f);
+	return ok;
+}
+
+std::string DecryptionTable::pathForKey(const std::string &keyFile)
+{
+	std::string path = keyFile;
+	size_t pos = path.rfind(".bin");
+	if (pos != std::string::npos && pos + 4 == path.size())
+	{
+		path.erase(pos);
+	}
+	return path + "_lut.bin";
+}
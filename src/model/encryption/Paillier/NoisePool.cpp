@@ -0,0 +1,136 @@
+/******************************************************************************
+ * ICAR_Interns_Library
+ *
+ * File : NoisePool.cpp
+ *
+ * Description : Implementation of the pool of precomputed Paillier noise values
+ *   r^n mod n².
+ *
+ *
+ * Author : Katia Auxilien
+ *
+ * Mail : katia.auxilien@mail.fr
+ *
+ * Date : 17 Octobre 2026
+ *
+ *******************************************************************************/
+#include "../../../../include/model/encryption/Paillier/NoisePool.hpp"
+#include "../../../../include/model/encryption/random/ChaCha20.hpp"
+
+#include <algorithm>
+
+NoisePool::NoisePool(uint64_t n, size_t batchSize, bool background)
+	: n(n), montgomery(n * n), batchSize(batchSize > 0 ? batchSize : 1),
+	  position(0), background(background), hasReady(false), stop(false), requested(0), queued(0)
+{
+	if (background)
+	{
+		producer = std::thread(&NoisePool::produce, this);
+	}
+}
+
+NoisePool::~NoisePool()
+{
+	if (background)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stop = true;
+		}
+		cond.notify_all();
+		producer.join();
+	}
+}
+
+NoisePool &NoisePool::threadInstance(uint64_t n)
+{
+	static thread_local std::unique_ptr<NoisePool> instance;
+	if (!instance || instance->getN() != n)
+	{
+		instance.reset(new NoisePool(n));
+	}
+	return *instance;
+}
+
+void NoisePool::computeBatch(std::vector<uint64_t> &batch, size_t size)
+{
+	batch.resize(size);
+	// The random values r are drawn in one pass, then replaced in place by r^n.
+	ChaCha20::threadInstance().fillZNStar(n, batch.data(), size);
+	for (size_t i = 0; i < size; i++)
+	{
+		batch[i] = montgomery.pow(batch[i], n);
+	}
+}
+
+size_t NoisePool::takeRequested()
+{
+	size_t size = requested == 0 ? batchSize : std::min(requested, batchSize);
+	requested -= std::min(requested, size);
+	return size;
+}
+
+void NoisePool::expect(size_t count)
+{
+	std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+	if (background)
+	{
+		lock.lock();
+	}
+	size_t available = current.size() - position + queued;
+	requested = count > available ? count - available : 0;
+	if (background)
+	{
+		cond.notify_all();
+	}
+}
+
+void NoisePool::produce()
+{
+	std::vector<uint64_t> batch;
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true)
+	{
+		// One batch at a time, and only for values the consumer asked for.
+		cond.wait(lock, [this]
+				  { return stop || (queued == 0 && requested > 0); });
+		if (stop)
+		{
+			return;
+		}
+		size_t size = takeRequested();
+		queued = size;
+		lock.unlock();
+		computeBatch(batch, size);
+		lock.lock();
+
+		ready.swap(batch);
+		hasReady = true;
+		cond.notify_all();
+	}
+}
+
+void NoisePool::refill()
+{
+	if (!background)
+	{
+		computeBatch(current, takeRequested());
+	}
+	else
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		if (queued == 0 && requested == 0)
+		{
+			// More values are drawn than announced.
+			requested = batchSize;
+			cond.notify_all();
+		}
+		cond.wait(lock, [this]
+				  { return hasReady; });
+		current.swap(ready);
+		hasReady = false;
+		queued = 0;
+		cond.notify_all();
+	}
+	position = 0;
+}
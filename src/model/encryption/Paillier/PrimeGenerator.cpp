@@ -0,0 +1,168 @@
+/******************************************************************************
+ * ICAR_Interns_Library
+ *
+ * File : PrimeGenerator.cpp
+ *
+ * Description : Implementation of the primality test and the random prime
+ *   generation of 64-bit keys.
+ *
+ *
+ * Author : Katia Auxilien
+ *
+ * Mail : katia.auxilien@mail.fr
+ *
+ * Date : 17 Octobre 2026
+ *
+ *******************************************************************************/
+#include "../../../../include/model/encryption/Paillier/PrimeGenerator.hpp"
+#include "../../../../include/model/encryption/Paillier/Montgomery.hpp"
+#include "../../../../include/model/encryption/Paillier/NumberTheory.hpp"
+#include "../../../../include/model/encryption/random/ChaCha20.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+const std::vector<uint64_t> &PrimeGenerator::smallPrimes()
+{
+	static const std::vector<uint64_t> primes = []()
+	{
+		std::vector<bool> composite(SIEVE_LIMIT, false);
+		std::vector<uint64_t> result;
+		for (uint64_t i = 2; i < SIEVE_LIMIT; i++)
+		{
+			if (!composite[i])
+			{
+				result.push_back(i);
+				for (uint64_t j = i * i; j < SIEVE_LIMIT; j += i)
+				{
+					composite[j] = true;
+				}
+			}
+		}
+		return result;
+	}();
+	return primes;
+}
+
+bool PrimeGenerator::isPrime(uint64_t n)
+{
+	for (uint64_t prime : smallPrimes())
+	{
+		if (n % prime == 0)
+		{
+			return n == prime;
+		}
+		if (prime * prime > n)
+		{
+			return n > 1;
+		}
+	}
+
+	// n is odd and above SIEVE_LIMIT², write n - 1 = d * 2^s.
+	uint64_t d = n - 1;
+	int s = __builtin_ctzll(d);
+	d >>= s;
+
+	MontgomeryContext montgomery(n);
+	static const uint64_t BASES[] = {2, 325, 9375, 28178, 450775, 9780504, 1795265022};
+	for (uint64_t base : BASES)
+	{
+		uint64_t a = base % n;
+		if (a == 0)
+		{
+			continue;
+		}
+		uint64_t x = montgomery.pow(a, d);
+		if (x == 1 || x == n - 1)
+		{
+			continue;
+		}
+		bool composite = true;
+		for (int r = 1; r < s && composite; r++)
+		{
+			x = (uint64_t)(((uint128_t)x * x) % n);
+			composite = x != n - 1;
+		}
+		if (composite)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+uint64_t PrimeGenerator::randomPrime(unsigned bits, bool safe)
+{
+	ChaCha20 &generator = ChaCha20::threadInstance();
+	uint64_t low = 1ULL << (bits - 1);
+	uint64_t high = (1ULL << bits) - 1;
+	while (true)
+	{
+		// Odd candidate with its top bit set.
+		uint64_t candidate = generator.uniform(low, high) | 1 | low;
+		if (safe)
+		{
+			// p = 2p' + 1 needs p = 3 mod 4 as soon as p' is odd, and p' must be prime first.
+			candidate |= 2;
+			if (!isPrime(candidate >> 1))
+			{
+				continue;
+			}
+		}
+		if (isPrime(candidate))
+		{
+			return candidate;
+		}
+	}
+}
+
+void PrimeGenerator::generateKeyPrimes(unsigned bits, bool safe, unsigned threads, uint64_t &p, uint64_t &q)
+{
+	if (threads == 0)
+	{
+		threads = std::thread::hardware_concurrency();
+	}
+	if (threads == 0)
+	{
+		threads = 1;
+	}
+
+	unsigned bitsP = bits / 2;
+	unsigned bitsQ = bits - bitsP;
+	std::atomic<bool> found(false);
+	std::mutex mutex;
+
+	auto search = [&]()
+	{
+		while (!found.load(std::memory_order_relaxed))
+		{
+			uint64_t a = randomPrime(bitsP, safe);
+			uint64_t b = randomPrime(bitsQ, safe);
+			uint64_t n = a * b;
+			// With an odd number of bits, q can be 2p + 1, p then divides q - 1.
+			if (a == b || n >> (bits - 1) != 1 || NumberTheory::gcd(n, (a - 1) * (b - 1)) != 1)
+			{
+				continue;
+			}
+			std::lock_guard<std::mutex> lock(mutex);
+			if (!found)
+			{
+				p = a;
+				q = b;
+				found = true;
+			}
+		}
+	};
+
+	std::vector<std::thread> workers;
+	for (unsigned t = 1; t < threads; t++)
+	{
+		workers.emplace_back(search);
+	}
+	search();
+	for (std::thread &worker : workers)
+	{
+		worker.join();
+	}
+}
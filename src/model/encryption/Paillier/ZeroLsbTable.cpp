@@ -0,0 +1,67 @@
+/******************************************************************************
+ * ICAR_Interns_Library
+ *
+ * File : ZeroLsbTable.cpp
+ *
+ * Description : Implementation of the table of ciphertexts with zero least
+ *   significant bits.
+ *
+ *
+ * Author : Katia Auxilien
+ *
+ * Mail : katia.auxilien@mail.fr
+ *
+ * Date : 17 Octobre 2026
+ *
+ *******************************************************************************/
+#include "../../../../include/model/encryption/Paillier/ZeroLsbTable.hpp"
+#include "../../../../include/model/encryption/Paillier/Montgomery.hpp"
+#include "../../../../include/model/encryption/Paillier/NumberTheory.hpp"
+#include "../../../../include/model/encryption/random/ChaCha20.hpp"
+
+bool ZeroLsbTable::build(uint64_t n, uint64_t g, int bitsCompressed)
+{
+	if (n < 2 || n * n > MAX_SIZE)
+	{
+		return false;
+	}
+	uint64_t n2 = n * n;
+	uint64_t mask = (1ULL << bitsCompressed) - 1;
+	MontgomeryContext montgomery(n2);
+
+	// r^n mod n² for every r of Z/nZ*.
+	std::vector<uint64_t> noises;
+	for (uint64_t r = 1; r < n; r++)
+	{
+		if (NumberTheory::gcd(r, n) == 1)
+		{
+			noises.push_back(montgomery.pow(r, n));
+		}
+	}
+
+	// n² <= 2^24, so the products below fit on 64 bits.
+	ciphertexts.clear();
+	offsets.assign(n + 1, 0);
+	uint64_t gm = 1;
+	for (uint64_t m = 0; m < n; m++)
+	{
+		offsets[m] = ciphertexts.size();
+		for (uint64_t rn : noises)
+		{
+			uint64_t c = gm * rn % n2;
+			if ((c & mask) == 0)
+			{
+				ciphertexts.push_back(static_cast<uint32_t>(c));
+			}
+		}
+		gm = gm * (g % n2) % n2;
+	}
+	offsets[n] = ciphertexts.size();
+	return true;
+}
+
+uint64_t ZeroLsbTable::encrypt(uint64_t m) const
+{
+	uint64_t index = ChaCha20::threadInstance().uniform(offsets[m], offsets[m + 1] - 1);
+	return ciphertexts[index];
+}
@@ -17,22 +17,37 @@
 
 PaillierPrivateKey::PaillierPrivateKey()
 {
-    this->lambda = this->mu = 0;
+    this->lambda = this->mu = this->n = 0;
+    this->p = this->q = this->p2 = this->q2 = this->hp = this->hq = this->p_inv_q = 0;
 }
 
-PaillierPrivateKey::PaillierPrivateKey(uint64_t l, uint64_t m)
+PaillierPrivateKey::PaillierPrivateKey(uint64_t l, uint64_t m) : PaillierPrivateKey()
 {
     this->lambda = l;
     this->mu = m;
 }
 
-PaillierPrivateKey::PaillierPrivateKey(uint64_t l, uint64_t m, uint64_t nn)
+PaillierPrivateKey::PaillierPrivateKey(uint64_t l, uint64_t m, uint64_t nn) : PaillierPrivateKey()
 {
     this->lambda = l;
     this->mu = m;
     this->n = nn;
 }
 
+PaillierPrivateKey::PaillierPrivateKey(uint64_t l, uint64_t m, uint64_t nn, uint64_t pp, uint64_t qq, uint64_t h_p, uint64_t h_q, uint64_t p_inv_q)
+{
+    this->lambda = l;
+    this->mu = m;
+    this->n = nn;
+    this->p = pp;
+    this->q = qq;
+    this->p2 = pp * pp;
+    this->q2 = qq * qq;
+    this->hp = h_p;
+    this->hq = h_q;
+    this->p_inv_q = p_inv_q;
+}
+
 uint64_t PaillierPrivateKey::getLambda() const
 {
     return this->lambda;
@@ -48,4 +63,44 @@ uint64_t PaillierPrivateKey::getN() const
     return this->n;
 }
 
+uint64_t PaillierPrivateKey::getP() const
+{
+    return this->p;
+}
+
+uint64_t PaillierPrivateKey::getQ() const
+{
+    return this->q;
+}
+
+uint64_t PaillierPrivateKey::getP2() const
+{
+    return this->p2;
+}
+
+uint64_t PaillierPrivateKey::getQ2() const
+{
+    return this->q2;
+}
+
+uint64_t PaillierPrivateKey::getHp() const
+{
+    return this->hp;
+}
+
+uint64_t PaillierPrivateKey::getHq() const
+{
+    return this->hq;
+}
+
+uint64_t PaillierPrivateKey::getPInvQ() const
+{
+    return this->p_inv_q;
+}
+
+bool PaillierPrivateKey::hasCRT() const
+{
+    return this->p != 0 && this->q != 0 && this->hp != 0 && this->hq != 0;
+}
+
 PaillierPrivateKey::~PaillierPrivateKey() {}
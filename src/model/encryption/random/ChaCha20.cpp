@@ -0,0 +1,156 @@
+/******************************************************************************
+ * ICAR_Interns_Library
+ *
+ * File : ChaCha20.cpp
+ *
+ * Description : Implementation of the ChaCha20 cryptographically secure
+ *   pseudo-random generator.
+ *
+ *
+ * Author : Katia Auxilien
+ *
+ * Mail : katia.auxilien@mail.fr
+ *
+ * Date : 17 Octobre 2026
+ *
+ *******************************************************************************/
+#include "../../../../include/model/encryption/random/ChaCha20.hpp"
+#include "../../../../include/model/encryption/Paillier/NumberTheory.hpp"
+#include "../../../../include/model/profiling/Profiler.hpp"
+
+#include <random>
+
+static inline uint32_t rotl32(uint32_t x, int r)
+{
+	return (x << r) | (x >> (32 - r));
+}
+
+#define QUARTER_ROUND(a, b, c, d) \
+	a += b;                       \
+	d = rotl32(d ^ a, 16);        \
+	c += d;                       \
+	b = rotl32(b ^ c, 12);        \
+	a += b;                       \
+	d = rotl32(d ^ a, 8);         \
+	c += d;                       \
+	b = rotl32(b ^ c, 7);
+
+ChaCha20::ChaCha20()
+{
+	std::random_device rd;
+	uint32_t key[8];
+	for (int i = 0; i < 8; i++)
+	{
+		key[i] = rd();
+	}
+	uint64_t nonce = ((uint64_t)rd() << 32) | rd();
+	*this = ChaCha20(key, nonce);
+}
+
+ChaCha20::ChaCha20(const uint32_t key[8], uint64_t nonce, uint64_t counter)
+{
+	// "expand 32-byte k"
+	state[0] = 0x61707865;
+	state[1] = 0x3320646e;
+	state[2] = 0x79622d32;
+	state[3] = 0x6b206574;
+	for (int i = 0; i < 8; i++)
+	{
+		state[4 + i] = key[i];
+	}
+	state[12] = (uint32_t)counter;
+	state[13] = (uint32_t)(counter >> 32);
+	state[14] = (uint32_t)nonce;
+	state[15] = (uint32_t)(nonce >> 32);
+	position = BLOCKS * 8;
+}
+
+void ChaCha20::refill()
+{
+	for (int b = 0; b < BLOCKS; b++)
+	{
+		uint32_t x[16];
+		for (int i = 0; i < 16; i++)
+		{
+			x[i] = state[i];
+		}
+		for (int round = 0; round < 10; round++)
+		{
+			QUARTER_ROUND(x[0], x[4], x[8], x[12]);
+			QUARTER_ROUND(x[1], x[5], x[9], x[13]);
+			QUARTER_ROUND(x[2], x[6], x[10], x[14]);
+			QUARTER_ROUND(x[3], x[7], x[11], x[15]);
+			QUARTER_ROUND(x[0], x[5], x[10], x[15]);
+			QUARTER_ROUND(x[1], x[6], x[11], x[12]);
+			QUARTER_ROUND(x[2], x[7], x[8], x[13]);
+			QUARTER_ROUND(x[3], x[4], x[9], x[14]);
+		}
+		for (int i = 0; i < 8; i++)
+		{
+			uint32_t lo = x[2 * i] + state[2 * i];
+			uint32_t hi = x[2 * i + 1] + state[2 * i + 1];
+			buffer[b * 8 + i] = ((uint64_t)hi << 32) | lo;
+		}
+
+		// 64-bit block counter.
+		if (++state[12] == 0)
+		{
+			state[13]++;
+		}
+	}
+	position = 0;
+}
+
+void ChaCha20::fill(uint64_t *out, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		out[i] = (*this)();
+	}
+}
+
+uint64_t ChaCha20::uniform(uint64_t min, uint64_t max)
+{
+	uint64_t range = max - min;
+	if (range == UINT64_MAX)
+	{
+		return (*this)();
+	}
+	uint64_t mask = range == 0 ? 0 : UINT64_MAX >> __builtin_clzll(range);
+	uint64_t x;
+	do
+	{
+		x = (*this)() & mask;
+	} while (x > range);
+	return min + x;
+}
+
+void ChaCha20::fillZNStar(uint64_t n, uint64_t *out, size_t count)
+{
+	uint64_t mask = UINT64_MAX >> __builtin_clzll(n - 1);
+	size_t i = 0;
+	uint64_t rejected = 0;
+	while (i < count)
+	{
+		uint64_t r = (*this)() & mask;
+		if (r == 0 || r >= n)
+		{
+			continue;
+		}
+		if (NumberTheory::gcd(r, n) == 1)
+		{
+			out[i++] = r;
+		}
+		else
+		{
+			rejected++;
+		}
+	}
+	PROFILE_COUNT(GCD_REJECTIONS, rejected);
+}
+
+ChaCha20 &ChaCha20::threadInstance()
+{
+	static thread_local ChaCha20 instance;
+	return instance;
+}
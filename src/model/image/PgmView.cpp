@@ -0,0 +1,258 @@
+/******************************************************************************
+ * ICAR_Interns_Library
+ *
+ * File : PgmView.cpp
+ *
+ * Description : Implementation of the memory-mapped view of a PGM or PPM file.
+ *
+ *
+ * Author : Katia Auxilien
+ *
+ * Mail : katia.auxilien@mail.fr
+ *
+ * Date : 17 Octobre 2026
+ *
+ *******************************************************************************/
+#include "../../../include/model/image/PgmView.hpp"
+#include "../../../include/model/profiling/Profiler.hpp"
+
+#include <cctype>
+#include <cinttypes>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+PgmView::PgmView() : mapping(NULL), mappingSize(0), headerSize(0), fd(-1), width(0), height(0), originalWidth(0), originalHeight(0), channels(1), maxValue(0) {}
+
+PgmView::~PgmView()
+{
+	close();
+}
+
+void PgmView::close()
+{
+	if (mapping != NULL)
+	{
+		munmap(mapping, mappingSize);
+		mapping = NULL;
+	}
+	if (fd >= 0)
+	{
+		::close(fd);
+		fd = -1;
+	}
+	mappingSize = 0;
+	headerSize = 0;
+}
+
+bool PgmView::parseHeader(bool compressed, int expectedChannels)
+{
+	PROFILE_STAGE(HEADER);
+	size_t pos = 0;
+
+	// Skip the white spaces and the comment lines, then read an unsigned integer.
+	auto readNumber = [&](uint64_t &value)
+	{
+		while (pos < mappingSize && (isspace(mapping[pos]) || mapping[pos] == '#'))
+		{
+			if (mapping[pos] == '#')
+			{
+				size_t start = ++pos;
+				while (pos < mappingSize && mapping[pos] != '\n')
+				{
+					pos++;
+				}
+				if (comment.empty())
+				{
+					comment.assign(reinterpret_cast<const char *>(mapping) + start, pos - start);
+				}
+			}
+			else
+			{
+				pos++;
+			}
+		}
+		if (pos >= mappingSize || !isdigit(mapping[pos]))
+		{
+			return false;
+		}
+		value = 0;
+		while (pos < mappingSize && isdigit(mapping[pos]))
+		{
+			value = value * 10 + (mapping[pos] - '0');
+			pos++;
+		}
+		return true;
+	};
+
+	if (mappingSize < 2 || mapping[0] != 'P' || mapping[1] != (expectedChannels == 3 ? '6' : '5'))
+	{
+		return false;
+	}
+	pos = 2;
+	channels = expectedChannels;
+	comment.clear();
+
+	uint64_t w, h, ow = 0, oh = 0;
+	if (compressed && !(readNumber(ow) && readNumber(oh)))
+	{
+		return false;
+	}
+	if (!(readNumber(w) && readNumber(h) && readNumber(maxValue)))
+	{
+		return false;
+	}
+	// A single white space separates the header from the pixels.
+	if (pos >= mappingSize || !isspace(mapping[pos]))
+	{
+		return false;
+	}
+	headerSize = pos + 1;
+	width = (int)w;
+	height = (int)h;
+	originalWidth = (int)ow;
+	originalHeight = (int)oh;
+	return true;
+}
+
+bool PgmView::open(const char *path, size_t bytesPerPixel, bool compressed, int channels)
+{
+	close();
+	fd = ::open(path, O_RDONLY);
+	if (fd < 0)
+	{
+		return false;
+	}
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size == 0)
+	{
+		close();
+		return false;
+	}
+	mappingSize = st.st_size;
+	void *address = mmap(NULL, mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (address == MAP_FAILED)
+	{
+		mapping = NULL;
+		close();
+		return false;
+	}
+	mapping = static_cast<uint8_t *>(address);
+	madvise(mapping, mappingSize, MADV_SEQUENTIAL);
+
+	if (!parseHeader(compressed, channels) || dataSize() < (size_t)width * height * channels * bytesPerPixel)
+	{
+		close();
+		return false;
+	}
+	return true;
+}
+
+bool PgmView::create(const char *path, int height, int width, uint64_t maxValue, size_t payloadSize, int originalHeight, int originalWidth, int channels, const std::string &comment)
+{
+	close();
+
+	// A comment line ends at '\n' whatever the separators of the rest of the header.
+	char header[256];
+	int length;
+	char magic = channels == 3 ? '6' : '5';
+	std::string line = comment.empty() ? "" : "#" + comment + "\n";
+	if (line.size() > 128 || line.find('\n') != line.size() - 1)
+	{
+		return false;
+	}
+	if (originalHeight > 0)
+	{
+		length = snprintf(header, sizeof(header), "P%c\r%s%d %d\r%d %d\r%" PRIu64 "\r", magic, line.c_str(), originalWidth, originalHeight, width, height, maxValue);
+	}
+	else
+	{
+		length = snprintf(header, sizeof(header), "P%c\r%s%d %d\r%" PRIu64 "\r", magic, line.c_str(), width, height, maxValue);
+	}
+
+	fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+	{
+		return false;
+	}
+	mappingSize = length + payloadSize;
+	if (ftruncate(fd, mappingSize) != 0)
+	{
+		close();
+		return false;
+	}
+	void *address = mmap(NULL, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (address == MAP_FAILED)
+	{
+		mapping = NULL;
+		close();
+		return false;
+	}
+	mapping = static_cast<uint8_t *>(address);
+	memcpy(mapping, header, length);
+	headerSize = length;
+
+	this->width = width;
+	this->height = height;
+	this->originalWidth = originalWidth;
+	this->originalHeight = originalHeight;
+	this->channels = channels;
+	this->maxValue = maxValue;
+	this->comment = comment;
+	return true;
+}
+
+void PgmView::release(size_t offset, size_t length)
+{
+	if (mapping == NULL || length == 0)
+	{
+		return;
+	}
+	static const size_t pageSize = sysconf(_SC_PAGESIZE);
+	size_t begin = (headerSize + offset + pageSize - 1) / pageSize * pageSize;
+	size_t end = (headerSize + offset + length) / pageSize * pageSize;
+	if (end == mappingSize / pageSize * pageSize)
+	{
+		// The last page of the file belongs to the last range only.
+		end = mappingSize;
+	}
+	if (begin < end)
+	{
+		madvise(mapping + begin, end - begin, MADV_DONTNEED);
+	}
+}
+
+void PgmView::prefetch(size_t offset, size_t length) const
+{
+	PROFILE_STAGE(READ);
+	if (mapping == NULL || length == 0)
+	{
+		return;
+	}
+	static const size_t pageSize = sysconf(_SC_PAGESIZE);
+	size_t begin = (headerSize + offset) / pageSize * pageSize;
+	size_t end = headerSize + offset + length;
+	madvise(mapping + begin, end - begin, MADV_WILLNEED);
+
+	volatile uint8_t sink = 0;
+	for (size_t page = begin; page < end; page += pageSize)
+	{
+		sink += mapping[page];
+	}
+	(void)sink;
+}
+
+bool PgmView::flush(size_t offset, size_t length)
+{
+	PROFILE_STAGE(WRITE);
+	if (mapping == NULL || length == 0)
+	{
+		return true;
+	}
+	static const size_t pageSize = sysconf(_SC_PAGESIZE);
+	size_t begin = (headerSize + offset) / pageSize * pageSize;
+	size_t end = headerSize + offset + length;
+	return msync(mapping + begin, end - begin, MS_SYNC) == 0;
+}
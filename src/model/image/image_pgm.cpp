@@ -17,9 +17,11 @@
  *
  *******************************************************************************/
 #include "../../../include/model/image/image_pgm.hpp"
+#include "../../../include/model/profiling/Profiler.hpp"
 
 void image_pgm::ecrire_image_p(char nom_image[], OCTET *pt_image, int nb_lignes, int nb_colonnes)
 {
+	PROFILE_STAGE(WRITE);
 	FILE *f_image;
 	int taille_image = nb_colonnes * nb_lignes;
 
@@ -44,6 +46,7 @@ void image_pgm::ecrire_image_p(char nom_image[], OCTET *pt_image, int nb_lignes,
 
 void image_pgm::lire_nb_lignes_colonnes_image_p(char nom_image[], int *nb_lignes, int *nb_colonnes)
 {
+	PROFILE_STAGE(HEADER);
 	FILE *f_image;
 	int max_grey_val;
 
@@ -68,6 +71,7 @@ void image_pgm::lire_nb_lignes_colonnes_image_p(char nom_image[], int *nb_lignes
 
 void image_pgm::lire_nb_lignes_colonnes_image_p_comp(char nom_image[], int *nb_lignes, int *nb_colonnes)
 {
+	PROFILE_STAGE(HEADER);
 	FILE *f_image;
 	int max_grey_val;
 
@@ -97,6 +101,7 @@ void image_pgm::lire_nb_lignes_colonnes_image_p_comp(char nom_image[], int *nb_l
 
 void image_pgm::lire_image_p(char nom_image[], OCTET *pt_image, int taille_image)
 {
+	PROFILE_STAGE(READ);
 	FILE *f_image;
 	int nb_colonnes, nb_lignes, max_grey_val;
 
@@ -124,6 +129,7 @@ void image_pgm::lire_image_p(char nom_image[], OCTET *pt_image, int taille_image
 // uint8_t
 uint8_t image_pgm::lire_image_pgm_and_get_maxgrey(char nom_image[], uint8_t *pt_image, int taille_image)
 {
+	PROFILE_STAGE(READ);
 	FILE *f_image;
 	int nb_colonnes, nb_lignes;
 	uint8_t max_grey_val;
@@ -152,6 +158,7 @@ uint8_t image_pgm::lire_image_pgm_and_get_maxgrey(char nom_image[], uint8_t *pt_
 
 void image_pgm::ecrire_image_pgm_variable_size(char nom_image[], uint8_t *pt_image, int nb_lignes, int nb_colonnes, uint8_t max_value)
 {
+	PROFILE_STAGE(WRITE);
 	FILE *f_image;
 	int taille_image = nb_colonnes * nb_lignes;
 
@@ -177,6 +184,7 @@ void image_pgm::ecrire_image_pgm_variable_size(char nom_image[], uint8_t *pt_ima
 // Used in compression
 void image_pgm::write_image_pgm_compressed_variable_size(char nom_image[], uint8_t *pt_image, int nb_lignes, int nb_colonnes, uint16_t max_value, int imgSize, int nHOriginal, int nWOriginal)
 {
+	PROFILE_STAGE(WRITE);
 	FILE *f_image;
 	int taille_image = imgSize;
 
@@ -209,6 +217,7 @@ void image_pgm::write_image_pgm_compressed_variable_size(char nom_image[], uint8
 
 pair<int, int> image_pgm::read_image_pgm_compressed_and_get_originalDimension(char nom_image[], uint8_t *pt_image)
 {
+	PROFILE_STAGE(READ);
 	FILE *f_image;
 	int nb_colonnes, nb_lignes;
 	uint16_t max_grey_val;
@@ -261,6 +270,7 @@ pair<int, int> image_pgm::read_image_pgm_compressed_and_get_originalDimension(ch
 // uint16_t
 uint16_t image_pgm::lire_image_pgm_and_get_maxgrey(char nom_image[], uint16_t *pt_image, int taille_image)
 {
+	PROFILE_STAGE(READ);
 	FILE *f_image;
 	int nb_colonnes, nb_lignes;
 	uint16_t max_grey_val;
@@ -289,6 +299,7 @@ uint16_t image_pgm::lire_image_pgm_and_get_maxgrey(char nom_image[], uint16_t *p
 
 void image_pgm::ecrire_image_pgm_variable_size(char nom_image[], uint16_t *pt_image, int nb_lignes, int nb_colonnes, uint16_t max_value)
 {
+	PROFILE_STAGE(WRITE);
 	FILE *f_image;
 	int taille_image = nb_colonnes * nb_lignes;
 
@@ -314,6 +325,7 @@ void image_pgm::ecrire_image_pgm_variable_size(char nom_image[], uint16_t *pt_im
 // Used in compression
 void image_pgm::write_image_pgm_compressed_variable_size(char nom_image[], uint16_t *pt_image, int nb_lignes, int nb_colonnes, uint16_t max_value, int imgSize, int nHOriginal, int nWOriginal)
 {
+	PROFILE_STAGE(WRITE);
 	FILE *f_image;
 	int taille_image = imgSize;
 
@@ -346,6 +358,7 @@ void image_pgm::write_image_pgm_compressed_variable_size(char nom_image[], uint1
 
 pair<int, int> image_pgm::read_image_pgm_compressed_and_get_originalDimension(char nom_image[], uint16_t *pt_image)
 {
+	PROFILE_STAGE(READ);
 	FILE *f_image;
 	int nb_colonnes, nb_lignes;
 	uint16_t max_grey_val;
@@ -395,6 +408,7 @@ pair<int, int> image_pgm::read_image_pgm_compressed_and_get_originalDimension(ch
 // uint32_t
 uint32_t image_pgm::lire_image_pgm_and_get_maxgrey(char nom_image[], uint32_t *pt_image, int taille_image)
 {
+	PROFILE_STAGE(READ);
 	FILE *f_image;
 	int nb_colonnes, nb_lignes;
 	uint32_t max_grey_val;
@@ -423,6 +437,7 @@ uint32_t image_pgm::lire_image_pgm_and_get_maxgrey(char nom_image[], uint32_t *p
 
 void image_pgm::ecrire_image_pgm_variable_size(char nom_image[], uint32_t *pt_image, int nb_lignes, int nb_colonnes, uint32_t max_value)
 {
+	PROFILE_STAGE(WRITE);
 	FILE *f_image;
 	int taille_image = nb_colonnes * nb_lignes;
 
@@ -448,6 +463,7 @@ void image_pgm::ecrire_image_pgm_variable_size(char nom_image[], uint32_t *pt_im
 // uint64_t
 uint64_t image_pgm::lire_image_pgm_and_get_maxgrey(char nom_image[], uint64_t *pt_image, int taille_image)
 {
+	PROFILE_STAGE(READ);
 	FILE *f_image;
 	int nb_colonnes, nb_lignes;
 	uint64_t max_grey_val;
@@ -476,6 +492,7 @@ uint64_t image_pgm::lire_image_pgm_and_get_maxgrey(char nom_image[], uint64_t *p
 
 void image_pgm::ecrire_image_pgm_variable_size(char nom_image[], uint64_t *pt_image, int nb_lignes, int nb_colonnes, uint64_t max_value)
 {
+	PROFILE_STAGE(WRITE);
 	FILE *f_image;
 	int taille_image = nb_colonnes * nb_lignes;
 
@@ -500,6 +517,7 @@ void image_pgm::ecrire_image_pgm_variable_size(char nom_image[], uint64_t *pt_im
 
 void image_pgm::lire_image_pgm_variable_size(char nom_image[], uint64_t *pt_image, int taille_image)
 {
+	PROFILE_STAGE(READ);
 	FILE *f_image;
 	int nb_colonnes, nb_lignes;
 	uint64_t max_grey_val;
@@ -0,0 +1,224 @@
+/******************************************************************************
+ * ICAR_Interns_Library
+ *
+ * File : UnixSocket.cpp
+ *
+ * Description : Implementation of the local stream socket between the
+ * encryption daemon and its clients.
+ *
+ *
+ * Author : Katia Auxilien
+ *
+ * Mail : katia.auxilien@mail.fr
+ *
+ * Date : 17 Octobre 2026
+ *
+ *******************************************************************************/
+#include "../../../include/model/network/UnixSocket.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+UnixSocket::UnixSocket() : fd(-1) {}
+
+UnixSocket::UnixSocket(int fd) : fd(fd) {}
+
+UnixSocket::~UnixSocket()
+{
+	close();
+}
+
+UnixSocket::UnixSocket(UnixSocket &&other) : fd(other.fd), buffer(std::move(other.buffer))
+{
+	other.fd = -1;
+}
+
+UnixSocket &UnixSocket::operator=(UnixSocket &&other)
+{
+	if (this != &other)
+	{
+		close();
+		fd = other.fd;
+		buffer = std::move(other.buffer);
+		other.fd = -1;
+	}
+	return *this;
+}
+
+void UnixSocket::close()
+{
+	if (fd >= 0)
+	{
+		::close(fd);
+		fd = -1;
+	}
+	buffer.clear();
+}
+
+void UnixSocket::shutdown()
+{
+	if (fd >= 0)
+	{
+		::shutdown(fd, SHUT_RDWR);
+	}
+}
+
+/**
+ * \brief Fill the address of a socket path.
+ * \return bool - False if the path does not fit in sun_path.
+ */
+static bool makeAddress(const char *path, struct sockaddr_un &address)
+{
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if (strlen(path) >= sizeof(address.sun_path))
+	{
+		return false;
+	}
+	strcpy(address.sun_path, path);
+	return true;
+}
+
+bool UnixSocket::listen(const char *path)
+{
+	close();
+	struct sockaddr_un address;
+	if (!makeAddress(path, address))
+	{
+		return false;
+	}
+	fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0)
+	{
+		return false;
+	}
+	unlink(path);
+	if (bind(fd, (struct sockaddr *)&address, sizeof(address)) != 0 || ::listen(fd, SOMAXCONN) != 0)
+	{
+		close();
+		return false;
+	}
+	return true;
+}
+
+bool UnixSocket::connect(const char *path)
+{
+	close();
+	struct sockaddr_un address;
+	if (!makeAddress(path, address))
+	{
+		return false;
+	}
+	fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0)
+	{
+		return false;
+	}
+	if (::connect(fd, (struct sockaddr *)&address, sizeof(address)) != 0)
+	{
+		close();
+		return false;
+	}
+	return true;
+}
+
+UnixSocket UnixSocket::accept()
+{
+	while (true)
+	{
+		int client = ::accept(fd, NULL, NULL);
+		if (client >= 0 || errno != EINTR)
+		{
+			return UnixSocket(client);
+		}
+	}
+}
+
+bool UnixSocket::fill()
+{
+	char chunk[65536];
+	while (true)
+	{
+		ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+		if (received > 0)
+		{
+			buffer.append(chunk, received);
+			return true;
+		}
+		if (received == 0 || errno != EINTR)
+		{
+			return false;
+		}
+	}
+}
+
+bool UnixSocket::readLine(std::string &line, size_t maxLength)
+{
+	size_t searched = 0;
+	size_t end;
+	while ((end = buffer.find('\n', searched)) == std::string::npos)
+	{
+		searched = buffer.size();
+		if (searched > maxLength || !fill())
+		{
+			return false;
+		}
+	}
+	if (end > maxLength)
+	{
+		return false;
+	}
+	line.assign(buffer, 0, end);
+	buffer.erase(0, end + 1);
+	return true;
+}
+
+bool UnixSocket::readExact(void *data, size_t size)
+{
+	char *out = static_cast<char *>(data);
+	size_t copied = std::min(size, buffer.size());
+	memcpy(out, buffer.data(), copied);
+	buffer.erase(0, copied);
+	while (copied < size)
+	{
+		ssize_t received = recv(fd, out + copied, size - copied, 0);
+		if (received > 0)
+		{
+			copied += received;
+		}
+		else if (received == 0 || errno != EINTR)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool UnixSocket::writeAll(const void *data, size_t size)
+{
+	const char *in = static_cast<const char *>(data);
+	while (size > 0)
+	{
+		ssize_t sent = send(fd, in, size, MSG_NOSIGNAL);
+		if (sent > 0)
+		{
+			in += sent;
+			size -= sent;
+		}
+		else if (sent < 0 && errno != EINTR)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool UnixSocket::writeLine(const std::string &line)
+{
+	std::string data = line + '\n';
+	return writeAll(data.data(), data.size());
+}